@@ -0,0 +1,18 @@
+/* Automatically generated nanopb constant definitions */
+/* Generated by nanopb-0.4.7 */
+
+#include "Login.pb.h"
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+PB_BIND(LoggedInId, LoggedInId, AUTO)
+
+
+PB_BIND(ClientId, ClientId, AUTO)
+
+
+PB_BIND(LoginInfo, LoginInfo, AUTO)
+
+
+
@@ -0,0 +1,94 @@
+/* Automatically generated nanopb header */
+/* Generated by nanopb-0.4.7 */
+
+#ifndef PB_LOGIN_PB_H_INCLUDED
+#define PB_LOGIN_PB_H_INCLUDED
+#include <pb.h>
+
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+/* Struct definitions */
+typedef struct _LoggedInId {
+    uint32_t device;
+    uint32_t licence;
+} LoggedInId;
+
+typedef struct _ClientId {
+    pb_size_t which_inner;
+    union {
+        LoggedInId logged_in;
+        uint32_t guest;
+    } inner;
+} ClientId;
+
+typedef struct _LoginInfo {
+    ClientId client_id;
+    uint32_t room_id;
+    uint32_t token;
+} LoginInfo;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Initializer values for message structs */
+#define LoggedInId_init_default                  {0, 0}
+#define ClientId_init_default                    {0, {LoggedInId_init_default}}
+#define LoginInfo_init_default                   {ClientId_init_default, 0, 0}
+#define LoggedInId_init_zero                     {0, 0}
+#define ClientId_init_zero                       {0, {LoggedInId_init_zero}}
+#define LoginInfo_init_zero                      {ClientId_init_zero, 0, 0}
+
+/* Field tags (for use in manual encoding/decoding) */
+#define LoggedInId_device_tag                    1
+#define LoggedInId_licence_tag                   2
+#define ClientId_logged_in_tag                   1
+#define ClientId_guest_tag                       2
+#define LoginInfo_client_id_tag                  1
+#define LoginInfo_room_id_tag                    2
+#define LoginInfo_token_tag                      3
+
+/* Struct field encoding specification for nanopb */
+#define LoggedInId_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   device,            1) \
+X(a, STATIC,   REQUIRED, UINT32,   licence,           2)
+#define LoggedInId_CALLBACK NULL
+#define LoggedInId_DEFAULT NULL
+
+#define ClientId_FIELDLIST(X, a) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (inner,logged_in,inner.logged_in),   1) \
+X(a, STATIC,   ONEOF,    UINT32,   (inner,guest,inner.guest),   2)
+#define ClientId_CALLBACK NULL
+#define ClientId_DEFAULT NULL
+#define ClientId_inner_logged_in_MSGTYPE LoggedInId
+
+#define LoginInfo_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, MESSAGE,  client_id,         1) \
+X(a, STATIC,   REQUIRED, UINT32,   room_id,           2) \
+X(a, STATIC,   REQUIRED, UINT32,   token,             3)
+#define LoginInfo_CALLBACK NULL
+#define LoginInfo_DEFAULT NULL
+#define LoginInfo_client_id_MSGTYPE ClientId
+
+extern const pb_msgdesc_t LoggedInId_msg;
+extern const pb_msgdesc_t ClientId_msg;
+extern const pb_msgdesc_t LoginInfo_msg;
+
+/* Defines for backwards compatibility with code written before nanopb-0.4.0 */
+#define LoggedInId_fields &LoggedInId_msg
+#define ClientId_fields &ClientId_msg
+#define LoginInfo_fields &LoginInfo_msg
+
+/* Maximum encoded size of messages (where known) */
+#define ClientId_size                            14
+#define LoggedInId_size                          12
+#define LoginInfo_size                           28
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,66 @@
+/* Automatically generated nanopb constant definitions */
+/* Generated by nanopb-0.4.7 */
+
+#include "Matchmaking.pb.h"
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+PB_BIND(GTSMessage, GTSMessage, AUTO)
+
+
+PB_BIND(GTSMessage_AddServer, GTSMessage_AddServer, AUTO)
+
+
+PB_BIND(GTSMessage_ClientUpdate, GTSMessage_ClientUpdate, AUTO)
+
+
+PB_BIND(GTSMessage_RaceFinish, GTSMessage_RaceFinish, AUTO)
+
+
+PB_BIND(GTSMessage_RaceFinish_RaceClient, GTSMessage_RaceFinish_RaceClient, AUTO)
+
+
+PB_BIND(GTSMessage_TokenResponse, GTSMessage_TokenResponse, AUTO)
+
+
+PB_BIND(STGMessage, STGMessage, AUTO)
+
+
+PB_BIND(STGMessage_RequestToken, STGMessage_RequestToken, AUTO)
+
+
+PB_BIND(CTSMessage, CTSMessage, 2)
+
+
+PB_BIND(CTSMessage_Login, CTSMessage_Login, AUTO)
+
+
+PB_BIND(CTSMessage_LoginChallengeAnswer, CTSMessage_LoginChallengeAnswer, 2)
+
+
+PB_BIND(CTSMessage_StartMatchmaking, CTSMessage_StartMatchmaking, AUTO)
+
+
+PB_BIND(CTSMessage_CancelMatchmaking, CTSMessage_CancelMatchmaking, AUTO)
+
+
+PB_BIND(STCMessage, STCMessage, AUTO)
+
+
+PB_BIND(STCMessage_LoginGuest, STCMessage_LoginGuest, AUTO)
+
+
+PB_BIND(STCMessage_LoginChallenge, STCMessage_LoginChallenge, AUTO)
+
+
+PB_BIND(STCMessage_LoginResponse, STCMessage_LoginResponse, AUTO)
+
+
+PB_BIND(STCMessage_LoginResponse_Friend, STCMessage_LoginResponse_Friend, AUTO)
+
+
+PB_BIND(STCMessage_FoundMatch, STCMessage_FoundMatch, AUTO)
+
+
+
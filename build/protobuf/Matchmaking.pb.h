@@ -0,0 +1,441 @@
+/* Automatically generated nanopb header */
+/* Generated by nanopb-0.4.7 */
+
+#ifndef PB_MATCHMAKING_PB_H_INCLUDED
+#define PB_MATCHMAKING_PB_H_INCLUDED
+#include <pb.h>
+#include "Login.pb.h"
+
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+/* Struct definitions */
+typedef struct _GTSMessage_AddServer {
+    uint32_t gameserver_id;
+    uint32_t max_rooms;
+} GTSMessage_AddServer;
+
+typedef struct _GTSMessage_ClientUpdate {
+    uint32_t room_id;
+    ClientId client_id;
+    bool is_join;
+    bool is_host;
+} GTSMessage_ClientUpdate;
+
+typedef struct _GTSMessage_RaceFinish {
+    pb_callback_t clients;
+} GTSMessage_RaceFinish;
+
+typedef struct _GTSMessage_RaceFinish_RaceClient {
+    ClientId client_id;
+    int32_t raceRating;
+} GTSMessage_RaceFinish_RaceClient;
+
+typedef struct _GTSMessage_TokenResponse {
+    LoginInfo login_info;
+    uint32_t room_ip;
+} GTSMessage_TokenResponse;
+
+typedef struct _GTSMessage {
+    pb_size_t which_message;
+    union {
+        GTSMessage_AddServer add_server;
+        GTSMessage_TokenResponse token_response;
+        GTSMessage_ClientUpdate client_update;
+        GTSMessage_RaceFinish finish;
+    } message;
+} GTSMessage;
+
+typedef struct _STGMessage_RequestToken {
+    ClientId client_id;
+    bool has_room_id;
+    uint32_t room_id;
+} STGMessage_RequestToken;
+
+typedef struct _STGMessage {
+    pb_size_t which_message;
+    union {
+        STGMessage_RequestToken token_request;
+    } message;
+} STGMessage;
+
+typedef struct _CTSMessage_Login {
+    bool has_client_id;
+    LoggedInId client_id;
+} CTSMessage_Login;
+
+typedef PB_BYTES_ARRAY_T(512) CTSMessage_LoginChallengeAnswer_challenge_signed_t;
+typedef PB_BYTES_ARRAY_T(76) CTSMessage_LoginChallengeAnswer_mii_t;
+typedef struct _CTSMessage_LoginChallengeAnswer {
+    CTSMessage_LoginChallengeAnswer_challenge_signed_t challenge_signed;
+    CTSMessage_LoginChallengeAnswer_mii_t mii;
+    int32_t location;
+    int32_t latitude;
+    int32_t longitude;
+} CTSMessage_LoginChallengeAnswer;
+
+typedef struct _CTSMessage_StartMatchmaking {
+    uint32_t trackpack;
+    uint32_t gamemode;
+} CTSMessage_StartMatchmaking;
+
+typedef struct _CTSMessage_CancelMatchmaking {
+    char dummy_field;
+} CTSMessage_CancelMatchmaking;
+
+typedef struct _CTSMessage {
+    pb_size_t which_message;
+    union {
+        CTSMessage_Login login;
+        CTSMessage_LoginChallengeAnswer login_challenge_answer;
+        CTSMessage_StartMatchmaking start_matchmaking;
+        CTSMessage_CancelMatchmaking cancel_matchmaking;
+    } message;
+} CTSMessage;
+
+typedef struct _STCMessage_LoginGuest {
+    char dummy_field;
+} STCMessage_LoginGuest;
+
+typedef struct _STCMessage_LoginChallenge {
+    pb_callback_t challenge;
+} STCMessage_LoginChallenge;
+
+typedef struct _STCMessage_LoginResponse {
+    int32_t vs_rating;
+    int32_t bt_rating;
+    pb_callback_t friends;
+} STCMessage_LoginResponse;
+
+typedef struct _STCMessage_LoginResponse_Friend {
+    LoggedInId client_id;
+    int32_t friend_suffix;
+    int32_t location;
+    int32_t latitude;
+    int32_t longitude;
+    pb_callback_t mii;
+} STCMessage_LoginResponse_Friend;
+
+typedef struct _STCMessage_FoundMatch {
+    LoginInfo login_info;
+    uint32_t room_ip;
+} STCMessage_FoundMatch;
+
+typedef struct _STCMessage {
+    pb_size_t which_message;
+    union {
+        STCMessage_LoginChallenge challenge;
+        STCMessage_LoginResponse response;
+        STCMessage_LoginGuest guest_response;
+        STCMessage_FoundMatch found_match;
+    } message;
+} STCMessage;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Initializer values for message structs */
+#define GTSMessage_init_default                  {0, {GTSMessage_AddServer_init_default}}
+#define GTSMessage_AddServer_init_default        {0, 0}
+#define GTSMessage_ClientUpdate_init_default     {0, ClientId_init_default, 0, 0}
+#define GTSMessage_RaceFinish_init_default       {{{NULL}, NULL}}
+#define GTSMessage_RaceFinish_RaceClient_init_default {ClientId_init_default, 0}
+#define GTSMessage_TokenResponse_init_default    {LoginInfo_init_default, 0}
+#define STGMessage_init_default                  {0, {STGMessage_RequestToken_init_default}}
+#define STGMessage_RequestToken_init_default     {ClientId_init_default, false, 0}
+#define CTSMessage_init_default                  {0, {CTSMessage_Login_init_default}}
+#define CTSMessage_Login_init_default            {false, LoggedInId_init_default}
+#define CTSMessage_LoginChallengeAnswer_init_default {{0, {0}}, {0, {0}}, 0, 0, 0}
+#define CTSMessage_StartMatchmaking_init_default {0, 0}
+#define CTSMessage_CancelMatchmaking_init_default {0}
+#define STCMessage_init_default                  {0, {STCMessage_LoginChallenge_init_default}}
+#define STCMessage_LoginGuest_init_default       {0}
+#define STCMessage_LoginChallenge_init_default   {{{NULL}, NULL}}
+#define STCMessage_LoginResponse_init_default    {0, 0, {{NULL}, NULL}}
+#define STCMessage_LoginResponse_Friend_init_default {LoggedInId_init_default, 0, 0, 0, 0, {{NULL}, NULL}}
+#define STCMessage_FoundMatch_init_default       {LoginInfo_init_default, 0}
+#define GTSMessage_init_zero                     {0, {GTSMessage_AddServer_init_zero}}
+#define GTSMessage_AddServer_init_zero           {0, 0}
+#define GTSMessage_ClientUpdate_init_zero        {0, ClientId_init_zero, 0, 0}
+#define GTSMessage_RaceFinish_init_zero          {{{NULL}, NULL}}
+#define GTSMessage_RaceFinish_RaceClient_init_zero {ClientId_init_zero, 0}
+#define GTSMessage_TokenResponse_init_zero       {LoginInfo_init_zero, 0}
+#define STGMessage_init_zero                     {0, {STGMessage_RequestToken_init_zero}}
+#define STGMessage_RequestToken_init_zero        {ClientId_init_zero, false, 0}
+#define CTSMessage_init_zero                     {0, {CTSMessage_Login_init_zero}}
+#define CTSMessage_Login_init_zero               {false, LoggedInId_init_zero}
+#define CTSMessage_LoginChallengeAnswer_init_zero {{0, {0}}, {0, {0}}, 0, 0, 0}
+#define CTSMessage_StartMatchmaking_init_zero    {0, 0}
+#define CTSMessage_CancelMatchmaking_init_zero   {0}
+#define STCMessage_init_zero                     {0, {STCMessage_LoginChallenge_init_zero}}
+#define STCMessage_LoginGuest_init_zero          {0}
+#define STCMessage_LoginChallenge_init_zero      {{{NULL}, NULL}}
+#define STCMessage_LoginResponse_init_zero       {0, 0, {{NULL}, NULL}}
+#define STCMessage_LoginResponse_Friend_init_zero {LoggedInId_init_zero, 0, 0, 0, 0, {{NULL}, NULL}}
+#define STCMessage_FoundMatch_init_zero          {LoginInfo_init_zero, 0}
+
+/* Field tags (for use in manual encoding/decoding) */
+#define GTSMessage_AddServer_gameserver_id_tag   1
+#define GTSMessage_AddServer_max_rooms_tag       2
+#define GTSMessage_ClientUpdate_room_id_tag      1
+#define GTSMessage_ClientUpdate_client_id_tag    2
+#define GTSMessage_ClientUpdate_is_join_tag      3
+#define GTSMessage_ClientUpdate_is_host_tag      4
+#define GTSMessage_RaceFinish_clients_tag        1
+#define GTSMessage_RaceFinish_RaceClient_client_id_tag 1
+#define GTSMessage_RaceFinish_RaceClient_raceRating_tag 2
+#define GTSMessage_TokenResponse_login_info_tag  1
+#define GTSMessage_TokenResponse_room_ip_tag     2
+#define GTSMessage_add_server_tag                1
+#define GTSMessage_token_response_tag            2
+#define GTSMessage_client_update_tag             3
+#define GTSMessage_finish_tag                    4
+#define STGMessage_RequestToken_client_id_tag    1
+#define STGMessage_RequestToken_room_id_tag      2
+#define STGMessage_token_request_tag             1
+#define CTSMessage_Login_client_id_tag           1
+#define CTSMessage_LoginChallengeAnswer_challenge_signed_tag 1
+#define CTSMessage_LoginChallengeAnswer_mii_tag  2
+#define CTSMessage_LoginChallengeAnswer_location_tag 3
+#define CTSMessage_LoginChallengeAnswer_latitude_tag 4
+#define CTSMessage_LoginChallengeAnswer_longitude_tag 5
+#define CTSMessage_StartMatchmaking_trackpack_tag 1
+#define CTSMessage_StartMatchmaking_gamemode_tag 2
+#define CTSMessage_login_tag                     1
+#define CTSMessage_login_challenge_answer_tag    2
+#define CTSMessage_start_matchmaking_tag         3
+#define CTSMessage_cancel_matchmaking_tag        4
+#define STCMessage_LoginChallenge_challenge_tag  1
+#define STCMessage_LoginResponse_vs_rating_tag   1
+#define STCMessage_LoginResponse_bt_rating_tag   2
+#define STCMessage_LoginResponse_friends_tag     3
+#define STCMessage_LoginResponse_Friend_client_id_tag 1
+#define STCMessage_LoginResponse_Friend_friend_suffix_tag 2
+#define STCMessage_LoginResponse_Friend_location_tag 3
+#define STCMessage_LoginResponse_Friend_latitude_tag 4
+#define STCMessage_LoginResponse_Friend_longitude_tag 5
+#define STCMessage_LoginResponse_Friend_mii_tag  6
+#define STCMessage_FoundMatch_login_info_tag     1
+#define STCMessage_FoundMatch_room_ip_tag        2
+#define STCMessage_challenge_tag                 1
+#define STCMessage_response_tag                  2
+#define STCMessage_guest_response_tag            3
+#define STCMessage_found_match_tag               4
+
+/* Struct field encoding specification for nanopb */
+#define GTSMessage_FIELDLIST(X, a) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,add_server,message.add_server),   1) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,token_response,message.token_response),   2) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,client_update,message.client_update),   3) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,finish,message.finish),   4)
+#define GTSMessage_CALLBACK NULL
+#define GTSMessage_DEFAULT NULL
+#define GTSMessage_message_add_server_MSGTYPE GTSMessage_AddServer
+#define GTSMessage_message_token_response_MSGTYPE GTSMessage_TokenResponse
+#define GTSMessage_message_client_update_MSGTYPE GTSMessage_ClientUpdate
+#define GTSMessage_message_finish_MSGTYPE GTSMessage_RaceFinish
+
+#define GTSMessage_AddServer_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   gameserver_id,     1) \
+X(a, STATIC,   REQUIRED, UINT32,   max_rooms,         2)
+#define GTSMessage_AddServer_CALLBACK NULL
+#define GTSMessage_AddServer_DEFAULT NULL
+
+#define GTSMessage_ClientUpdate_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   room_id,           1) \
+X(a, STATIC,   REQUIRED, MESSAGE,  client_id,         2) \
+X(a, STATIC,   REQUIRED, BOOL,     is_join,           3) \
+X(a, STATIC,   REQUIRED, BOOL,     is_host,           4)
+#define GTSMessage_ClientUpdate_CALLBACK NULL
+#define GTSMessage_ClientUpdate_DEFAULT NULL
+#define GTSMessage_ClientUpdate_client_id_MSGTYPE ClientId
+
+#define GTSMessage_RaceFinish_FIELDLIST(X, a) \
+X(a, CALLBACK, REPEATED, MESSAGE,  clients,           1)
+#define GTSMessage_RaceFinish_CALLBACK pb_default_field_callback
+#define GTSMessage_RaceFinish_DEFAULT NULL
+#define GTSMessage_RaceFinish_clients_MSGTYPE GTSMessage_RaceFinish_RaceClient
+
+#define GTSMessage_RaceFinish_RaceClient_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, MESSAGE,  client_id,         1) \
+X(a, STATIC,   REQUIRED, INT32,    raceRating,        2)
+#define GTSMessage_RaceFinish_RaceClient_CALLBACK NULL
+#define GTSMessage_RaceFinish_RaceClient_DEFAULT NULL
+#define GTSMessage_RaceFinish_RaceClient_client_id_MSGTYPE ClientId
+
+#define GTSMessage_TokenResponse_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, MESSAGE,  login_info,        1) \
+X(a, STATIC,   REQUIRED, UINT32,   room_ip,           2)
+#define GTSMessage_TokenResponse_CALLBACK NULL
+#define GTSMessage_TokenResponse_DEFAULT NULL
+#define GTSMessage_TokenResponse_login_info_MSGTYPE LoginInfo
+
+#define STGMessage_FIELDLIST(X, a) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,token_request,message.token_request),   1)
+#define STGMessage_CALLBACK NULL
+#define STGMessage_DEFAULT NULL
+#define STGMessage_message_token_request_MSGTYPE STGMessage_RequestToken
+
+#define STGMessage_RequestToken_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, MESSAGE,  client_id,         1) \
+X(a, STATIC,   OPTIONAL, UINT32,   room_id,           2)
+#define STGMessage_RequestToken_CALLBACK NULL
+#define STGMessage_RequestToken_DEFAULT NULL
+#define STGMessage_RequestToken_client_id_MSGTYPE ClientId
+
+#define CTSMessage_FIELDLIST(X, a) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,login,message.login),   1) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,login_challenge_answer,message.login_challenge_answer),   2) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,start_matchmaking,message.start_matchmaking),   3) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,cancel_matchmaking,message.cancel_matchmaking),   4)
+#define CTSMessage_CALLBACK NULL
+#define CTSMessage_DEFAULT NULL
+#define CTSMessage_message_login_MSGTYPE CTSMessage_Login
+#define CTSMessage_message_login_challenge_answer_MSGTYPE CTSMessage_LoginChallengeAnswer
+#define CTSMessage_message_start_matchmaking_MSGTYPE CTSMessage_StartMatchmaking
+#define CTSMessage_message_cancel_matchmaking_MSGTYPE CTSMessage_CancelMatchmaking
+
+#define CTSMessage_Login_FIELDLIST(X, a) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  client_id,         1)
+#define CTSMessage_Login_CALLBACK NULL
+#define CTSMessage_Login_DEFAULT NULL
+#define CTSMessage_Login_client_id_MSGTYPE LoggedInId
+
+#define CTSMessage_LoginChallengeAnswer_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, BYTES,    challenge_signed,   1) \
+X(a, STATIC,   REQUIRED, BYTES,    mii,               2) \
+X(a, STATIC,   REQUIRED, INT32,    location,          3) \
+X(a, STATIC,   REQUIRED, INT32,    latitude,          4) \
+X(a, STATIC,   REQUIRED, INT32,    longitude,         5)
+#define CTSMessage_LoginChallengeAnswer_CALLBACK NULL
+#define CTSMessage_LoginChallengeAnswer_DEFAULT NULL
+
+#define CTSMessage_StartMatchmaking_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   trackpack,         1) \
+X(a, STATIC,   REQUIRED, UINT32,   gamemode,          2)
+#define CTSMessage_StartMatchmaking_CALLBACK NULL
+#define CTSMessage_StartMatchmaking_DEFAULT NULL
+
+#define CTSMessage_CancelMatchmaking_FIELDLIST(X, a) \
+
+#define CTSMessage_CancelMatchmaking_CALLBACK NULL
+#define CTSMessage_CancelMatchmaking_DEFAULT NULL
+
+#define STCMessage_FIELDLIST(X, a) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,challenge,message.challenge),   1) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,response,message.response),   2) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,guest_response,message.guest_response),   3) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,found_match,message.found_match),   4)
+#define STCMessage_CALLBACK NULL
+#define STCMessage_DEFAULT NULL
+#define STCMessage_message_challenge_MSGTYPE STCMessage_LoginChallenge
+#define STCMessage_message_response_MSGTYPE STCMessage_LoginResponse
+#define STCMessage_message_guest_response_MSGTYPE STCMessage_LoginGuest
+#define STCMessage_message_found_match_MSGTYPE STCMessage_FoundMatch
+
+#define STCMessage_LoginGuest_FIELDLIST(X, a) \
+
+#define STCMessage_LoginGuest_CALLBACK NULL
+#define STCMessage_LoginGuest_DEFAULT NULL
+
+#define STCMessage_LoginChallenge_FIELDLIST(X, a) \
+X(a, CALLBACK, REQUIRED, BYTES,    challenge,         1)
+#define STCMessage_LoginChallenge_CALLBACK pb_default_field_callback
+#define STCMessage_LoginChallenge_DEFAULT NULL
+
+#define STCMessage_LoginResponse_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, INT32,    vs_rating,         1) \
+X(a, STATIC,   REQUIRED, INT32,    bt_rating,         2) \
+X(a, CALLBACK, REPEATED, MESSAGE,  friends,           3)
+#define STCMessage_LoginResponse_CALLBACK pb_default_field_callback
+#define STCMessage_LoginResponse_DEFAULT NULL
+#define STCMessage_LoginResponse_friends_MSGTYPE STCMessage_LoginResponse_Friend
+
+#define STCMessage_LoginResponse_Friend_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, MESSAGE,  client_id,         1) \
+X(a, STATIC,   REQUIRED, INT32,    friend_suffix,     2) \
+X(a, STATIC,   REQUIRED, INT32,    location,          3) \
+X(a, STATIC,   REQUIRED, INT32,    latitude,          4) \
+X(a, STATIC,   REQUIRED, INT32,    longitude,         5) \
+X(a, CALLBACK, REQUIRED, BYTES,    mii,               6)
+#define STCMessage_LoginResponse_Friend_CALLBACK pb_default_field_callback
+#define STCMessage_LoginResponse_Friend_DEFAULT NULL
+#define STCMessage_LoginResponse_Friend_client_id_MSGTYPE LoggedInId
+
+#define STCMessage_FoundMatch_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, MESSAGE,  login_info,        1) \
+X(a, STATIC,   REQUIRED, UINT32,   room_ip,           2)
+#define STCMessage_FoundMatch_CALLBACK NULL
+#define STCMessage_FoundMatch_DEFAULT NULL
+#define STCMessage_FoundMatch_login_info_MSGTYPE LoginInfo
+
+extern const pb_msgdesc_t GTSMessage_msg;
+extern const pb_msgdesc_t GTSMessage_AddServer_msg;
+extern const pb_msgdesc_t GTSMessage_ClientUpdate_msg;
+extern const pb_msgdesc_t GTSMessage_RaceFinish_msg;
+extern const pb_msgdesc_t GTSMessage_RaceFinish_RaceClient_msg;
+extern const pb_msgdesc_t GTSMessage_TokenResponse_msg;
+extern const pb_msgdesc_t STGMessage_msg;
+extern const pb_msgdesc_t STGMessage_RequestToken_msg;
+extern const pb_msgdesc_t CTSMessage_msg;
+extern const pb_msgdesc_t CTSMessage_Login_msg;
+extern const pb_msgdesc_t CTSMessage_LoginChallengeAnswer_msg;
+extern const pb_msgdesc_t CTSMessage_StartMatchmaking_msg;
+extern const pb_msgdesc_t CTSMessage_CancelMatchmaking_msg;
+extern const pb_msgdesc_t STCMessage_msg;
+extern const pb_msgdesc_t STCMessage_LoginGuest_msg;
+extern const pb_msgdesc_t STCMessage_LoginChallenge_msg;
+extern const pb_msgdesc_t STCMessage_LoginResponse_msg;
+extern const pb_msgdesc_t STCMessage_LoginResponse_Friend_msg;
+extern const pb_msgdesc_t STCMessage_FoundMatch_msg;
+
+/* Defines for backwards compatibility with code written before nanopb-0.4.0 */
+#define GTSMessage_fields &GTSMessage_msg
+#define GTSMessage_AddServer_fields &GTSMessage_AddServer_msg
+#define GTSMessage_ClientUpdate_fields &GTSMessage_ClientUpdate_msg
+#define GTSMessage_RaceFinish_fields &GTSMessage_RaceFinish_msg
+#define GTSMessage_RaceFinish_RaceClient_fields &GTSMessage_RaceFinish_RaceClient_msg
+#define GTSMessage_TokenResponse_fields &GTSMessage_TokenResponse_msg
+#define STGMessage_fields &STGMessage_msg
+#define STGMessage_RequestToken_fields &STGMessage_RequestToken_msg
+#define CTSMessage_fields &CTSMessage_msg
+#define CTSMessage_Login_fields &CTSMessage_Login_msg
+#define CTSMessage_LoginChallengeAnswer_fields &CTSMessage_LoginChallengeAnswer_msg
+#define CTSMessage_StartMatchmaking_fields &CTSMessage_StartMatchmaking_msg
+#define CTSMessage_CancelMatchmaking_fields &CTSMessage_CancelMatchmaking_msg
+#define STCMessage_fields &STCMessage_msg
+#define STCMessage_LoginGuest_fields &STCMessage_LoginGuest_msg
+#define STCMessage_LoginChallenge_fields &STCMessage_LoginChallenge_msg
+#define STCMessage_LoginResponse_fields &STCMessage_LoginResponse_msg
+#define STCMessage_LoginResponse_Friend_fields &STCMessage_LoginResponse_Friend_msg
+#define STCMessage_FoundMatch_fields &STCMessage_FoundMatch_msg
+
+/* Maximum encoded size of messages (where known) */
+/* GTSMessage_size depends on runtime parameters */
+/* GTSMessage_RaceFinish_size depends on runtime parameters */
+/* STCMessage_size depends on runtime parameters */
+/* STCMessage_LoginChallenge_size depends on runtime parameters */
+/* STCMessage_LoginResponse_size depends on runtime parameters */
+/* STCMessage_LoginResponse_Friend_size depends on runtime parameters */
+#define CTSMessage_CancelMatchmaking_size        0
+#define CTSMessage_LoginChallengeAnswer_size     626
+#define CTSMessage_Login_size                    14
+#define CTSMessage_StartMatchmaking_size         12
+#define CTSMessage_size                          629
+#define GTSMessage_AddServer_size                12
+#define GTSMessage_ClientUpdate_size             26
+#define GTSMessage_RaceFinish_RaceClient_size    27
+#define GTSMessage_TokenResponse_size            36
+#define STCMessage_FoundMatch_size               36
+#define STCMessage_LoginGuest_size               0
+#define STGMessage_RequestToken_size             22
+#define STGMessage_size                          24
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,79 @@
+/* Automatically generated nanopb constant definitions */
+/* Generated by nanopb-0.4.7 */
+
+#include "NetStorage.pb.h"
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+PB_BIND(NetStorageRequest, NetStorageRequest, 2)
+
+
+PB_BIND(NetStorageRequest_FastOpen, NetStorageRequest_FastOpen, AUTO)
+
+
+PB_BIND(NetStorageRequest_Open, NetStorageRequest_Open, AUTO)
+
+
+PB_BIND(NetStorageRequest_Clone, NetStorageRequest_Clone, AUTO)
+
+
+PB_BIND(NetStorageRequest_Close, NetStorageRequest_Close, AUTO)
+
+
+PB_BIND(NetStorageRequest_Read, NetStorageRequest_Read, AUTO)
+
+
+PB_BIND(NetStorageRequest_Write, NetStorageRequest_Write, AUTO)
+
+
+PB_BIND(NetStorageRequest_FastOpenDir, NetStorageRequest_FastOpenDir, AUTO)
+
+
+PB_BIND(NetStorageRequest_OpenDir, NetStorageRequest_OpenDir, AUTO)
+
+
+PB_BIND(NetStorageRequest_CloneDir, NetStorageRequest_CloneDir, AUTO)
+
+
+PB_BIND(NetStorageRequest_CloseDir, NetStorageRequest_CloseDir, AUTO)
+
+
+PB_BIND(NetStorageRequest_ReadDir, NetStorageRequest_ReadDir, AUTO)
+
+
+PB_BIND(NetStorageRequest_ReadDirBatch, NetStorageRequest_ReadDirBatch, AUTO)
+
+
+PB_BIND(NetStorageRequest_Stat, NetStorageRequest_Stat, AUTO)
+
+
+PB_BIND(NetStorageRequest_StartBenchmark, NetStorageRequest_StartBenchmark, AUTO)
+
+
+PB_BIND(NetStorageRequest_ReadRanges, NetStorageRequest_ReadRanges, 2)
+
+
+PB_BIND(NetStorageRequest_ReadRanges_Range, NetStorageRequest_ReadRanges_Range, AUTO)
+
+
+PB_BIND(NetStorageResponse, NetStorageResponse, AUTO)
+
+
+PB_BIND(NetStorageResponse_Open, NetStorageResponse_Open, AUTO)
+
+
+PB_BIND(NetStorageResponse_OpenDir, NetStorageResponse_OpenDir, AUTO)
+
+
+PB_BIND(NetStorageResponse_NodeInfo, NetStorageResponse_NodeInfo, AUTO)
+
+
+PB_BIND(NetStorageResponse_Ok, NetStorageResponse_Ok, AUTO)
+
+
+PB_BIND(NetStorageResponse_Error, NetStorageResponse_Error, AUTO)
+
+
+
+
@@ -0,0 +1,546 @@
+/* Automatically generated nanopb header */
+/* Generated by nanopb-0.4.7 */
+
+#ifndef PB_NETSTORAGE_PB_H_INCLUDED
+#define PB_NETSTORAGE_PB_H_INCLUDED
+#include <pb.h>
+
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+/* Enum definitions */
+typedef enum _NetStorageResponse_NodeInfo_Type {
+    NetStorageResponse_NodeInfo_Type_File = 0,
+    NetStorageResponse_NodeInfo_Type_Dir = 1
+} NetStorageResponse_NodeInfo_Type;
+
+/* Struct definitions */
+typedef struct _NetStorageRequest_FastOpen {
+    uint32_t id;
+} NetStorageRequest_FastOpen;
+
+typedef struct _NetStorageRequest_Open {
+    char path[128];
+    char mode[4];
+} NetStorageRequest_Open;
+
+typedef struct _NetStorageRequest_Clone {
+    uint32_t handle;
+} NetStorageRequest_Clone;
+
+typedef struct _NetStorageRequest_Close {
+    uint32_t handle;
+} NetStorageRequest_Close;
+
+typedef struct _NetStorageRequest_Read {
+    uint32_t handle;
+    uint32_t size;
+    uint64_t offset;
+    bool has_chunkSize;
+    uint32_t chunkSize; /* 4 KiB if unset, capped by the server */
+} NetStorageRequest_Read;
+
+typedef struct _NetStorageRequest_Write {
+    uint32_t handle;
+    uint32_t size;
+    uint64_t offset;
+} NetStorageRequest_Write;
+
+typedef struct _NetStorageRequest_FastOpenDir {
+    uint32_t id;
+} NetStorageRequest_FastOpenDir;
+
+typedef struct _NetStorageRequest_OpenDir {
+    char path[128];
+} NetStorageRequest_OpenDir;
+
+typedef struct _NetStorageRequest_CloneDir {
+    uint32_t handle;
+} NetStorageRequest_CloneDir;
+
+typedef struct _NetStorageRequest_CloseDir {
+    uint32_t handle;
+} NetStorageRequest_CloseDir;
+
+typedef struct _NetStorageRequest_ReadDir {
+    uint32_t handle;
+} NetStorageRequest_ReadDir;
+
+/* Answered with up to count NodeInfo responses followed by Ok. */
+typedef struct _NetStorageRequest_ReadDirBatch {
+    uint32_t handle;
+    uint32_t count;
+} NetStorageRequest_ReadDirBatch;
+
+typedef struct _NetStorageRequest_Stat {
+    char path[128];
+} NetStorageRequest_Stat;
+
+typedef struct _NetStorageRequest_StartBenchmark {
+    char dummy_field;
+} NetStorageRequest_StartBenchmark;
+
+typedef struct _NetStorageRequest_ReadRanges_Range {
+    uint32_t size;
+    uint64_t offset;
+} NetStorageRequest_ReadRanges_Range;
+
+typedef struct _NetStorageRequest_ReadRanges {
+    uint32_t handle;
+    pb_size_t ranges_count;
+    NetStorageRequest_ReadRanges_Range ranges[32];
+} NetStorageRequest_ReadRanges;
+
+typedef struct _NetStorageRequest {
+    pb_size_t which_request;
+    union {
+        NetStorageRequest_FastOpen fastOpen;
+        NetStorageRequest_Open open;
+        NetStorageRequest_Clone clone;
+        NetStorageRequest_Close close;
+        NetStorageRequest_Read read;
+        NetStorageRequest_Write write;
+        NetStorageRequest_FastOpenDir fastOpenDir;
+        NetStorageRequest_OpenDir openDir;
+        NetStorageRequest_CloneDir cloneDir;
+        NetStorageRequest_CloseDir closeDir;
+        NetStorageRequest_ReadDir readDir;
+        NetStorageRequest_Stat stat;
+        NetStorageRequest_StartBenchmark startBenchmark;
+        NetStorageRequest_ReadRanges readRanges;
+        NetStorageRequest_ReadDirBatch readDirBatch;
+    } request;
+    /* Echoed in the responses, which lets the client match them to pipelined requests. */
+    bool has_id;
+    uint32_t id;
+} NetStorageRequest;
+
+typedef struct _NetStorageResponse_Open {
+    uint32_t handle;
+    uint64_t size;
+} NetStorageResponse_Open;
+
+typedef struct _NetStorageResponse_OpenDir {
+    uint32_t handle;
+} NetStorageResponse_OpenDir;
+
+typedef struct _NetStorageResponse_NodeInfo {
+    uint32_t id;
+    NetStorageResponse_NodeInfo_Type type;
+    uint64_t size;
+    char name[128];
+    bool has_modifiedTime;
+    uint64_t modifiedTime; /* Seconds since the Unix epoch */
+} NetStorageResponse_NodeInfo;
+
+typedef struct _NetStorageResponse_Ok {
+    char dummy_field;
+} NetStorageResponse_Ok;
+
+typedef struct _NetStorageResponse_Error {
+    char dummy_field;
+} NetStorageResponse_Error;
+
+typedef struct _NetStorageResponse {
+    pb_size_t which_response;
+    union {
+        NetStorageResponse_Open open;
+        NetStorageResponse_OpenDir openDir;
+        NetStorageResponse_NodeInfo nodeInfo;
+        NetStorageResponse_Ok ok;
+        NetStorageResponse_Error error;
+    } response;
+    bool has_id;
+    uint32_t id;
+} NetStorageResponse;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Helper constants for enums */
+#define _NetStorageResponse_NodeInfo_Type_MIN NetStorageResponse_NodeInfo_Type_File
+#define _NetStorageResponse_NodeInfo_Type_MAX NetStorageResponse_NodeInfo_Type_Dir
+#define _NetStorageResponse_NodeInfo_Type_ARRAYSIZE ((NetStorageResponse_NodeInfo_Type)(NetStorageResponse_NodeInfo_Type_Dir+1))
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+#define NetStorageResponse_NodeInfo_type_ENUMTYPE NetStorageResponse_NodeInfo_Type
+
+
+
+
+/* Initializer values for message structs */
+#define NetStorageRequest_init_default           {0, {NetStorageRequest_FastOpen_init_default}, false, 0}
+#define NetStorageRequest_FastOpen_init_default  {0}
+#define NetStorageRequest_Open_init_default      {"", ""}
+#define NetStorageRequest_Clone_init_default     {0}
+#define NetStorageRequest_Close_init_default     {0}
+#define NetStorageRequest_Read_init_default      {0, 0, 0, false, 0}
+#define NetStorageRequest_Write_init_default     {0, 0, 0}
+#define NetStorageRequest_FastOpenDir_init_default {0}
+#define NetStorageRequest_OpenDir_init_default   {""}
+#define NetStorageRequest_CloneDir_init_default  {0}
+#define NetStorageRequest_CloseDir_init_default  {0}
+#define NetStorageRequest_ReadDir_init_default   {0}
+#define NetStorageRequest_ReadDirBatch_init_default {0, 0}
+#define NetStorageRequest_Stat_init_default      {""}
+#define NetStorageRequest_StartBenchmark_init_default {0}
+#define NetStorageRequest_ReadRanges_init_default {0, 0, {NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default, NetStorageRequest_ReadRanges_Range_init_default}}
+#define NetStorageRequest_ReadRanges_Range_init_default {0, 0}
+#define NetStorageResponse_init_default          {0, {NetStorageResponse_Open_init_default}, false, 0}
+#define NetStorageResponse_Open_init_default     {0, 0}
+#define NetStorageResponse_OpenDir_init_default  {0}
+#define NetStorageResponse_NodeInfo_init_default {0, _NetStorageResponse_NodeInfo_Type_MIN, 0, "", false, 0}
+#define NetStorageResponse_Ok_init_default       {0}
+#define NetStorageResponse_Error_init_default    {0}
+#define NetStorageRequest_init_zero              {0, {NetStorageRequest_FastOpen_init_zero}, false, 0}
+#define NetStorageRequest_FastOpen_init_zero     {0}
+#define NetStorageRequest_Open_init_zero         {"", ""}
+#define NetStorageRequest_Clone_init_zero        {0}
+#define NetStorageRequest_Close_init_zero        {0}
+#define NetStorageRequest_Read_init_zero         {0, 0, 0, false, 0}
+#define NetStorageRequest_Write_init_zero        {0, 0, 0}
+#define NetStorageRequest_FastOpenDir_init_zero  {0}
+#define NetStorageRequest_OpenDir_init_zero      {""}
+#define NetStorageRequest_CloneDir_init_zero     {0}
+#define NetStorageRequest_CloseDir_init_zero     {0}
+#define NetStorageRequest_ReadDir_init_zero      {0}
+#define NetStorageRequest_ReadDirBatch_init_zero {0, 0}
+#define NetStorageRequest_Stat_init_zero         {""}
+#define NetStorageRequest_StartBenchmark_init_zero {0}
+#define NetStorageRequest_ReadRanges_init_zero   {0, 0, {NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero, NetStorageRequest_ReadRanges_Range_init_zero}}
+#define NetStorageRequest_ReadRanges_Range_init_zero {0, 0}
+#define NetStorageResponse_init_zero             {0, {NetStorageResponse_Open_init_zero}, false, 0}
+#define NetStorageResponse_Open_init_zero        {0, 0}
+#define NetStorageResponse_OpenDir_init_zero     {0}
+#define NetStorageResponse_NodeInfo_init_zero    {0, _NetStorageResponse_NodeInfo_Type_MIN, 0, "", false, 0}
+#define NetStorageResponse_Ok_init_zero          {0}
+#define NetStorageResponse_Error_init_zero       {0}
+
+/* Field tags (for use in manual encoding/decoding) */
+#define NetStorageRequest_FastOpen_id_tag        1
+#define NetStorageRequest_Open_path_tag          1
+#define NetStorageRequest_Open_mode_tag          2
+#define NetStorageRequest_Clone_handle_tag       1
+#define NetStorageRequest_Close_handle_tag       1
+#define NetStorageRequest_Read_handle_tag        1
+#define NetStorageRequest_Read_size_tag          2
+#define NetStorageRequest_Read_offset_tag        3
+#define NetStorageRequest_Read_chunkSize_tag     4
+#define NetStorageRequest_Write_handle_tag       1
+#define NetStorageRequest_Write_size_tag         2
+#define NetStorageRequest_Write_offset_tag       3
+#define NetStorageRequest_FastOpenDir_id_tag     1
+#define NetStorageRequest_OpenDir_path_tag       1
+#define NetStorageRequest_CloneDir_handle_tag    1
+#define NetStorageRequest_CloseDir_handle_tag    1
+#define NetStorageRequest_ReadDir_handle_tag     1
+#define NetStorageRequest_ReadDirBatch_handle_tag 1
+#define NetStorageRequest_ReadDirBatch_count_tag 2
+#define NetStorageRequest_Stat_path_tag          1
+#define NetStorageRequest_ReadRanges_Range_size_tag 1
+#define NetStorageRequest_ReadRanges_Range_offset_tag 2
+#define NetStorageRequest_ReadRanges_handle_tag  1
+#define NetStorageRequest_ReadRanges_ranges_tag  2
+#define NetStorageRequest_fastOpen_tag           1
+#define NetStorageRequest_open_tag               2
+#define NetStorageRequest_clone_tag              3
+#define NetStorageRequest_close_tag              4
+#define NetStorageRequest_read_tag               5
+#define NetStorageRequest_write_tag              6
+#define NetStorageRequest_fastOpenDir_tag        7
+#define NetStorageRequest_openDir_tag            8
+#define NetStorageRequest_cloneDir_tag           9
+#define NetStorageRequest_closeDir_tag           10
+#define NetStorageRequest_readDir_tag            11
+#define NetStorageRequest_stat_tag               12
+#define NetStorageRequest_startBenchmark_tag     13
+#define NetStorageRequest_readRanges_tag         14
+#define NetStorageRequest_readDirBatch_tag       15
+#define NetStorageRequest_id_tag                 16
+#define NetStorageResponse_Open_handle_tag       1
+#define NetStorageResponse_Open_size_tag         2
+#define NetStorageResponse_OpenDir_handle_tag    1
+#define NetStorageResponse_NodeInfo_id_tag       1
+#define NetStorageResponse_NodeInfo_type_tag     2
+#define NetStorageResponse_NodeInfo_size_tag     3
+#define NetStorageResponse_NodeInfo_name_tag     4
+#define NetStorageResponse_NodeInfo_modifiedTime_tag 5
+#define NetStorageResponse_open_tag              1
+#define NetStorageResponse_openDir_tag           2
+#define NetStorageResponse_nodeInfo_tag          3
+#define NetStorageResponse_ok_tag                4
+#define NetStorageResponse_error_tag             5
+#define NetStorageResponse_id_tag                6
+
+/* Struct field encoding specification for nanopb */
+#define NetStorageRequest_FIELDLIST(X, a) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,fastOpen,request.fastOpen),   1) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,open,request.open),   2) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,clone,request.clone),   3) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,close,request.close),   4) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,read,request.read),   5) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,write,request.write),   6) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,fastOpenDir,request.fastOpenDir),   7) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,openDir,request.openDir),   8) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,cloneDir,request.cloneDir),   9) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,closeDir,request.closeDir),  10) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,readDir,request.readDir),  11) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,stat,request.stat),  12) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,startBenchmark,request.startBenchmark),  13) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,readRanges,request.readRanges),  14) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,readDirBatch,request.readDirBatch),  15) \
+X(a, STATIC,   OPTIONAL, UINT32,   id,               16)
+#define NetStorageRequest_CALLBACK NULL
+#define NetStorageRequest_DEFAULT NULL
+#define NetStorageRequest_request_fastOpen_MSGTYPE NetStorageRequest_FastOpen
+#define NetStorageRequest_request_open_MSGTYPE NetStorageRequest_Open
+#define NetStorageRequest_request_clone_MSGTYPE NetStorageRequest_Clone
+#define NetStorageRequest_request_close_MSGTYPE NetStorageRequest_Close
+#define NetStorageRequest_request_read_MSGTYPE NetStorageRequest_Read
+#define NetStorageRequest_request_write_MSGTYPE NetStorageRequest_Write
+#define NetStorageRequest_request_fastOpenDir_MSGTYPE NetStorageRequest_FastOpenDir
+#define NetStorageRequest_request_openDir_MSGTYPE NetStorageRequest_OpenDir
+#define NetStorageRequest_request_cloneDir_MSGTYPE NetStorageRequest_CloneDir
+#define NetStorageRequest_request_closeDir_MSGTYPE NetStorageRequest_CloseDir
+#define NetStorageRequest_request_readDir_MSGTYPE NetStorageRequest_ReadDir
+#define NetStorageRequest_request_stat_MSGTYPE NetStorageRequest_Stat
+#define NetStorageRequest_request_startBenchmark_MSGTYPE NetStorageRequest_StartBenchmark
+#define NetStorageRequest_request_readRanges_MSGTYPE NetStorageRequest_ReadRanges
+#define NetStorageRequest_request_readDirBatch_MSGTYPE NetStorageRequest_ReadDirBatch
+
+#define NetStorageRequest_FastOpen_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   id,                1)
+#define NetStorageRequest_FastOpen_CALLBACK NULL
+#define NetStorageRequest_FastOpen_DEFAULT NULL
+
+#define NetStorageRequest_Open_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, STRING,   path,              1) \
+X(a, STATIC,   REQUIRED, STRING,   mode,              2)
+#define NetStorageRequest_Open_CALLBACK NULL
+#define NetStorageRequest_Open_DEFAULT NULL
+
+#define NetStorageRequest_Clone_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   handle,            1)
+#define NetStorageRequest_Clone_CALLBACK NULL
+#define NetStorageRequest_Clone_DEFAULT NULL
+
+#define NetStorageRequest_Close_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   handle,            1)
+#define NetStorageRequest_Close_CALLBACK NULL
+#define NetStorageRequest_Close_DEFAULT NULL
+
+#define NetStorageRequest_Read_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   handle,            1) \
+X(a, STATIC,   REQUIRED, UINT32,   size,              2) \
+X(a, STATIC,   REQUIRED, UINT64,   offset,            3) \
+X(a, STATIC,   OPTIONAL, UINT32,   chunkSize,         4)
+#define NetStorageRequest_Read_CALLBACK NULL
+#define NetStorageRequest_Read_DEFAULT NULL
+
+#define NetStorageRequest_Write_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   handle,            1) \
+X(a, STATIC,   REQUIRED, UINT32,   size,              2) \
+X(a, STATIC,   REQUIRED, UINT64,   offset,            3)
+#define NetStorageRequest_Write_CALLBACK NULL
+#define NetStorageRequest_Write_DEFAULT NULL
+
+#define NetStorageRequest_FastOpenDir_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   id,                1)
+#define NetStorageRequest_FastOpenDir_CALLBACK NULL
+#define NetStorageRequest_FastOpenDir_DEFAULT NULL
+
+#define NetStorageRequest_OpenDir_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, STRING,   path,              1)
+#define NetStorageRequest_OpenDir_CALLBACK NULL
+#define NetStorageRequest_OpenDir_DEFAULT NULL
+
+#define NetStorageRequest_CloneDir_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   handle,            1)
+#define NetStorageRequest_CloneDir_CALLBACK NULL
+#define NetStorageRequest_CloneDir_DEFAULT NULL
+
+#define NetStorageRequest_CloseDir_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   handle,            1)
+#define NetStorageRequest_CloseDir_CALLBACK NULL
+#define NetStorageRequest_CloseDir_DEFAULT NULL
+
+#define NetStorageRequest_ReadDir_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   handle,            1)
+#define NetStorageRequest_ReadDir_CALLBACK NULL
+#define NetStorageRequest_ReadDir_DEFAULT NULL
+
+#define NetStorageRequest_ReadDirBatch_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   handle,            1) \
+X(a, STATIC,   REQUIRED, UINT32,   count,             2)
+#define NetStorageRequest_ReadDirBatch_CALLBACK NULL
+#define NetStorageRequest_ReadDirBatch_DEFAULT NULL
+
+#define NetStorageRequest_Stat_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, STRING,   path,              1)
+#define NetStorageRequest_Stat_CALLBACK NULL
+#define NetStorageRequest_Stat_DEFAULT NULL
+
+#define NetStorageRequest_StartBenchmark_FIELDLIST(X, a) \
+
+#define NetStorageRequest_StartBenchmark_CALLBACK NULL
+#define NetStorageRequest_StartBenchmark_DEFAULT NULL
+
+#define NetStorageRequest_ReadRanges_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   handle,            1) \
+X(a, STATIC,   REPEATED, MESSAGE,  ranges,            2)
+#define NetStorageRequest_ReadRanges_CALLBACK NULL
+#define NetStorageRequest_ReadRanges_DEFAULT NULL
+#define NetStorageRequest_ReadRanges_ranges_MSGTYPE NetStorageRequest_ReadRanges_Range
+
+#define NetStorageRequest_ReadRanges_Range_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   size,              1) \
+X(a, STATIC,   REQUIRED, UINT64,   offset,            2)
+#define NetStorageRequest_ReadRanges_Range_CALLBACK NULL
+#define NetStorageRequest_ReadRanges_Range_DEFAULT NULL
+
+#define NetStorageResponse_FIELDLIST(X, a) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (response,open,response.open),   1) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (response,openDir,response.openDir),   2) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (response,nodeInfo,response.nodeInfo),   3) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (response,ok,response.ok),   4) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (response,error,response.error),   5) \
+X(a, STATIC,   OPTIONAL, UINT32,   id,                6)
+#define NetStorageResponse_CALLBACK NULL
+#define NetStorageResponse_DEFAULT NULL
+#define NetStorageResponse_response_open_MSGTYPE NetStorageResponse_Open
+#define NetStorageResponse_response_openDir_MSGTYPE NetStorageResponse_OpenDir
+#define NetStorageResponse_response_nodeInfo_MSGTYPE NetStorageResponse_NodeInfo
+#define NetStorageResponse_response_ok_MSGTYPE NetStorageResponse_Ok
+#define NetStorageResponse_response_error_MSGTYPE NetStorageResponse_Error
+
+#define NetStorageResponse_Open_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   handle,            1) \
+X(a, STATIC,   REQUIRED, UINT64,   size,              2)
+#define NetStorageResponse_Open_CALLBACK NULL
+#define NetStorageResponse_Open_DEFAULT NULL
+
+#define NetStorageResponse_OpenDir_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   handle,            1)
+#define NetStorageResponse_OpenDir_CALLBACK NULL
+#define NetStorageResponse_OpenDir_DEFAULT NULL
+
+#define NetStorageResponse_NodeInfo_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   id,                1) \
+X(a, STATIC,   REQUIRED, UENUM,    type,              2) \
+X(a, STATIC,   REQUIRED, UINT64,   size,              3) \
+X(a, STATIC,   REQUIRED, STRING,   name,              4) \
+X(a, STATIC,   OPTIONAL, UINT64,   modifiedTime,      5)
+#define NetStorageResponse_NodeInfo_CALLBACK NULL
+#define NetStorageResponse_NodeInfo_DEFAULT NULL
+
+#define NetStorageResponse_Ok_FIELDLIST(X, a) \
+
+#define NetStorageResponse_Ok_CALLBACK NULL
+#define NetStorageResponse_Ok_DEFAULT NULL
+
+#define NetStorageResponse_Error_FIELDLIST(X, a) \
+
+#define NetStorageResponse_Error_CALLBACK NULL
+#define NetStorageResponse_Error_DEFAULT NULL
+
+extern const pb_msgdesc_t NetStorageRequest_msg;
+extern const pb_msgdesc_t NetStorageRequest_FastOpen_msg;
+extern const pb_msgdesc_t NetStorageRequest_Open_msg;
+extern const pb_msgdesc_t NetStorageRequest_Clone_msg;
+extern const pb_msgdesc_t NetStorageRequest_Close_msg;
+extern const pb_msgdesc_t NetStorageRequest_Read_msg;
+extern const pb_msgdesc_t NetStorageRequest_Write_msg;
+extern const pb_msgdesc_t NetStorageRequest_FastOpenDir_msg;
+extern const pb_msgdesc_t NetStorageRequest_OpenDir_msg;
+extern const pb_msgdesc_t NetStorageRequest_CloneDir_msg;
+extern const pb_msgdesc_t NetStorageRequest_CloseDir_msg;
+extern const pb_msgdesc_t NetStorageRequest_ReadDir_msg;
+extern const pb_msgdesc_t NetStorageRequest_ReadDirBatch_msg;
+extern const pb_msgdesc_t NetStorageRequest_Stat_msg;
+extern const pb_msgdesc_t NetStorageRequest_StartBenchmark_msg;
+extern const pb_msgdesc_t NetStorageRequest_ReadRanges_msg;
+extern const pb_msgdesc_t NetStorageRequest_ReadRanges_Range_msg;
+extern const pb_msgdesc_t NetStorageResponse_msg;
+extern const pb_msgdesc_t NetStorageResponse_Open_msg;
+extern const pb_msgdesc_t NetStorageResponse_OpenDir_msg;
+extern const pb_msgdesc_t NetStorageResponse_NodeInfo_msg;
+extern const pb_msgdesc_t NetStorageResponse_Ok_msg;
+extern const pb_msgdesc_t NetStorageResponse_Error_msg;
+
+/* Defines for backwards compatibility with code written before nanopb-0.4.0 */
+#define NetStorageRequest_fields &NetStorageRequest_msg
+#define NetStorageRequest_FastOpen_fields &NetStorageRequest_FastOpen_msg
+#define NetStorageRequest_Open_fields &NetStorageRequest_Open_msg
+#define NetStorageRequest_Clone_fields &NetStorageRequest_Clone_msg
+#define NetStorageRequest_Close_fields &NetStorageRequest_Close_msg
+#define NetStorageRequest_Read_fields &NetStorageRequest_Read_msg
+#define NetStorageRequest_Write_fields &NetStorageRequest_Write_msg
+#define NetStorageRequest_FastOpenDir_fields &NetStorageRequest_FastOpenDir_msg
+#define NetStorageRequest_OpenDir_fields &NetStorageRequest_OpenDir_msg
+#define NetStorageRequest_CloneDir_fields &NetStorageRequest_CloneDir_msg
+#define NetStorageRequest_CloseDir_fields &NetStorageRequest_CloseDir_msg
+#define NetStorageRequest_ReadDir_fields &NetStorageRequest_ReadDir_msg
+#define NetStorageRequest_ReadDirBatch_fields &NetStorageRequest_ReadDirBatch_msg
+#define NetStorageRequest_Stat_fields &NetStorageRequest_Stat_msg
+#define NetStorageRequest_StartBenchmark_fields &NetStorageRequest_StartBenchmark_msg
+#define NetStorageRequest_ReadRanges_fields &NetStorageRequest_ReadRanges_msg
+#define NetStorageRequest_ReadRanges_Range_fields &NetStorageRequest_ReadRanges_Range_msg
+#define NetStorageResponse_fields &NetStorageResponse_msg
+#define NetStorageResponse_Open_fields &NetStorageResponse_Open_msg
+#define NetStorageResponse_OpenDir_fields &NetStorageResponse_OpenDir_msg
+#define NetStorageResponse_NodeInfo_fields &NetStorageResponse_NodeInfo_msg
+#define NetStorageResponse_Ok_fields &NetStorageResponse_Ok_msg
+#define NetStorageResponse_Error_fields &NetStorageResponse_Error_msg
+
+/* Maximum encoded size of messages (where known) */
+#define NetStorageRequest_CloneDir_size          6
+#define NetStorageRequest_Clone_size             6
+#define NetStorageRequest_CloseDir_size          6
+#define NetStorageRequest_Close_size             6
+#define NetStorageRequest_FastOpenDir_size       6
+#define NetStorageRequest_FastOpen_size          6
+#define NetStorageRequest_OpenDir_size           130
+#define NetStorageRequest_Open_size              135
+#define NetStorageRequest_ReadDirBatch_size      12
+#define NetStorageRequest_ReadDir_size           6
+#define NetStorageRequest_ReadRanges_Range_size  17
+#define NetStorageRequest_ReadRanges_size        614
+#define NetStorageRequest_Read_size              29
+#define NetStorageRequest_StartBenchmark_size    0
+#define NetStorageRequest_Stat_size              130
+#define NetStorageRequest_Write_size             23
+#define NetStorageRequest_size                   624
+#define NetStorageResponse_Error_size            0
+#define NetStorageResponse_NodeInfo_size         160
+#define NetStorageResponse_Ok_size               0
+#define NetStorageResponse_OpenDir_size          6
+#define NetStorageResponse_Open_size             17
+#define NetStorageResponse_size                  169
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,102 @@
+/* Automatically generated nanopb constant definitions */
+/* Generated by nanopb-0.4.7 */
+
+#include "Room.pb.h"
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+PB_BIND(InputState, InputState, AUTO)
+
+
+PB_BIND(PlayerFrame, PlayerFrame, AUTO)
+
+
+PB_BIND(PlayerFrame_Vec3, PlayerFrame_Vec3, AUTO)
+
+
+PB_BIND(PlayerFrame_Quat, PlayerFrame_Quat, AUTO)
+
+
+PB_BIND(RoomRequest, RoomRequest, AUTO)
+
+
+PB_BIND(RoomRequest_Join, RoomRequest_Join, AUTO)
+
+
+PB_BIND(RoomRequest_Spectate, RoomRequest_Spectate, AUTO)
+
+
+PB_BIND(RoomRequest_Comment, RoomRequest_Comment, AUTO)
+
+
+PB_BIND(RoomRequest_Settings, RoomRequest_Settings, AUTO)
+
+
+PB_BIND(RoomRequest_Start, RoomRequest_Start, AUTO)
+
+
+PB_BIND(RoomRequest_TeamSelect, RoomRequest_TeamSelect, AUTO)
+
+
+PB_BIND(RoomRequest_Properties, RoomRequest_Properties, AUTO)
+
+
+PB_BIND(RoomRequest_Vote, RoomRequest_Vote, AUTO)
+
+
+PB_BIND(RoomRequest_Race, RoomRequest_Race, AUTO)
+
+
+PB_BIND(RoomEvent, RoomEvent, AUTO)
+
+
+PB_BIND(RoomEvent_Join, RoomEvent_Join, AUTO)
+
+
+PB_BIND(RoomEvent_Leave, RoomEvent_Leave, AUTO)
+
+
+PB_BIND(RoomEvent_Spectate, RoomEvent_Spectate, AUTO)
+
+
+PB_BIND(RoomEvent_Settings, RoomEvent_Settings, AUTO)
+
+
+PB_BIND(RoomEvent_Comment, RoomEvent_Comment, AUTO)
+
+
+PB_BIND(RoomEvent_Start, RoomEvent_Start, AUTO)
+
+
+PB_BIND(RoomEvent_TeamSelect, RoomEvent_TeamSelect, AUTO)
+
+
+PB_BIND(RoomEvent_SelectPulse, RoomEvent_SelectPulse, AUTO)
+
+
+PB_BIND(RoomEvent_Properties, RoomEvent_Properties, AUTO)
+
+
+PB_BIND(RoomEvent_SelectInfo, RoomEvent_SelectInfo, AUTO)
+
+
+PB_BIND(PackedPlayerFrame, PackedPlayerFrame, AUTO)
+
+
+PB_BIND(RaceClientPing, RaceClientPing, AUTO)
+
+
+PB_BIND(PackedRace, PackedRace, AUTO)
+
+
+PB_BIND(RaceClientFrame, RaceClientFrame, 2)
+
+
+PB_BIND(RaceServerFrame, RaceServerFrame, 2)
+
+
+PB_BIND(PackedRaceServerFrame, PackedRaceServerFrame, 2)
+
+
+
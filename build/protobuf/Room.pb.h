@@ -0,0 +1,765 @@
+/* Automatically generated nanopb header */
+/* Generated by nanopb-0.4.7 */
+
+#ifndef PB_ROOM_PB_H_INCLUDED
+#define PB_ROOM_PB_H_INCLUDED
+#include <pb.h>
+#include "Login.pb.h"
+
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+/* Struct definitions */
+typedef struct _InputState {
+    bool accelerate;
+    bool brake;
+    bool item;
+    bool drift;
+    bool brakeDrift;
+    uint32_t stickX;
+    uint32_t stickY;
+    uint32_t trick;
+} InputState;
+
+typedef struct _PlayerFrame_Vec3 {
+    float x;
+    float y;
+    float z;
+} PlayerFrame_Vec3;
+
+typedef struct _PlayerFrame_Quat {
+    float x;
+    float y;
+    float z;
+    float w;
+} PlayerFrame_Quat;
+
+typedef struct _PlayerFrame {
+    InputState inputState;
+    uint32_t timeBeforeRespawn;
+    uint32_t timeInRespawn;
+    pb_size_t timesBeforeBoostEnd_count;
+    uint32_t timesBeforeBoostEnd[3];
+    PlayerFrame_Vec3 pos;
+    PlayerFrame_Quat mainRot;
+    float internalSpeed;
+} PlayerFrame;
+
+typedef PB_BYTES_ARRAY_T(76) RoomRequest_Join_miis_t;
+typedef struct _RoomRequest_Join {
+    pb_size_t miis_count;
+    RoomRequest_Join_miis_t miis[2];
+    uint32_t location;
+    uint32_t latitude;
+    uint32_t longitude;
+    uint32_t regionLineColor;
+    pb_size_t settings_count;
+    uint32_t settings[6];
+    bool has_login_info;
+    LoginInfo login_info;
+} RoomRequest_Join;
+
+typedef struct _RoomRequest_Spectate {
+    char dummy_field;
+} RoomRequest_Spectate;
+
+typedef struct _RoomRequest_Comment {
+    uint32_t messageId;
+} RoomRequest_Comment;
+
+typedef struct _RoomRequest_Settings {
+    pb_size_t settings_count;
+    uint32_t settings[6];
+} RoomRequest_Settings;
+
+typedef struct _RoomRequest_Start {
+    uint32_t gamemode;
+} RoomRequest_Start;
+
+typedef struct _RoomRequest_TeamSelect {
+    uint32_t playerId;
+    uint32_t teamId;
+} RoomRequest_TeamSelect;
+
+typedef struct _RoomRequest_Properties {
+    uint32_t character;
+    uint32_t vehicle;
+    bool driftType;
+} RoomRequest_Properties;
+
+typedef struct _RoomRequest_Vote {
+    uint32_t course;
+    RoomRequest_Properties properties;
+} RoomRequest_Vote;
+
+typedef struct _RoomRequest_Race {
+    uint32_t time;
+    uint32_t serverTime;
+    pb_size_t players_count;
+    PlayerFrame players[2];
+} RoomRequest_Race;
+
+typedef struct _RoomRequest {
+    pb_size_t which_request;
+    union {
+        RoomRequest_Join join;
+        RoomRequest_Spectate spectate;
+        RoomRequest_Comment comment;
+        RoomRequest_Settings settings;
+        RoomRequest_Start start;
+        RoomRequest_TeamSelect teamSelect;
+        RoomRequest_Vote vote;
+        RoomRequest_Race race;
+    } request;
+} RoomRequest;
+
+typedef PB_BYTES_ARRAY_T(76) RoomEvent_Join_mii_t;
+typedef struct _RoomEvent_Join {
+    RoomEvent_Join_mii_t mii;
+    uint32_t location;
+    uint32_t latitude;
+    uint32_t longitude;
+    uint32_t regionLineColor;
+} RoomEvent_Join;
+
+typedef struct _RoomEvent_Leave {
+    uint32_t playerId;
+} RoomEvent_Leave;
+
+typedef struct _RoomEvent_Spectate {
+    uint32_t count;
+} RoomEvent_Spectate;
+
+typedef struct _RoomEvent_Settings {
+    pb_size_t settings_count;
+    uint32_t settings[6];
+} RoomEvent_Settings;
+
+typedef struct _RoomEvent_Comment {
+    uint32_t playerId;
+    uint32_t messageId;
+} RoomEvent_Comment;
+
+typedef struct _RoomEvent_Start {
+    uint32_t gamemode;
+} RoomEvent_Start;
+
+typedef struct _RoomEvent_TeamSelect {
+    uint32_t playerId;
+    uint32_t teamId;
+} RoomEvent_TeamSelect;
+
+typedef struct _RoomEvent_SelectPulse {
+    uint32_t playerId;
+} RoomEvent_SelectPulse;
+
+typedef struct _RoomEvent_Properties {
+    uint32_t character;
+    uint32_t vehicle;
+    bool driftType;
+    uint32_t course;
+} RoomEvent_Properties;
+
+typedef struct _RoomEvent_SelectInfo {
+    pb_size_t playerProperties_count;
+    RoomEvent_Properties playerProperties[12];
+    uint32_t selectedPlayer;
+} RoomEvent_SelectInfo;
+
+typedef struct _RoomEvent {
+    pb_size_t which_event;
+    union {
+        RoomEvent_Join join;
+        RoomEvent_Leave leave;
+        RoomEvent_Spectate spectate;
+        RoomEvent_Comment comment;
+        RoomEvent_Settings settings;
+        RoomEvent_Start start;
+        RoomEvent_TeamSelect teamSelect;
+        RoomEvent_SelectPulse selectPulse;
+        RoomEvent_SelectInfo selectInfo;
+    } event;
+} RoomEvent;
+
+/* PlayerFrame as sent over the race socket, with the position in sixteenths of a unit and the
+ rotation in smallest-three form. */
+typedef struct _PackedPlayerFrame {
+    InputState inputState;
+    uint32_t timeBeforeRespawn;
+    uint32_t timeInRespawn;
+    pb_size_t timesBeforeBoostEnd_count;
+    uint32_t timesBeforeBoostEnd[3];
+    int32_t posX;
+    int32_t posY;
+    int32_t posZ;
+    uint32_t mainRot;
+    float internalSpeed;
+} PackedPlayerFrame;
+
+typedef struct _RaceClientPing {
+    char dummy_field;
+} RaceClientPing;
+
+typedef struct _PackedRace {
+    uint32_t time;
+    uint32_t serverTime; /* The last server frame received, 0 if none */
+    pb_size_t players_count;
+    PackedPlayerFrame players[2];
+} PackedRace;
+
+/* Sent over the race socket every frame, with the previous frames repeated in case their datagrams
+ were lost. */
+typedef struct _RaceClientFrame {
+    pb_size_t frames_count;
+    PackedRace frames[3]; /* Newest first */
+} RaceClientFrame;
+
+/* Decoded from PackedRaceServerFrame. */
+typedef struct _RaceServerFrame {
+    uint32_t time;
+    pb_size_t playerTimes_count;
+    uint32_t playerTimes[12];
+    pb_size_t players_count;
+    PlayerFrame players[12];
+} RaceServerFrame;
+
+typedef struct _PackedRaceServerFrame {
+    uint32_t time;
+    /* If set, the positions are relative to the frame of that time, which the client acknowledged. */
+    bool has_baseTime;
+    uint32_t baseTime;
+    pb_size_t playerTimes_count;
+    uint32_t playerTimes[12];
+    pb_size_t players_count;
+    PackedPlayerFrame players[12];
+} PackedRaceServerFrame;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Initializer values for message structs */
+#define InputState_init_default                  {0, 0, 0, 0, 0, 0, 0, 0}
+#define PlayerFrame_init_default                 {InputState_init_default, 0, 0, 0, {0, 0, 0}, PlayerFrame_Vec3_init_default, PlayerFrame_Quat_init_default, 0}
+#define PlayerFrame_Vec3_init_default            {0, 0, 0}
+#define PlayerFrame_Quat_init_default            {0, 0, 0, 0}
+#define RoomRequest_init_default                 {0, {RoomRequest_Join_init_default}}
+#define RoomRequest_Join_init_default            {0, {{0, {0}}, {0, {0}}}, 0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0}, false, LoginInfo_init_default}
+#define RoomRequest_Spectate_init_default        {0}
+#define RoomRequest_Comment_init_default         {0}
+#define RoomRequest_Settings_init_default        {0, {0, 0, 0, 0, 0, 0}}
+#define RoomRequest_Start_init_default           {0}
+#define RoomRequest_TeamSelect_init_default      {0, 0}
+#define RoomRequest_Properties_init_default      {0, 0, 0}
+#define RoomRequest_Vote_init_default            {0, RoomRequest_Properties_init_default}
+#define RoomRequest_Race_init_default            {0, 0, 0, {PlayerFrame_init_default, PlayerFrame_init_default}}
+#define RoomEvent_init_default                   {0, {RoomEvent_Join_init_default}}
+#define RoomEvent_Join_init_default              {{0, {0}}, 0, 0, 0, 0}
+#define RoomEvent_Leave_init_default             {0}
+#define RoomEvent_Spectate_init_default          {0}
+#define RoomEvent_Settings_init_default          {0, {0, 0, 0, 0, 0, 0}}
+#define RoomEvent_Comment_init_default           {0, 0}
+#define RoomEvent_Start_init_default             {0}
+#define RoomEvent_TeamSelect_init_default        {0, 0}
+#define RoomEvent_SelectPulse_init_default       {0}
+#define RoomEvent_Properties_init_default        {0, 0, 0, 0}
+#define RoomEvent_SelectInfo_init_default        {0, {RoomEvent_Properties_init_default, RoomEvent_Properties_init_default, RoomEvent_Properties_init_default, RoomEvent_Properties_init_default, RoomEvent_Properties_init_default, RoomEvent_Properties_init_default, RoomEvent_Properties_init_default, RoomEvent_Properties_init_default, RoomEvent_Properties_init_default, RoomEvent_Properties_init_default, RoomEvent_Properties_init_default, RoomEvent_Properties_init_default}, 0}
+#define PackedPlayerFrame_init_default           {InputState_init_default, 0, 0, 0, {0, 0, 0}, 0, 0, 0, 0, 0}
+#define RaceClientPing_init_default              {0}
+#define PackedRace_init_default                  {0, 0, 0, {PackedPlayerFrame_init_default, PackedPlayerFrame_init_default}}
+#define RaceClientFrame_init_default             {0, {PackedRace_init_default, PackedRace_init_default, PackedRace_init_default}}
+#define RaceServerFrame_init_default             {0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, {PlayerFrame_init_default, PlayerFrame_init_default, PlayerFrame_init_default, PlayerFrame_init_default, PlayerFrame_init_default, PlayerFrame_init_default, PlayerFrame_init_default, PlayerFrame_init_default, PlayerFrame_init_default, PlayerFrame_init_default, PlayerFrame_init_default, PlayerFrame_init_default}}
+#define PackedRaceServerFrame_init_default       {0, false, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, {PackedPlayerFrame_init_default, PackedPlayerFrame_init_default, PackedPlayerFrame_init_default, PackedPlayerFrame_init_default, PackedPlayerFrame_init_default, PackedPlayerFrame_init_default, PackedPlayerFrame_init_default, PackedPlayerFrame_init_default, PackedPlayerFrame_init_default, PackedPlayerFrame_init_default, PackedPlayerFrame_init_default, PackedPlayerFrame_init_default}}
+#define InputState_init_zero                     {0, 0, 0, 0, 0, 0, 0, 0}
+#define PlayerFrame_init_zero                    {InputState_init_zero, 0, 0, 0, {0, 0, 0}, PlayerFrame_Vec3_init_zero, PlayerFrame_Quat_init_zero, 0}
+#define PlayerFrame_Vec3_init_zero               {0, 0, 0}
+#define PlayerFrame_Quat_init_zero               {0, 0, 0, 0}
+#define RoomRequest_init_zero                    {0, {RoomRequest_Join_init_zero}}
+#define RoomRequest_Join_init_zero               {0, {{0, {0}}, {0, {0}}}, 0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0}, false, LoginInfo_init_zero}
+#define RoomRequest_Spectate_init_zero           {0}
+#define RoomRequest_Comment_init_zero            {0}
+#define RoomRequest_Settings_init_zero           {0, {0, 0, 0, 0, 0, 0}}
+#define RoomRequest_Start_init_zero              {0}
+#define RoomRequest_TeamSelect_init_zero         {0, 0}
+#define RoomRequest_Properties_init_zero         {0, 0, 0}
+#define RoomRequest_Vote_init_zero               {0, RoomRequest_Properties_init_zero}
+#define RoomRequest_Race_init_zero               {0, 0, 0, {PlayerFrame_init_zero, PlayerFrame_init_zero}}
+#define RoomEvent_init_zero                      {0, {RoomEvent_Join_init_zero}}
+#define RoomEvent_Join_init_zero                 {{0, {0}}, 0, 0, 0, 0}
+#define RoomEvent_Leave_init_zero                {0}
+#define RoomEvent_Spectate_init_zero             {0}
+#define RoomEvent_Settings_init_zero             {0, {0, 0, 0, 0, 0, 0}}
+#define RoomEvent_Comment_init_zero              {0, 0}
+#define RoomEvent_Start_init_zero                {0}
+#define RoomEvent_TeamSelect_init_zero           {0, 0}
+#define RoomEvent_SelectPulse_init_zero          {0}
+#define RoomEvent_Properties_init_zero           {0, 0, 0, 0}
+#define RoomEvent_SelectInfo_init_zero           {0, {RoomEvent_Properties_init_zero, RoomEvent_Properties_init_zero, RoomEvent_Properties_init_zero, RoomEvent_Properties_init_zero, RoomEvent_Properties_init_zero, RoomEvent_Properties_init_zero, RoomEvent_Properties_init_zero, RoomEvent_Properties_init_zero, RoomEvent_Properties_init_zero, RoomEvent_Properties_init_zero, RoomEvent_Properties_init_zero, RoomEvent_Properties_init_zero}, 0}
+#define PackedPlayerFrame_init_zero              {InputState_init_zero, 0, 0, 0, {0, 0, 0}, 0, 0, 0, 0, 0}
+#define RaceClientPing_init_zero                 {0}
+#define PackedRace_init_zero                     {0, 0, 0, {PackedPlayerFrame_init_zero, PackedPlayerFrame_init_zero}}
+#define RaceClientFrame_init_zero                {0, {PackedRace_init_zero, PackedRace_init_zero, PackedRace_init_zero}}
+#define RaceServerFrame_init_zero                {0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, {PlayerFrame_init_zero, PlayerFrame_init_zero, PlayerFrame_init_zero, PlayerFrame_init_zero, PlayerFrame_init_zero, PlayerFrame_init_zero, PlayerFrame_init_zero, PlayerFrame_init_zero, PlayerFrame_init_zero, PlayerFrame_init_zero, PlayerFrame_init_zero, PlayerFrame_init_zero}}
+#define PackedRaceServerFrame_init_zero          {0, false, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, {PackedPlayerFrame_init_zero, PackedPlayerFrame_init_zero, PackedPlayerFrame_init_zero, PackedPlayerFrame_init_zero, PackedPlayerFrame_init_zero, PackedPlayerFrame_init_zero, PackedPlayerFrame_init_zero, PackedPlayerFrame_init_zero, PackedPlayerFrame_init_zero, PackedPlayerFrame_init_zero, PackedPlayerFrame_init_zero, PackedPlayerFrame_init_zero}}
+
+/* Field tags (for use in manual encoding/decoding) */
+#define InputState_accelerate_tag                1
+#define InputState_brake_tag                     2
+#define InputState_item_tag                      3
+#define InputState_drift_tag                     4
+#define InputState_brakeDrift_tag                5
+#define InputState_stickX_tag                    6
+#define InputState_stickY_tag                    7
+#define InputState_trick_tag                     8
+#define PlayerFrame_Vec3_x_tag                   1
+#define PlayerFrame_Vec3_y_tag                   2
+#define PlayerFrame_Vec3_z_tag                   3
+#define PlayerFrame_Quat_x_tag                   1
+#define PlayerFrame_Quat_y_tag                   2
+#define PlayerFrame_Quat_z_tag                   3
+#define PlayerFrame_Quat_w_tag                   4
+#define PlayerFrame_inputState_tag               1
+#define PlayerFrame_timeBeforeRespawn_tag        2
+#define PlayerFrame_timeInRespawn_tag            3
+#define PlayerFrame_timesBeforeBoostEnd_tag      4
+#define PlayerFrame_pos_tag                      5
+#define PlayerFrame_mainRot_tag                  6
+#define PlayerFrame_internalSpeed_tag            7
+#define RoomRequest_Join_miis_tag                1
+#define RoomRequest_Join_location_tag            2
+#define RoomRequest_Join_latitude_tag            3
+#define RoomRequest_Join_longitude_tag           4
+#define RoomRequest_Join_regionLineColor_tag     5
+#define RoomRequest_Join_settings_tag            6
+#define RoomRequest_Join_login_info_tag          7
+#define RoomRequest_Comment_messageId_tag        1
+#define RoomRequest_Settings_settings_tag        1
+#define RoomRequest_Start_gamemode_tag           1
+#define RoomRequest_TeamSelect_playerId_tag      1
+#define RoomRequest_TeamSelect_teamId_tag        2
+#define RoomRequest_Properties_character_tag     1
+#define RoomRequest_Properties_vehicle_tag       2
+#define RoomRequest_Properties_driftType_tag     3
+#define RoomRequest_Vote_course_tag              1
+#define RoomRequest_Vote_properties_tag          2
+#define RoomRequest_Race_time_tag                1
+#define RoomRequest_Race_serverTime_tag          2
+#define RoomRequest_Race_players_tag             3
+#define RoomRequest_join_tag                     1
+#define RoomRequest_spectate_tag                 2
+#define RoomRequest_comment_tag                  3
+#define RoomRequest_settings_tag                 4
+#define RoomRequest_start_tag                    5
+#define RoomRequest_teamSelect_tag               6
+#define RoomRequest_vote_tag                     7
+#define RoomRequest_race_tag                     8
+#define RoomEvent_Join_mii_tag                   1
+#define RoomEvent_Join_location_tag              2
+#define RoomEvent_Join_latitude_tag              3
+#define RoomEvent_Join_longitude_tag             4
+#define RoomEvent_Join_regionLineColor_tag       5
+#define RoomEvent_Leave_playerId_tag             1
+#define RoomEvent_Spectate_count_tag             1
+#define RoomEvent_Settings_settings_tag          1
+#define RoomEvent_Comment_playerId_tag           1
+#define RoomEvent_Comment_messageId_tag          2
+#define RoomEvent_Start_gamemode_tag             1
+#define RoomEvent_TeamSelect_playerId_tag        1
+#define RoomEvent_TeamSelect_teamId_tag          2
+#define RoomEvent_SelectPulse_playerId_tag       1
+#define RoomEvent_Properties_character_tag       1
+#define RoomEvent_Properties_vehicle_tag         2
+#define RoomEvent_Properties_driftType_tag       3
+#define RoomEvent_Properties_course_tag          4
+#define RoomEvent_SelectInfo_playerProperties_tag 1
+#define RoomEvent_SelectInfo_selectedPlayer_tag  2
+#define RoomEvent_join_tag                       1
+#define RoomEvent_leave_tag                      2
+#define RoomEvent_spectate_tag                   3
+#define RoomEvent_comment_tag                    4
+#define RoomEvent_settings_tag                   5
+#define RoomEvent_start_tag                      6
+#define RoomEvent_teamSelect_tag                 7
+#define RoomEvent_selectPulse_tag                8
+#define RoomEvent_selectInfo_tag                 9
+#define PackedPlayerFrame_inputState_tag         1
+#define PackedPlayerFrame_timeBeforeRespawn_tag  2
+#define PackedPlayerFrame_timeInRespawn_tag      3
+#define PackedPlayerFrame_timesBeforeBoostEnd_tag 4
+#define PackedPlayerFrame_posX_tag               5
+#define PackedPlayerFrame_posY_tag               6
+#define PackedPlayerFrame_posZ_tag               7
+#define PackedPlayerFrame_mainRot_tag            8
+#define PackedPlayerFrame_internalSpeed_tag      9
+#define PackedRace_time_tag                      1
+#define PackedRace_serverTime_tag                2
+#define PackedRace_players_tag                   3
+#define RaceClientFrame_frames_tag               1
+#define RaceServerFrame_time_tag                 1
+#define RaceServerFrame_playerTimes_tag          2
+#define RaceServerFrame_players_tag              3
+#define PackedRaceServerFrame_time_tag           1
+#define PackedRaceServerFrame_baseTime_tag       2
+#define PackedRaceServerFrame_playerTimes_tag    3
+#define PackedRaceServerFrame_players_tag        4
+
+/* Struct field encoding specification for nanopb */
+#define InputState_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, BOOL,     accelerate,        1) \
+X(a, STATIC,   REQUIRED, BOOL,     brake,             2) \
+X(a, STATIC,   REQUIRED, BOOL,     item,              3) \
+X(a, STATIC,   REQUIRED, BOOL,     drift,             4) \
+X(a, STATIC,   REQUIRED, BOOL,     brakeDrift,        5) \
+X(a, STATIC,   REQUIRED, UINT32,   stickX,            6) \
+X(a, STATIC,   REQUIRED, UINT32,   stickY,            7) \
+X(a, STATIC,   REQUIRED, UINT32,   trick,             8)
+#define InputState_CALLBACK NULL
+#define InputState_DEFAULT NULL
+
+#define PlayerFrame_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, MESSAGE,  inputState,        1) \
+X(a, STATIC,   REQUIRED, UINT32,   timeBeforeRespawn,   2) \
+X(a, STATIC,   REQUIRED, UINT32,   timeInRespawn,     3) \
+X(a, STATIC,   REPEATED, UINT32,   timesBeforeBoostEnd,   4) \
+X(a, STATIC,   REQUIRED, MESSAGE,  pos,               5) \
+X(a, STATIC,   REQUIRED, MESSAGE,  mainRot,           6) \
+X(a, STATIC,   REQUIRED, FLOAT,    internalSpeed,     7)
+#define PlayerFrame_CALLBACK NULL
+#define PlayerFrame_DEFAULT NULL
+#define PlayerFrame_inputState_MSGTYPE InputState
+#define PlayerFrame_pos_MSGTYPE PlayerFrame_Vec3
+#define PlayerFrame_mainRot_MSGTYPE PlayerFrame_Quat
+
+#define PlayerFrame_Vec3_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, FLOAT,    x,                 1) \
+X(a, STATIC,   REQUIRED, FLOAT,    y,                 2) \
+X(a, STATIC,   REQUIRED, FLOAT,    z,                 3)
+#define PlayerFrame_Vec3_CALLBACK NULL
+#define PlayerFrame_Vec3_DEFAULT NULL
+
+#define PlayerFrame_Quat_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, FLOAT,    x,                 1) \
+X(a, STATIC,   REQUIRED, FLOAT,    y,                 2) \
+X(a, STATIC,   REQUIRED, FLOAT,    z,                 3) \
+X(a, STATIC,   REQUIRED, FLOAT,    w,                 4)
+#define PlayerFrame_Quat_CALLBACK NULL
+#define PlayerFrame_Quat_DEFAULT NULL
+
+#define RoomRequest_FIELDLIST(X, a) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,join,request.join),   1) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,spectate,request.spectate),   2) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,comment,request.comment),   3) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,settings,request.settings),   4) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,start,request.start),   5) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,teamSelect,request.teamSelect),   6) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,vote,request.vote),   7) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (request,race,request.race),   8)
+#define RoomRequest_CALLBACK NULL
+#define RoomRequest_DEFAULT NULL
+#define RoomRequest_request_join_MSGTYPE RoomRequest_Join
+#define RoomRequest_request_spectate_MSGTYPE RoomRequest_Spectate
+#define RoomRequest_request_comment_MSGTYPE RoomRequest_Comment
+#define RoomRequest_request_settings_MSGTYPE RoomRequest_Settings
+#define RoomRequest_request_start_MSGTYPE RoomRequest_Start
+#define RoomRequest_request_teamSelect_MSGTYPE RoomRequest_TeamSelect
+#define RoomRequest_request_vote_MSGTYPE RoomRequest_Vote
+#define RoomRequest_request_race_MSGTYPE RoomRequest_Race
+
+#define RoomRequest_Join_FIELDLIST(X, a) \
+X(a, STATIC,   REPEATED, BYTES,    miis,              1) \
+X(a, STATIC,   REQUIRED, UINT32,   location,          2) \
+X(a, STATIC,   REQUIRED, UINT32,   latitude,          3) \
+X(a, STATIC,   REQUIRED, UINT32,   longitude,         4) \
+X(a, STATIC,   REQUIRED, UINT32,   regionLineColor,   5) \
+X(a, STATIC,   REPEATED, UINT32,   settings,          6) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  login_info,        7)
+#define RoomRequest_Join_CALLBACK NULL
+#define RoomRequest_Join_DEFAULT NULL
+#define RoomRequest_Join_login_info_MSGTYPE LoginInfo
+
+#define RoomRequest_Spectate_FIELDLIST(X, a) \
+
+#define RoomRequest_Spectate_CALLBACK NULL
+#define RoomRequest_Spectate_DEFAULT NULL
+
+#define RoomRequest_Comment_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   messageId,         1)
+#define RoomRequest_Comment_CALLBACK NULL
+#define RoomRequest_Comment_DEFAULT NULL
+
+#define RoomRequest_Settings_FIELDLIST(X, a) \
+X(a, STATIC,   REPEATED, UINT32,   settings,          1)
+#define RoomRequest_Settings_CALLBACK NULL
+#define RoomRequest_Settings_DEFAULT NULL
+
+#define RoomRequest_Start_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   gamemode,          1)
+#define RoomRequest_Start_CALLBACK NULL
+#define RoomRequest_Start_DEFAULT NULL
+
+#define RoomRequest_TeamSelect_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   playerId,          1) \
+X(a, STATIC,   REQUIRED, UINT32,   teamId,            2)
+#define RoomRequest_TeamSelect_CALLBACK NULL
+#define RoomRequest_TeamSelect_DEFAULT NULL
+
+#define RoomRequest_Properties_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   character,         1) \
+X(a, STATIC,   REQUIRED, UINT32,   vehicle,           2) \
+X(a, STATIC,   REQUIRED, BOOL,     driftType,         3)
+#define RoomRequest_Properties_CALLBACK NULL
+#define RoomRequest_Properties_DEFAULT NULL
+
+#define RoomRequest_Vote_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   course,            1) \
+X(a, STATIC,   REQUIRED, MESSAGE,  properties,        2)
+#define RoomRequest_Vote_CALLBACK NULL
+#define RoomRequest_Vote_DEFAULT NULL
+#define RoomRequest_Vote_properties_MSGTYPE RoomRequest_Properties
+
+#define RoomRequest_Race_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   time,              1) \
+X(a, STATIC,   REQUIRED, UINT32,   serverTime,        2) \
+X(a, STATIC,   REPEATED, MESSAGE,  players,           3)
+#define RoomRequest_Race_CALLBACK NULL
+#define RoomRequest_Race_DEFAULT NULL
+#define RoomRequest_Race_players_MSGTYPE PlayerFrame
+
+#define RoomEvent_FIELDLIST(X, a) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (event,join,event.join),   1) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (event,leave,event.leave),   2) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (event,spectate,event.spectate),   3) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (event,comment,event.comment),   4) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (event,settings,event.settings),   5) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (event,start,event.start),   6) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (event,teamSelect,event.teamSelect),   7) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (event,selectPulse,event.selectPulse),   8) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (event,selectInfo,event.selectInfo),   9)
+#define RoomEvent_CALLBACK NULL
+#define RoomEvent_DEFAULT NULL
+#define RoomEvent_event_join_MSGTYPE RoomEvent_Join
+#define RoomEvent_event_leave_MSGTYPE RoomEvent_Leave
+#define RoomEvent_event_spectate_MSGTYPE RoomEvent_Spectate
+#define RoomEvent_event_comment_MSGTYPE RoomEvent_Comment
+#define RoomEvent_event_settings_MSGTYPE RoomEvent_Settings
+#define RoomEvent_event_start_MSGTYPE RoomEvent_Start
+#define RoomEvent_event_teamSelect_MSGTYPE RoomEvent_TeamSelect
+#define RoomEvent_event_selectPulse_MSGTYPE RoomEvent_SelectPulse
+#define RoomEvent_event_selectInfo_MSGTYPE RoomEvent_SelectInfo
+
+#define RoomEvent_Join_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, BYTES,    mii,               1) \
+X(a, STATIC,   REQUIRED, UINT32,   location,          2) \
+X(a, STATIC,   REQUIRED, UINT32,   latitude,          3) \
+X(a, STATIC,   REQUIRED, UINT32,   longitude,         4) \
+X(a, STATIC,   REQUIRED, UINT32,   regionLineColor,   5)
+#define RoomEvent_Join_CALLBACK NULL
+#define RoomEvent_Join_DEFAULT NULL
+
+#define RoomEvent_Leave_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   playerId,          1)
+#define RoomEvent_Leave_CALLBACK NULL
+#define RoomEvent_Leave_DEFAULT NULL
+
+#define RoomEvent_Spectate_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   count,             1)
+#define RoomEvent_Spectate_CALLBACK NULL
+#define RoomEvent_Spectate_DEFAULT NULL
+
+#define RoomEvent_Settings_FIELDLIST(X, a) \
+X(a, STATIC,   REPEATED, UINT32,   settings,          1)
+#define RoomEvent_Settings_CALLBACK NULL
+#define RoomEvent_Settings_DEFAULT NULL
+
+#define RoomEvent_Comment_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   playerId,          1) \
+X(a, STATIC,   REQUIRED, UINT32,   messageId,         2)
+#define RoomEvent_Comment_CALLBACK NULL
+#define RoomEvent_Comment_DEFAULT NULL
+
+#define RoomEvent_Start_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   gamemode,          1)
+#define RoomEvent_Start_CALLBACK NULL
+#define RoomEvent_Start_DEFAULT NULL
+
+#define RoomEvent_TeamSelect_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   playerId,          1) \
+X(a, STATIC,   REQUIRED, UINT32,   teamId,            2)
+#define RoomEvent_TeamSelect_CALLBACK NULL
+#define RoomEvent_TeamSelect_DEFAULT NULL
+
+#define RoomEvent_SelectPulse_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   playerId,          1)
+#define RoomEvent_SelectPulse_CALLBACK NULL
+#define RoomEvent_SelectPulse_DEFAULT NULL
+
+#define RoomEvent_Properties_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   character,         1) \
+X(a, STATIC,   REQUIRED, UINT32,   vehicle,           2) \
+X(a, STATIC,   REQUIRED, BOOL,     driftType,         3) \
+X(a, STATIC,   REQUIRED, UINT32,   course,            4)
+#define RoomEvent_Properties_CALLBACK NULL
+#define RoomEvent_Properties_DEFAULT NULL
+
+#define RoomEvent_SelectInfo_FIELDLIST(X, a) \
+X(a, STATIC,   REPEATED, MESSAGE,  playerProperties,   1) \
+X(a, STATIC,   REQUIRED, UINT32,   selectedPlayer,    2)
+#define RoomEvent_SelectInfo_CALLBACK NULL
+#define RoomEvent_SelectInfo_DEFAULT NULL
+#define RoomEvent_SelectInfo_playerProperties_MSGTYPE RoomEvent_Properties
+
+#define PackedPlayerFrame_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, MESSAGE,  inputState,        1) \
+X(a, STATIC,   REQUIRED, UINT32,   timeBeforeRespawn,   2) \
+X(a, STATIC,   REQUIRED, UINT32,   timeInRespawn,     3) \
+X(a, STATIC,   REPEATED, UINT32,   timesBeforeBoostEnd,   4) \
+X(a, STATIC,   REQUIRED, SINT32,   posX,              5) \
+X(a, STATIC,   REQUIRED, SINT32,   posY,              6) \
+X(a, STATIC,   REQUIRED, SINT32,   posZ,              7) \
+X(a, STATIC,   REQUIRED, FIXED32,  mainRot,           8) \
+X(a, STATIC,   REQUIRED, FLOAT,    internalSpeed,     9)
+#define PackedPlayerFrame_CALLBACK NULL
+#define PackedPlayerFrame_DEFAULT NULL
+#define PackedPlayerFrame_inputState_MSGTYPE InputState
+
+#define RaceClientPing_FIELDLIST(X, a) \
+
+#define RaceClientPing_CALLBACK NULL
+#define RaceClientPing_DEFAULT NULL
+
+#define PackedRace_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   time,              1) \
+X(a, STATIC,   REQUIRED, UINT32,   serverTime,        2) \
+X(a, STATIC,   REPEATED, MESSAGE,  players,           3)
+#define PackedRace_CALLBACK NULL
+#define PackedRace_DEFAULT NULL
+#define PackedRace_players_MSGTYPE PackedPlayerFrame
+
+#define RaceClientFrame_FIELDLIST(X, a) \
+X(a, STATIC,   REPEATED, MESSAGE,  frames,            1)
+#define RaceClientFrame_CALLBACK NULL
+#define RaceClientFrame_DEFAULT NULL
+#define RaceClientFrame_frames_MSGTYPE PackedRace
+
+#define RaceServerFrame_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   time,              1) \
+X(a, STATIC,   REPEATED, UINT32,   playerTimes,       2) \
+X(a, STATIC,   REPEATED, MESSAGE,  players,           3)
+#define RaceServerFrame_CALLBACK NULL
+#define RaceServerFrame_DEFAULT NULL
+#define RaceServerFrame_players_MSGTYPE PlayerFrame
+
+#define PackedRaceServerFrame_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   time,              1) \
+X(a, STATIC,   OPTIONAL, UINT32,   baseTime,          2) \
+X(a, STATIC,   REPEATED, UINT32,   playerTimes,       3) \
+X(a, STATIC,   REPEATED, MESSAGE,  players,           4)
+#define PackedRaceServerFrame_CALLBACK NULL
+#define PackedRaceServerFrame_DEFAULT NULL
+#define PackedRaceServerFrame_players_MSGTYPE PackedPlayerFrame
+
+extern const pb_msgdesc_t InputState_msg;
+extern const pb_msgdesc_t PlayerFrame_msg;
+extern const pb_msgdesc_t PlayerFrame_Vec3_msg;
+extern const pb_msgdesc_t PlayerFrame_Quat_msg;
+extern const pb_msgdesc_t RoomRequest_msg;
+extern const pb_msgdesc_t RoomRequest_Join_msg;
+extern const pb_msgdesc_t RoomRequest_Spectate_msg;
+extern const pb_msgdesc_t RoomRequest_Comment_msg;
+extern const pb_msgdesc_t RoomRequest_Settings_msg;
+extern const pb_msgdesc_t RoomRequest_Start_msg;
+extern const pb_msgdesc_t RoomRequest_TeamSelect_msg;
+extern const pb_msgdesc_t RoomRequest_Properties_msg;
+extern const pb_msgdesc_t RoomRequest_Vote_msg;
+extern const pb_msgdesc_t RoomRequest_Race_msg;
+extern const pb_msgdesc_t RoomEvent_msg;
+extern const pb_msgdesc_t RoomEvent_Join_msg;
+extern const pb_msgdesc_t RoomEvent_Leave_msg;
+extern const pb_msgdesc_t RoomEvent_Spectate_msg;
+extern const pb_msgdesc_t RoomEvent_Settings_msg;
+extern const pb_msgdesc_t RoomEvent_Comment_msg;
+extern const pb_msgdesc_t RoomEvent_Start_msg;
+extern const pb_msgdesc_t RoomEvent_TeamSelect_msg;
+extern const pb_msgdesc_t RoomEvent_SelectPulse_msg;
+extern const pb_msgdesc_t RoomEvent_Properties_msg;
+extern const pb_msgdesc_t RoomEvent_SelectInfo_msg;
+extern const pb_msgdesc_t PackedPlayerFrame_msg;
+extern const pb_msgdesc_t RaceClientPing_msg;
+extern const pb_msgdesc_t PackedRace_msg;
+extern const pb_msgdesc_t RaceClientFrame_msg;
+extern const pb_msgdesc_t RaceServerFrame_msg;
+extern const pb_msgdesc_t PackedRaceServerFrame_msg;
+
+/* Defines for backwards compatibility with code written before nanopb-0.4.0 */
+#define InputState_fields &InputState_msg
+#define PlayerFrame_fields &PlayerFrame_msg
+#define PlayerFrame_Vec3_fields &PlayerFrame_Vec3_msg
+#define PlayerFrame_Quat_fields &PlayerFrame_Quat_msg
+#define RoomRequest_fields &RoomRequest_msg
+#define RoomRequest_Join_fields &RoomRequest_Join_msg
+#define RoomRequest_Spectate_fields &RoomRequest_Spectate_msg
+#define RoomRequest_Comment_fields &RoomRequest_Comment_msg
+#define RoomRequest_Settings_fields &RoomRequest_Settings_msg
+#define RoomRequest_Start_fields &RoomRequest_Start_msg
+#define RoomRequest_TeamSelect_fields &RoomRequest_TeamSelect_msg
+#define RoomRequest_Properties_fields &RoomRequest_Properties_msg
+#define RoomRequest_Vote_fields &RoomRequest_Vote_msg
+#define RoomRequest_Race_fields &RoomRequest_Race_msg
+#define RoomEvent_fields &RoomEvent_msg
+#define RoomEvent_Join_fields &RoomEvent_Join_msg
+#define RoomEvent_Leave_fields &RoomEvent_Leave_msg
+#define RoomEvent_Spectate_fields &RoomEvent_Spectate_msg
+#define RoomEvent_Settings_fields &RoomEvent_Settings_msg
+#define RoomEvent_Comment_fields &RoomEvent_Comment_msg
+#define RoomEvent_Start_fields &RoomEvent_Start_msg
+#define RoomEvent_TeamSelect_fields &RoomEvent_TeamSelect_msg
+#define RoomEvent_SelectPulse_fields &RoomEvent_SelectPulse_msg
+#define RoomEvent_Properties_fields &RoomEvent_Properties_msg
+#define RoomEvent_SelectInfo_fields &RoomEvent_SelectInfo_msg
+#define PackedPlayerFrame_fields &PackedPlayerFrame_msg
+#define RaceClientPing_fields &RaceClientPing_msg
+#define PackedRace_fields &PackedRace_msg
+#define RaceClientFrame_fields &RaceClientFrame_msg
+#define RaceServerFrame_fields &RaceServerFrame_msg
+#define PackedRaceServerFrame_fields &PackedRaceServerFrame_msg
+
+/* Maximum encoded size of messages (where known) */
+#define InputState_size                          28
+#define PackedPlayerFrame_size                   88
+#define PackedRaceServerFrame_size               1164
+#define PackedRace_size                          192
+#define PlayerFrame_Quat_size                    20
+#define PlayerFrame_Vec3_size                    15
+#define PlayerFrame_size                         104
+#define RaceClientFrame_size                     585
+#define RaceClientPing_size                      0
+#define RaceServerFrame_size                     1350
+#define RoomEvent_Comment_size                   12
+#define RoomEvent_Join_size                      102
+#define RoomEvent_Leave_size                     6
+#define RoomEvent_Properties_size                20
+#define RoomEvent_SelectInfo_size                270
+#define RoomEvent_SelectPulse_size               6
+#define RoomEvent_Settings_size                  36
+#define RoomEvent_Spectate_size                  6
+#define RoomEvent_Start_size                     6
+#define RoomEvent_TeamSelect_size                12
+#define RoomEvent_size                           273
+#define RoomRequest_Comment_size                 6
+#define RoomRequest_Join_size                    246
+#define RoomRequest_Properties_size              14
+#define RoomRequest_Race_size                    224
+#define RoomRequest_Settings_size                36
+#define RoomRequest_Spectate_size                0
+#define RoomRequest_Start_size                   6
+#define RoomRequest_TeamSelect_size              12
+#define RoomRequest_Vote_size                    22
+#define RoomRequest_size                         249
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,90 @@
+/* Automatically generated nanopb header */
+/* Generated by nanopb-0.4.7 */
+
+#ifndef PB_UPDATE_PB_H_INCLUDED
+#define PB_UPDATE_PB_H_INCLUDED
+#include <pb.h>
+
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+/* Struct definitions */
+typedef struct _UpdateRequest {
+    bool wantsUpdate;
+    uint32_t versionMajor;
+    uint32_t versionMinor;
+    uint32_t versionPatch;
+    char gameName[5];
+    char hostPlatform[32];
+} UpdateRequest;
+
+typedef PB_BYTES_ARRAY_T(64) UpdateResponse_signature_t;
+typedef struct _UpdateResponse {
+    uint32_t versionMajor;
+    uint32_t versionMinor;
+    uint32_t versionPatch;
+    uint32_t size;
+    UpdateResponse_signature_t signature;
+} UpdateResponse;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Initializer values for message structs */
+#define UpdateRequest_init_default               {0, 0, 0, 0, "", ""}
+#define UpdateResponse_init_default              {0, 0, 0, 0, {0, {0}}}
+#define UpdateRequest_init_zero                  {0, 0, 0, 0, "", ""}
+#define UpdateResponse_init_zero                 {0, 0, 0, 0, {0, {0}}}
+
+/* Field tags (for use in manual encoding/decoding) */
+#define UpdateRequest_wantsUpdate_tag            1
+#define UpdateRequest_versionMajor_tag           2
+#define UpdateRequest_versionMinor_tag           3
+#define UpdateRequest_versionPatch_tag           4
+#define UpdateRequest_gameName_tag               5
+#define UpdateRequest_hostPlatform_tag           6
+#define UpdateResponse_versionMajor_tag          1
+#define UpdateResponse_versionMinor_tag          2
+#define UpdateResponse_versionPatch_tag          3
+#define UpdateResponse_size_tag                  4
+#define UpdateResponse_signature_tag             5
+
+/* Struct field encoding specification for nanopb */
+#define UpdateRequest_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, BOOL,     wantsUpdate,       1) \
+X(a, STATIC,   REQUIRED, UINT32,   versionMajor,      2) \
+X(a, STATIC,   REQUIRED, UINT32,   versionMinor,      3) \
+X(a, STATIC,   REQUIRED, UINT32,   versionPatch,      4) \
+X(a, STATIC,   REQUIRED, STRING,   gameName,          5) \
+X(a, STATIC,   REQUIRED, STRING,   hostPlatform,      6)
+#define UpdateRequest_CALLBACK NULL
+#define UpdateRequest_DEFAULT NULL
+
+#define UpdateResponse_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   versionMajor,      1) \
+X(a, STATIC,   REQUIRED, UINT32,   versionMinor,      2) \
+X(a, STATIC,   REQUIRED, UINT32,   versionPatch,      3) \
+X(a, STATIC,   REQUIRED, UINT32,   size,              4) \
+X(a, STATIC,   REQUIRED, BYTES,    signature,         5)
+#define UpdateResponse_CALLBACK NULL
+#define UpdateResponse_DEFAULT NULL
+
+extern const pb_msgdesc_t UpdateRequest_msg;
+extern const pb_msgdesc_t UpdateResponse_msg;
+
+/* Defines for backwards compatibility with code written before nanopb-0.4.0 */
+#define UpdateRequest_fields &UpdateRequest_msg
+#define UpdateResponse_fields &UpdateResponse_msg
+
+/* Maximum encoded size of messages (where known) */
+#define UpdateRequest_size                       59
+#define UpdateResponse_size                      90
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -9,6 +9,7 @@ extern "C" {
 #include <sp/settings/ClientSettings.hh>
 #include <sp/storage/DecompLoader.hh>
 
+#include "game/system/ResourceManager.hh"
 #include "game/system/SaveManager.hh"
 
 #include <cstring>
@@ -92,8 +93,14 @@ DvdArchive::State DvdArchive::state() const {
 bool DvdArchive::decompress(const char *path, EGG::Heap *archiveHeap) {
     u8 *archiveBuffer;
     size_t archiveSize;
-    bool success =
-            SP::Storage::DecompLoader::LoadRO(path, &archiveBuffer, &archiveSize, archiveHeap);
+    bool success = false;
+    if (auto *resourceManager = ResourceManager::Instance()) {
+        auto *courseCache = resourceManager->courseCache();
+        success = courseCache->take(path, archiveHeap, &archiveBuffer, &archiveSize);
+    }
+    if (!success) {
+        success = SP::Storage::DecompLoader::LoadRO(path, &archiveBuffer, &archiveSize, archiveHeap);
+    }
     if (success) {
         m_archiveBuffer = archiveBuffer;
         m_archiveSize = archiveSize;
@@ -142,6 +142,11 @@ GhostFooter::GhostFooter(const u8 *raw, u32 size) {
     }
 }
 
+GhostFooter::GhostFooter(Sha1 courseSHA1, bool hasSpeedMod) : m_magic(SPFooter::MAGIC), m_sp{} {
+    m_sp.courseSHA1 = courseSHA1;
+    m_sp.hasSpeedMod = hasSpeedMod;
+}
+
 GhostFooter::~GhostFooter() = default;
 
 std::optional<Sha1> GhostFooter::courseSHA1() const {
@@ -112,6 +112,8 @@ class GhostFooter {
 public:
     GhostFooter();
     GhostFooter(const u8 *raw, u32 size);
+    // Restores a footer from the ghost index, which only keeps what the accessors below return.
+    GhostFooter(Sha1 courseSHA1, bool hasSpeedMod);
     ~GhostFooter();
     std::optional<Sha1> courseSHA1() const;
     std::optional<bool> hasSpeedMod() const;
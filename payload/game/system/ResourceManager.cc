@@ -1,14 +1,45 @@
 #include "ResourceManager.hh"
 
+#include "game/system/RaceConfig.hh"
 #include "game/system/RootScene.hh"
 
+#include <sp/ScopeLock.hh>
 #include <sp/storage/DecompLoader.hh>
 
+extern "C" {
+#include <sp/Commands.h>
+}
+
 #include <cstdio>
 #include <cstring>
 
 namespace System {
 
+// Fits any vanilla course along with its _Dif archive.
+static const u32 COURSE_CACHE_SIZE = 0x700000;
+// Left for each archive's decoder and the heap's block headers, as allocations can't fail softly.
+static const u32 COURSE_CACHE_SLACK = 0x10000;
+
+struct PrefetchedArchive {
+    char path[64];
+    // Resolved on the main thread, as the prefetch thread must not read the path replacement.
+    char loadPath[64];
+    u8 *buffer;
+    size_t size;
+};
+
+// CourseCache has to keep its vanilla layout, so the prefetch state lives here.
+static u8 prefetchStack[0x4000 /* 16 KiB */];
+static OSThread prefetchThread;
+static bool prefetchThreadIsRunning = false;
+static volatile bool prefetchIsCancelled = false;
+static bool prefetchIsAcquired = false;
+static char prefetchPathReplacement[64];
+static PrefetchedArchive prefetchedArchives[2];
+static u32 prefetchHitCount = 0;
+static u32 prefetchMissCount = 0;
+static u32 prefetchCancelCount = 0;
+
 void ResourceManager::initGlobeHeap() {
     if (!m_globeHeap) {
         auto *heap = RootScene::Instance()->m_heapCollection.mem2;
@@ -56,10 +87,15 @@ u16 ResourceManager::getMenuArchiveCount() const {
 void ResourceManager::OnCreateScene(SceneId sceneId) {
     switch (sceneId) {
     case SceneId::Menu:
+        // The prediction was wrong if the race was quit.
+        s_instance->m_courseCache.clear();
+        s_instance->deinitGlobeHeap();
+        break;
     case SceneId::Race:
         s_instance->deinitGlobeHeap();
         break;
     case SceneId::Globe:
+        s_instance->m_courseCache.clear();
         s_instance->initGlobeHeap();
         break;
     default:
@@ -72,6 +108,7 @@ ResourceManager *ResourceManager::CreateInstance() {
     assert(s_instance);
 
     s_instance->m_globe = nullptr;
+    s_instance->m_courseCache.init();
 
     return s_instance;
 }
@@ -80,6 +117,10 @@ ResourceManager *ResourceManager::Instance() {
     return s_instance;
 }
 
+ResourceManager::CourseCache *ResourceManager::courseCache() {
+    return &m_courseCache;
+}
+
 const char *ResourceManager::GetCourseFilename(Registry::Course course) {
     u32 courseId = static_cast<u32>(course);
 
@@ -158,15 +199,203 @@ MultiDvdArchive *ResourceManager::loadCourse(Registry::Course courseId, EGG::Hea
         snprintf(filePath, filePathSize, "Race/Course/%s", courseFilename);
     }
 
+    const char *pathReplacement = RaceConfig::Instance()->m_spRace.pathReplacement.c_str();
+    m_courseCache.acquire(static_cast<u32>(courseId), pathReplacement, filePath);
+
     m_taskThread->request(DoLoadTask, (void *)2, 0);
     process();
 
+    m_courseCache.clear();
+
     assert(archive->isLoaded());
     return archive;
 }
 
-void ResourceManager::CourseCache::init() {}
+void ResourceManager::CourseCache::init() {
+    m_buffer = nullptr;
+    m_heap = nullptr;
+    m_course = 0;
+    m_state = State::Cleared;
+    m_archive = nullptr;
+}
+
+void ResourceManager::CourseCache::load(u32 /* courseId */) {
+    // The vanilla callers, such as RoulettePage, don't know the path replacement of the course, so
+    // their prefetch would mostly be cancelled after competing with the loads of the menus.
+}
+
+void ResourceManager::CourseCache::load(u32 courseId, const char *pathReplacement) {
+    if (m_state != State::Cleared && m_course == courseId &&
+            !strcmp(prefetchPathReplacement, pathReplacement)) {
+        return;
+    }
+
+    if (m_state != State::Cleared) {
+        prefetchCancelCount++;
+    }
+    clear();
+
+    assert(courseId < std::size(CourseFilenames));
+    auto *heap = RootScene::Instance()->m_heapCollection.mem2;
+    u8 *buffer = new (heap, -0x20) u8[COURSE_CACHE_SIZE];
+    m_heap = EGG::ExpHeap::Create(buffer, COURSE_CACHE_SIZE, 1);
+    if (!m_heap) {
+        delete[] buffer;
+        return;
+    }
+    m_buffer = buffer;
+
+    auto *courseFilename = CourseFilenames[courseId];
+    snprintf(prefetchPathReplacement, sizeof(prefetchPathReplacement), "%s", pathReplacement);
+    snprintf(prefetchedArchives[0].path, sizeof(prefetchedArchives[0].path), "Race/Course/%s.szs",
+            courseFilename);
+    snprintf(prefetchedArchives[1].path, sizeof(prefetchedArchives[1].path),
+            "Race/Course/%s_Dif.szs", courseFilename);
+    for (u32 i = 0; i < std::size(prefetchedArchives); i++) {
+        auto &archive = prefetchedArchives[i];
+        if (i == 0 && pathReplacement[0] != '\0') {
+            snprintf(archive.loadPath, sizeof(archive.loadPath), "%s", pathReplacement);
+        } else {
+            snprintf(archive.loadPath, sizeof(archive.loadPath), "ro:/%s", archive.path);
+        }
+        archive.buffer = nullptr;
+        archive.size = 0;
+    }
+
+    m_course = courseId;
+    m_state = State::Loading;
+    prefetchIsCancelled = false;
+    u8 *stackTop = prefetchStack + sizeof(prefetchStack);
+    u32 stackSize = sizeof(prefetchStack);
+    OSCreateThread(&prefetchThread, PrefetchTask, this, stackTop, stackSize, 31, 0);
+    SP::Storage::SetIOPriority(&prefetchThread, SP::Storage::IOPriority::Background);
+    OSResumeThread(&prefetchThread);
+    prefetchThreadIsRunning = true;
+}
+
+void ResourceManager::CourseCache::clear() {
+    if (prefetchThreadIsRunning) {
+        prefetchIsCancelled = true;
+        SP::Storage::DecompLoader::Abort(&prefetchThread);
+        OSJoinThread(&prefetchThread, nullptr);
+        SP::Storage::DecompLoader::Abort(nullptr);
+        prefetchThreadIsRunning = false;
+    }
+
+    if (m_heap) {
+        m_heap->destroy();
+        m_heap = nullptr;
+        m_buffer = nullptr;
+    }
+
+    for (auto &archive : prefetchedArchives) {
+        archive.buffer = nullptr;
+    }
+    prefetchIsAcquired = false;
+    m_state = State::Cleared;
+}
+
+bool ResourceManager::CourseCache::take(const char *path, EGG::Heap *heap, u8 **dst,
+        size_t *dstSize) {
+    if (!prefetchIsAcquired) {
+        return false;
+    }
+
+    for (u32 i = 0; i < std::size(prefetchedArchives); i++) {
+        auto &archive = prefetchedArchives[i];
+        if (!archive.buffer || strcmp(archive.path, path)) {
+            continue;
+        }
+
+        u8 *buffer = new (heap, 0x20) u8[archive.size];
+        memcpy(buffer, archive.buffer, archive.size);
+        *dst = buffer;
+        *dstSize = archive.size;
+
+        // DecompLoader would have consumed the replacement when loading the course itself.
+        if (i == 0 && prefetchPathReplacement[0] != '\0') {
+            RaceConfig::Instance()->m_spRace.pathReplacement = "";
+        }
+        return true;
+    }
+
+    return false;
+}
+
+bool ResourceManager::CourseCache::acquire(u32 courseId, const char *pathReplacement,
+        const char *filePath) {
+    if (m_state == State::Cleared) {
+        prefetchMissCount++;
+        return false;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%s.szs", filePath);
+    if (m_course != courseId || strcmp(prefetchPathReplacement, pathReplacement) ||
+            strcmp(prefetchedArchives[0].path, path)) {
+        SP_LOG("Prefetched course %u, but %s is being loaded", m_course, path);
+        prefetchCancelCount++;
+        clear();
+        return false;
+    }
 
-void ResourceManager::CourseCache::load(u32 /* courseId */) {}
+    OSTime startTime = OSGetTime();
+    OSJoinThread(&prefetchThread, nullptr);
+    prefetchThreadIsRunning = false;
+    if (!prefetchedArchives[0].buffer) {
+        prefetchMissCount++;
+        clear();
+        return false;
+    }
+
+    SP_LOG("Using the prefetched course %u after waiting %u ms", m_course,
+            static_cast<u32>(OSTicksToMilliseconds(OSGetTime() - startTime)));
+    prefetchHitCount++;
+    prefetchIsAcquired = true;
+    return true;
+}
+
+void ResourceManager::CourseCache::prefetch() {
+    OSTime startTime = OSGetTime();
+    // Running out of room would panic, so archives which may not fit are left to loadCourse.
+    size_t freeSize = COURSE_CACHE_SIZE;
+    for (u32 i = 0; i < std::size(prefetchedArchives) && !prefetchIsCancelled; i++) {
+        auto &archive = prefetchedArchives[i];
+        if (freeSize < COURSE_CACHE_SLACK) {
+            break;
+        }
+        size_t maxSize = freeSize - COURSE_CACHE_SLACK;
+        u8 *buffer;
+        size_t size;
+        if (SP::Storage::DecompLoader::LoadExact(archive.loadPath, &buffer, &size, m_heap,
+                    maxSize)) {
+            archive.buffer = buffer;
+            archive.size = size;
+            freeSize = maxSize - size;
+        } else if (i == 0) {
+            SP_LOG("Could not prefetch course %u, or it may not fit", m_course);
+            break;
+        }
+    }
+
+    if (!prefetchIsCancelled) {
+        SP_LOG("Prefetched course %u in %u ms", m_course,
+                static_cast<u32>(OSTicksToMilliseconds(OSGetTime() - startTime)));
+    }
+
+    SP::ScopeLock<SP::NoInterrupts> lock;
+    m_state = State::Loaded;
+}
+
+void *ResourceManager::CourseCache::PrefetchTask(void *arg) {
+    reinterpret_cast<CourseCache *>(arg)->prefetch();
+    return nullptr;
+}
+
+sp_define_command("/course_cache_stats", "Show how often prefetched courses were used",
+        const char *) {
+    OSReport("course_cache_stats: %u hits, %u misses, %u cancelled\n", prefetchHitCount,
+            prefetchMissCount, prefetchCancelCount);
+}
 
 } // namespace System
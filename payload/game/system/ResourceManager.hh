@@ -24,13 +24,29 @@ public:
     public:
         enum class State {
             Cleared = 0,
+            Loading = 1,
             Loaded = 2,
         };
 
         REPLACE void init();
+        // Does nothing, as the vanilla callers don't know the path replacement.
         REPLACE void load(u32 courseId);
+        // Reads and decodes the course archives into a heap of their own on a low priority thread,
+        // for the next loadCourse to pick up. A prefetch of another course is cancelled.
+        void load(u32 courseId, const char *pathReplacement);
+        // Drops the prefetched archives, cancelling the prefetch if it is still in progress.
+        void clear();
+
+        // Copies the prefetched archive at path into heap, once loadCourse has accepted it.
+        bool take(const char *path, EGG::Heap *heap, u8 **dst, size_t *dstSize);
 
     private:
+        // Waits for the prefetch if it matches the course about to be loaded from filePath.
+        bool acquire(u32 courseId, const char *pathReplacement, const char *filePath);
+        void prefetch();
+
+        static void *PrefetchTask(void *arg);
+
         u8 _00[0x10 - 0x00];
         void *m_buffer;
         EGG::ExpHeap *m_heap;
@@ -56,6 +72,7 @@ public:
             bool splitScreen);
 
     void *getFile(ResourceType i, const char *name, size_t *size);
+    CourseCache *courseCache();
 
     static void OnCreateScene(SceneId sceneId);
     static REPLACE ResourceManager *CreateInstance();
@@ -6,13 +6,49 @@
 #include "game/ui/SectionManager.hh"
 
 #include <common/Bytes.hh>
+#include <egg/core/eggExpHeap.hh>
+#include <sp/ScopeLock.hh>
 #include <sp/storage/DecompLoader.hh>
 
+#include <algorithm>
 #include <bit>
 #include <cstring>
 
+#define COURSE_SHA1_CACHE_PATH L"/mkw-spc/course-sha1s.bin"
+#define GHOST_INDEX_PATH L"/mkw-spc/ghost-index.bin"
+
 namespace System {
 
+static const u32 COURSE_SHA1_CACHE_MAGIC = 0x53504348; // SPCH
+static const u32 COURSE_SHA1_CACHE_HEADER_SIZE = 0x8;
+static const u32 COURSE_SHA1_CACHE_ENTRY_SIZE = 0x28;
+// Holds one decoded course along with the state of its decoder, like the course cache.
+static const u32 COURSE_SHA1_HEAP_SIZE = 0x800000;
+static const u32 COURSE_SHA1_HEAP_SLACK = 0x100000;
+static const u32 GHOST_INDEX_MAGIC = 0x53504749; // SPGI
+static const u32 GHOST_INDEX_VERSION = 1;
+static const u32 GHOST_INDEX_HEADER_SIZE = 0x10;
+static const u32 GHOST_INDEX_ENTRY_SIZE = 0x30 + sizeof(RawGhostHeader);
+// Leaves some room for files which aren't valid ghosts, so that they aren't parsed again either.
+static const u32 GHOST_INDEX_MAX_ENTRY_COUNT = MAX_GHOST_COUNT + 256;
+static const u32 GHOST_INDEX_MAX_SIZE =
+        GHOST_INDEX_HEADER_SIZE + GHOST_INDEX_MAX_ENTRY_COUNT * GHOST_INDEX_ENTRY_SIZE;
+
+enum GhostIndexFlags {
+    GHOST_INDEX_IS_GHOST = 1 << 0,
+    GHOST_INDEX_HAS_FOOTER = 1 << 1,
+    GHOST_INDEX_HAS_SPEED_MOD = 1 << 2,
+};
+
+// FNV-1a, continued with a separator and name for each directory level.
+static u32 HashGhostPath(u32 hash, const wchar_t *name) {
+    hash = (hash ^ '/') * 0x01000193;
+    for (; *name; name++) {
+        hash = (hash ^ static_cast<u32>(*name)) * 0x01000193;
+    }
+    return hash;
+}
+
 void SaveManager::RawLicense::reset() {
     *this = {};
     unlockFlags[0] = 0xffffffff;
@@ -37,6 +73,13 @@ SaveManager *SaveManager::CreateInstance() {
     s_instance->m_rawGhostHeaders = new (heap, 0x4) RawGhostHeader[MAX_GHOST_COUNT];
     s_instance->m_ghostFooters = new (heap, 0x4) GhostFooter[MAX_GHOST_COUNT];
     s_instance->m_ghostIds = new (heap, 0x4) SP::Storage::NodeId[MAX_GHOST_COUNT];
+    // The ghost index is too large for MEM1, and allocating it on the ghost init thread would
+    // compete with the menus for RootScene's heap.
+    auto *mem2 = RootScene::Instance()->m_heapCollection.mem2;
+    s_instance->m_ghostIndex = new (mem2, 0x20) u8[GHOST_INDEX_MAX_SIZE];
+    s_instance->m_ghostIndexEntryCount = 0;
+    s_instance->m_ghostIndexKeys = new (mem2, 0x8) GhostIndexKey[GHOST_INDEX_MAX_ENTRY_COUNT];
+    s_instance->m_isIndexingGhosts = false;
 
     s_instance->m_spCanSave = true;
     s_instance->m_spLicenseCount = 0;
@@ -46,6 +89,9 @@ SaveManager *SaveManager::CreateInstance() {
     }
     s_instance->m_spCurrentLicense = {};
 
+    s_instance->m_courseSHA1sReady = false;
+    OSInitThreadQueue(&s_instance->m_courseSHA1Queue);
+
     return s_instance;
 }
 
@@ -65,10 +111,18 @@ void SaveManager::init() {
 
     m_otherRawSave = m_rawSave;
 
+    OSTime startTime = OSGetTime();
     initSPSave();
+    OSTime spSaveTime = OSGetTime();
     initCourseSHA1s();
+    OSTime courseSHA1sTime = OSGetTime();
     initGhostsAsync();
 
+    SP_LOG("Save init: SP save %u ms, course hashes %u ms (%u to hash in the background)",
+            static_cast<u32>(OSTicksToMilliseconds(spSaveTime - startTime)),
+            static_cast<u32>(OSTicksToMilliseconds(courseSHA1sTime - spSaveTime)),
+            std::popcount(m_staleCourseSHA1s));
+
     m_isBusy = false;
 }
 
@@ -96,26 +150,126 @@ void SaveManager::initSPSave() {
     }
 }
 
+// Hashing a course means decompressing it, so the hashes of courses on the SD card or USB device
+// are cached along with the file path, size and modification time, and only recomputed when those
+// change.
 void SaveManager::initCourseSHA1s() {
+    auto size = SP::Storage::ReadFile(COURSE_SHA1_CACHE_PATH, m_courseSHA1Cache,
+            sizeof(m_courseSHA1Cache));
+    bool cacheIsValid = size == sizeof(m_courseSHA1Cache) &&
+            Bytes::Read<u32>(m_courseSHA1Cache, 0x0) == COURSE_SHA1_CACHE_MAGIC &&
+            Bytes::Read<u32>(m_courseSHA1Cache, 0x4) == m_courseSHA1s.size();
+    bool cacheIsDirty = !cacheIsValid;
+    if (!cacheIsValid) {
+        memset(m_courseSHA1Cache, 0, sizeof(m_courseSHA1Cache));
+        Bytes::Write<u32>(m_courseSHA1Cache, 0x0, COURSE_SHA1_CACHE_MAGIC);
+        Bytes::Write<u32>(m_courseSHA1Cache, 0x4, m_courseSHA1s.size());
+    }
+
+    m_staleCourseSHA1s = 0;
     for (u8 courseId = 0; courseId < m_courseSHA1s.size(); courseId++) {
+        u8 *entry = m_courseSHA1Cache + COURSE_SHA1_CACHE_HEADER_SIZE +
+                courseId * COURSE_SHA1_CACHE_ENTRY_SIZE;
         char path[128];
         snprintf(path, sizeof(path), "Race/Course/%s.szs",
                 ResourceManager::CourseFilenames[courseId]);
-        u8 *buffer;
-        size_t size;
-        auto *heap = RootScene::Instance()->m_heapCollection.mem2;
-        if (!SP::Storage::DecompLoader::LoadRO(path, &buffer, &size, heap,
-                    SP::Storage::StorageType::FAT)) {
+        // Stat the file that hashCourses will actually load, which may be a .arc.lzma or a .wbz.
+        wchar_t filePath[128];
+        auto nodeInfo = SP::Storage::DecompLoader::StatRO(path, SP::Storage::StorageType::FAT,
+                filePath);
+        if (!nodeInfo) {
             m_courseSHA1s[courseId] = s_courseSHA1s[courseId];
+            if (Bytes::Read<u64>(entry, 0x0) != 0 || Bytes::Read<u64>(entry, 0x8) != 0) {
+                memset(entry, 0, COURSE_SHA1_CACHE_ENTRY_SIZE);
+                cacheIsDirty = true;
+            }
             continue;
         }
 
-        SP_LOG("Hashing course %s", path);
+        u32 pathCRC32 = NETCalcCRC32(filePath, wcslen(filePath) * sizeof(wchar_t));
+        if (Bytes::Read<u64>(entry, 0x0) == nodeInfo->size &&
+                Bytes::Read<u64>(entry, 0x8) == static_cast<u64>(nodeInfo->tick) &&
+                Bytes::Read<u32>(entry, 0x24) == pathCRC32) {
+            memcpy(m_courseSHA1s[courseId].data(), entry + 0x10, m_courseSHA1s[courseId].size());
+            continue;
+        }
+
+        Bytes::Write<u64>(entry, 0x0, nodeInfo->size);
+        Bytes::Write<u64>(entry, 0x8, nodeInfo->tick);
+        Bytes::Write<u32>(entry, 0x24, pathCRC32);
+        m_staleCourseSHA1s |= 1 << courseId;
+    }
+
+    if (m_staleCourseSHA1s == 0) {
+        if (cacheIsDirty) {
+            SP::Storage::WriteFile(COURSE_SHA1_CACHE_PATH, m_courseSHA1Cache,
+                    sizeof(m_courseSHA1Cache), true);
+        }
+        m_courseSHA1sReady = true;
+        return;
+    }
+
+    // The hashing thread decodes into a heap of its own, so that it doesn't compete with the menus
+    // for RootScene's heap.
+    auto *heap = RootScene::Instance()->m_heapCollection.mem2;
+    void *buffer = new (heap, -0x20) u8[COURSE_SHA1_HEAP_SIZE];
+    auto *courseSHA1Heap = EGG::ExpHeap::Create(buffer, COURSE_SHA1_HEAP_SIZE, 1);
+
+    u8 *stackTop = m_courseSHA1Stack + sizeof(m_courseSHA1Stack);
+    u32 stackSize = sizeof(m_courseSHA1Stack);
+    OSCreateThread(&m_courseSHA1Thread, HashCoursesTask, courseSHA1Heap, stackTop, stackSize, 31,
+            0);
+    SP::Storage::SetIOPriority(&m_courseSHA1Thread, SP::Storage::IOPriority::Background);
+    OSResumeThread(&m_courseSHA1Thread);
+}
+
+void SaveManager::hashCourses(EGG::Heap *heap) {
+    OSTime startTime = OSGetTime();
+    for (u8 courseId = 0; courseId < m_courseSHA1s.size(); courseId++) {
+        if (!(m_staleCourseSHA1s & 1 << courseId)) {
+            continue;
+        }
+
+        u8 *entry = m_courseSHA1Cache + COURSE_SHA1_CACHE_HEADER_SIZE +
+                courseId * COURSE_SHA1_CACHE_ENTRY_SIZE;
+        char path[128];
+        snprintf(path, sizeof(path), "ro:/Race/Course/%s.szs",
+                ResourceManager::CourseFilenames[courseId]);
+        u8 *buffer;
+        size_t size;
         NETSHA1Context context;
         NETSHA1Init(&context);
-        NETSHA1Update(&context, buffer, size);
+        SP_LOG("Hashing course %s", path);
+        if (!SP::Storage::DecompLoader::LoadBounded(path, &buffer, &size, heap,
+                    COURSE_SHA1_HEAP_SIZE - COURSE_SHA1_HEAP_SLACK,
+                    SP::Storage::StorageType::FAT, &context)) {
+            m_courseSHA1s[courseId] = s_courseSHA1s[courseId];
+            memset(entry, 0, COURSE_SHA1_CACHE_ENTRY_SIZE);
+            continue;
+        }
+
         NETSHA1GetDigest(&context, m_courseSHA1s[courseId].data());
         delete[] buffer;
+        memcpy(entry + 0x10, m_courseSHA1s[courseId].data(), m_courseSHA1s[courseId].size());
+    }
+
+    if (!SP::Storage::WriteFile(COURSE_SHA1_CACHE_PATH, m_courseSHA1Cache,
+                sizeof(m_courseSHA1Cache), true)) {
+        SP_LOG("Failed to write the course hash cache");
+    }
+
+    SP_LOG("Hashed %u courses in the background in %u ms", std::popcount(m_staleCourseSHA1s),
+            static_cast<u32>(OSTicksToMilliseconds(OSGetTime() - startTime)));
+
+    SP::ScopeLock<SP::NoInterrupts> lock;
+    m_courseSHA1sReady = true;
+    OSWakeupThread(&m_courseSHA1Queue);
+}
+
+void SaveManager::waitForCourseSHA1s() const {
+    SP::ScopeLock<SP::NoInterrupts> lock;
+    while (!m_courseSHA1sReady) {
+        OSSleepThread(&m_courseSHA1Queue);
     }
 }
 
@@ -123,9 +277,18 @@ void SaveManager::initGhostsAsync() {
     u8 *stackTop = m_ghostInitStack + sizeof(m_ghostInitStack);
     u32 stackSize = sizeof(m_ghostInitStack);
     OSCreateThread(&m_ghostInitThread, InitGhostsTask, nullptr, stackTop, stackSize, 31, 0);
+    SP::Storage::SetIOPriority(&m_ghostInitThread, SP::Storage::IOPriority::Background);
     OSResumeThread(&m_ghostInitThread);
 }
 
+void *SaveManager::HashCoursesTask(void *arg) {
+    assert(s_instance);
+    auto *heap = reinterpret_cast<EGG::ExpHeap *>(arg);
+    s_instance->hashCourses(heap);
+    heap->destroy();
+    return nullptr;
+}
+
 void *SaveManager::InitGhostsTask(void * /* arg */) {
     assert(s_instance);
     s_instance->initGhosts();
@@ -135,13 +298,21 @@ void *SaveManager::InitGhostsTask(void * /* arg */) {
 void SaveManager::initGhosts() {
     SP_LOG("Initializing ghosts...");
 
+    OSTime startTime = OSGetTime();
+    loadGhostIndex();
+
     initGhosts(L"/mkw-spc/ghosts");
     initGhosts(L"/mkw-sp/ghosts");
     initGhosts(L"/ctgpr/ghosts");
 
     SP::Storage::CreateDir(L"/mkw-spc/ghosts", true);
 
+    saveGhostIndex();
+
     SP_LOG("Ghosts: %u / %u", m_ghostCount, MAX_GHOST_COUNT);
+    SP_LOG("Ghost init: %u ms, %u files read, %u files from the index",
+            static_cast<u32>(OSTicksToMilliseconds(OSGetTime() - startTime)), m_parsedGhostCount,
+            m_indexedGhostCount);
 }
 
 void SaveManager::initGhosts(const wchar_t *path) {
@@ -152,10 +323,10 @@ void SaveManager::initGhosts(const wchar_t *path) {
     if (info->type != SP::Storage::NodeType::Dir) {
         return;
     }
-    initGhosts(info->id);
+    initGhosts(info->id, HashGhostPath(0x811c9dc5, path));
 }
 
-void SaveManager::initGhosts(SP::Storage::NodeId id) {
+void SaveManager::initGhosts(SP::Storage::NodeId id, u32 pathHash) {
     if (m_ghostCount >= MAX_GHOST_COUNT) {
         return;
     }
@@ -165,36 +336,200 @@ void SaveManager::initGhosts(SP::Storage::NodeId id) {
         return;
     }
 
-    while (auto info = dir->read()) {
-        if (info->type == SP::Storage::NodeType::Dir) {
-            initGhosts(info->id);
-        } else {
-            initGhost(info->id);
+    // Every level of the recursion shares the same entries, so the subdirectories are only visited
+    // once the rest of the batch has been handled.
+    static SP::Storage::NodeInfo infos[16];
+    while (u32 count = dir->readBatch(infos, std::size(infos))) {
+        SP::Storage::NodeId dirIds[std::size(infos)];
+        u32 dirPathHashes[std::size(infos)];
+        u32 dirCount = 0;
+        for (u32 i = 0; i < count; i++) {
+            if (infos[i].type == SP::Storage::NodeType::Dir) {
+                dirIds[dirCount] = infos[i].id;
+                dirPathHashes[dirCount] = HashGhostPath(pathHash, infos[i].name);
+                dirCount++;
+            } else {
+                initGhost(infos[i], HashGhostPath(pathHash, infos[i].name));
+            }
+        }
+
+        for (u32 i = 0; i < dirCount; i++) {
+            initGhosts(dirIds[i], dirPathHashes[i]);
+        }
+
+        if (count < std::size(infos)) {
+            break;
         }
     }
 }
 
-void SaveManager::initGhost(SP::Storage::NodeId id) {
+void SaveManager::initGhost(const SP::Storage::NodeInfo &info, u32 pathHash) {
     if (m_ghostCount >= MAX_GHOST_COUNT) {
         return;
     }
 
-    auto readSize = SP::Storage::FastReadFile(id, m_rawGhostFile, 0x2800);
+    if (const u8 *entry = findGhostIndexEntry(pathHash, info.size, info.tick)) {
+        m_indexedGhostCount++;
+        u32 flags = Bytes::Read<u32>(entry, 0x04);
+        if (!(flags & GHOST_INDEX_IS_GHOST)) {
+            addGhostIndexKey(pathHash, info, -1);
+            return;
+        }
+
+        addGhostIndexKey(pathHash, info, m_ghostCount);
+        memcpy(&m_rawGhostHeaders[m_ghostCount], entry + 0x30, sizeof(RawGhostHeader));
+        if (flags & GHOST_INDEX_HAS_FOOTER) {
+            Sha1 courseSHA1;
+            memcpy(courseSHA1.data(), entry + 0x18, courseSHA1.size());
+            bool hasSpeedMod = flags & GHOST_INDEX_HAS_SPEED_MOD;
+            m_ghostFooters[m_ghostCount] = GhostFooter(courseSHA1, hasSpeedMod);
+        } else {
+            m_ghostFooters[m_ghostCount] = GhostFooter();
+        }
+        m_ghostIds[m_ghostCount] = info.id;
+        m_ghostCount++;
+        return;
+    }
+
+    m_parsedGhostCount++;
+    auto readSize = SP::Storage::FastReadFile(info.id, m_rawGhostFile, 0x2800);
     if (!readSize) {
         return;
     }
 
     if (!RawGhostFile::IsValid(m_rawGhostFile, *readSize)) {
+        addGhostIndexKey(pathHash, info, -1);
         return;
     }
 
+    addGhostIndexKey(pathHash, info, m_ghostCount);
     auto *header = reinterpret_cast<const RawGhostHeader *>(m_rawGhostFile);
     memcpy(&m_rawGhostHeaders[m_ghostCount], header, sizeof(RawGhostHeader));
     m_ghostFooters[m_ghostCount] = GhostFooter(m_rawGhostFile, *readSize);
-    m_ghostIds[m_ghostCount] = id;
+    m_ghostIds[m_ghostCount] = info.id;
     m_ghostCount++;
 }
 
+// Validating a ghost means reading and checksumming it, so the headers and footers of the ghosts
+// are indexed by path hash, size and modification time, and only files which don't match an entry
+// are read. A missing or invalid index simply makes every file miss.
+void SaveManager::loadGhostIndex() {
+    m_ghostIndexEntryCount = 0;
+    m_ghostIndexKeyCount = 0;
+    m_indexedGhostCount = 0;
+    m_parsedGhostCount = 0;
+    m_isIndexingGhosts = true;
+
+    auto size = SP::Storage::ReadFile(GHOST_INDEX_PATH, m_ghostIndex, GHOST_INDEX_MAX_SIZE);
+    if (!size || *size < GHOST_INDEX_HEADER_SIZE ||
+            Bytes::Read<u32>(m_ghostIndex, 0x0) != GHOST_INDEX_MAGIC ||
+            Bytes::Read<u32>(m_ghostIndex, 0x4) != GHOST_INDEX_VERSION) {
+        return;
+    }
+
+    u32 entryCount = Bytes::Read<u32>(m_ghostIndex, 0x8);
+    if (entryCount > GHOST_INDEX_MAX_ENTRY_COUNT ||
+            *size != GHOST_INDEX_HEADER_SIZE + entryCount * GHOST_INDEX_ENTRY_SIZE) {
+        return;
+    }
+
+    m_ghostIndexEntryCount = entryCount;
+}
+
+const u8 *SaveManager::findGhostIndexEntry(u32 pathHash, u64 size, OSTime tick) const {
+    // Without a modification time, a changed file can't be told apart from the indexed one.
+    if (tick == 0) {
+        return nullptr;
+    }
+
+    auto entry = [&](u32 i) {
+        return m_ghostIndex + GHOST_INDEX_HEADER_SIZE + i * GHOST_INDEX_ENTRY_SIZE;
+    };
+
+    u32 low = 0;
+    u32 high = m_ghostIndexEntryCount;
+    while (low < high) {
+        u32 mid = low + (high - low) / 2;
+        if (Bytes::Read<u32>(entry(mid), 0x00) < pathHash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    for (u32 i = low; i < m_ghostIndexEntryCount; i++) {
+        if (Bytes::Read<u32>(entry(i), 0x00) != pathHash) {
+            break;
+        }
+        if (Bytes::Read<u64>(entry(i), 0x08) == size &&
+                Bytes::Read<u64>(entry(i), 0x10) == static_cast<u64>(tick)) {
+            return entry(i);
+        }
+    }
+
+    return nullptr;
+}
+
+void SaveManager::addGhostIndexKey(u32 pathHash, const SP::Storage::NodeInfo &info,
+        s32 ghostIndex) {
+    if (!m_isIndexingGhosts || info.tick == 0 ||
+            m_ghostIndexKeyCount == GHOST_INDEX_MAX_ENTRY_COUNT) {
+        return;
+    }
+
+    m_ghostIndexKeys[m_ghostIndexKeyCount++] = GhostIndexKey{
+            .pathHash = pathHash,
+            .ghostIndex = ghostIndex,
+            .size = info.size,
+            .tick = info.tick,
+    };
+}
+
+void SaveManager::saveGhostIndex() {
+    // Every key was either found in the index or parsed, so nothing changed if there was no parsed
+    // file to add and no indexed file went missing.
+    bool isDirty = m_ghostIndexKeyCount != m_indexedGhostCount ||
+            m_indexedGhostCount != m_ghostIndexEntryCount;
+    if (isDirty) {
+        std::sort(m_ghostIndexKeys, m_ghostIndexKeys + m_ghostIndexKeyCount,
+                [](const auto &a, const auto &b) { return a.pathHash < b.pathHash; });
+
+        for (u32 i = 0; i < m_ghostIndexKeyCount; i++) {
+            const GhostIndexKey &key = m_ghostIndexKeys[i];
+            u8 *entry = m_ghostIndex + GHOST_INDEX_HEADER_SIZE + i * GHOST_INDEX_ENTRY_SIZE;
+            memset(entry, 0, GHOST_INDEX_ENTRY_SIZE);
+            Bytes::Write<u32>(entry, 0x00, key.pathHash);
+            Bytes::Write<u64>(entry, 0x08, key.size);
+            Bytes::Write<u64>(entry, 0x10, key.tick);
+            if (key.ghostIndex < 0) {
+                continue;
+            }
+
+            u32 flags = GHOST_INDEX_IS_GHOST;
+            const GhostFooter &footer = m_ghostFooters[key.ghostIndex];
+            if (auto courseSHA1 = footer.courseSHA1()) {
+                flags |= GHOST_INDEX_HAS_FOOTER;
+                flags |= footer.hasSpeedMod().value_or(false) ? GHOST_INDEX_HAS_SPEED_MOD : 0;
+                memcpy(entry + 0x18, courseSHA1->data(), courseSHA1->size());
+            }
+            Bytes::Write<u32>(entry, 0x04, flags);
+            memcpy(entry + 0x30, &m_rawGhostHeaders[key.ghostIndex], sizeof(RawGhostHeader));
+        }
+
+        Bytes::Write<u32>(m_ghostIndex, 0x0, GHOST_INDEX_MAGIC);
+        Bytes::Write<u32>(m_ghostIndex, 0x4, GHOST_INDEX_VERSION);
+        Bytes::Write<u32>(m_ghostIndex, 0x8, m_ghostIndexKeyCount);
+        Bytes::Write<u32>(m_ghostIndex, 0xc, 0);
+        u32 size = GHOST_INDEX_HEADER_SIZE + m_ghostIndexKeyCount * GHOST_INDEX_ENTRY_SIZE;
+        if (!SP::Storage::WriteFile(GHOST_INDEX_PATH, m_ghostIndex, size, true)) {
+            SP_LOG("Failed to write the ghost index");
+        }
+    }
+
+    m_isIndexingGhosts = false;
+    m_ghostIndexEntryCount = 0;
+}
+
 void SaveManager::resetAsync() {
     m_isValid = true;
     m_canSave = false;
@@ -510,7 +845,7 @@ void SaveManager::saveGhost(GhostFile *file) {
     if (raceScenario.courseSha.has_value()) {
         courseSha1 = *raceScenario.courseSha;
     } else {
-        courseSha1 = m_courseSHA1s[file->courseId()];
+        courseSha1 = courseSHA1(static_cast<Registry::Course>(file->courseId()));
     }
 
     SPFooter::OnRaceEnd(courseSha1);
@@ -564,7 +899,7 @@ void SaveManager::saveGhost(GhostFile *file) {
 
     auto info = SP::Storage::Stat(path);
     if (info && info->type == SP::Storage::NodeType::File) {
-        initGhost(info->id);
+        initGhost(*info, HashGhostPath(0x811c9dc5, path));
     }
 }
 
@@ -580,6 +915,7 @@ void SaveManager::GetCourseName(Sha1 courseSHA1, char (&courseName)[0x14 * 2 + 1
 }
 
 Sha1 SaveManager::courseSHA1(Registry::Course courseId) const {
+    waitForCourseSHA1s();
     return m_courseSHA1s[static_cast<u32>(courseId)];
 }
 
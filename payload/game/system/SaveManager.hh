@@ -4,6 +4,7 @@
 #include "game/system/Mii.hh"
 #include "game/system/NandHelper.hh"
 
+#include <egg/core/eggHeap.hh>
 #include <egg/core/eggTaskThread.hh>
 #include <sp/settings/ClientSettings.hh>
 #include <sp/storage/Storage.hh>
@@ -122,14 +123,27 @@ public:
     static SaveManager *Instance();
 
 private:
+    struct GhostIndexKey {
+        u32 pathHash;
+        s32 ghostIndex; // -1 for files which aren't valid ghosts
+        u64 size;
+        OSTime tick;
+    };
+
     void init();
     void initSPSave();
     void initCourseSHA1s();
+    void hashCourses(EGG::Heap *heap);
+    void waitForCourseSHA1s() const;
     void initGhostsAsync();
     void initGhosts();
     void initGhosts(const wchar_t *path);
-    void initGhosts(SP::Storage::NodeId id);
-    void initGhost(SP::Storage::NodeId id);
+    void initGhosts(SP::Storage::NodeId id, u32 pathHash);
+    void initGhost(const SP::Storage::NodeInfo &info, u32 pathHash);
+    void loadGhostIndex();
+    const u8 *findGhostIndexEntry(u32 pathHash, u64 size, OSTime tick) const;
+    void addGhostIndexKey(u32 pathHash, const SP::Storage::NodeInfo &info, s32 ghostIndex);
+    void saveGhostIndex();
 
     void saveSPSave();
     void refreshGCPadRumble();
@@ -142,6 +156,7 @@ private:
 
     static void InitTask(void *arg);
     static void *InitGhostsTask(void *arg);
+    static void *HashCoursesTask(void *arg);
 
     static void SaveSPSaveTask(void *arg);
 
@@ -177,6 +192,19 @@ private:
     u8 m_ghostInitStack[0x8000 /* 32 KiB */];           // Added
     OSThread m_ghostInitThread;                         // Added
     std::array<std::array<u8, 0x14>, 32> m_courseSHA1s; // Added
+    u8 m_courseSHA1Cache[0x8 + 32 * 0x28];              // Added
+    u32 m_staleCourseSHA1s;                             // Added
+    bool m_courseSHA1sReady;                            // Added
+    mutable OSThreadQueue m_courseSHA1Queue;            // Added
+    u8 m_courseSHA1Stack[0x4000 /* 16 KiB */];          // Added
+    OSThread m_courseSHA1Thread;                        // Added
+    u8 *m_ghostIndex;                                   // Added
+    u32 m_ghostIndexEntryCount;                         // Added
+    GhostIndexKey *m_ghostIndexKeys;                    // Added
+    u32 m_ghostIndexKeyCount;                           // Added
+    u32 m_indexedGhostCount;                            // Added
+    u32 m_parsedGhostCount;                             // Added
+    bool m_isIndexingGhosts;                            // Added
 
     static SaveManager *s_instance;
     static const std::array<Sha1, 42> s_courseSHA1s;
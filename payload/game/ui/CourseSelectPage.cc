@@ -107,6 +107,7 @@ void CourseSelectPage::onInit() {
     OSInitThreadQueue(&m_queue);
     u8 *stackTop = m_stack + sizeof(m_stack);
     OSCreateThread(&m_thread, LoadThumbnails, this, stackTop, sizeof(m_stack), 24, 0);
+    SP::Storage::SetIOPriority(&m_thread, SP::Storage::IOPriority::UI);
     OSResumeThread(&m_thread);
 
     auto sectionId = SectionManager::Instance()->currentSection()->id();
@@ -135,6 +136,8 @@ void CourseSelectPage::onDeinit() {
     OSWakeupThread(&m_queue);
     OSJoinThread(&m_thread, nullptr);
     OSDetachThread(&m_thread);
+    // The page may be freed with the thread, so don't leave its address in the priority table.
+    SP::Storage::SetIOPriority(&m_thread, SP::Storage::IOPriority::Course);
 
     SP::TrackPackManager::DestroyInstance();
 }
@@ -168,8 +168,14 @@ void RoulettePage::initSelectingStage(u32 selectedPlayer) {
     m_timeTotal = 0.0;
     m_hoverPlayerIdx = 0;
     m_selectedPlayer = selectedPlayer;
-    System::RaceConfig::Instance()->menuScenario().courseId =
-            votingBackPage->getCourseVote(selectedPlayer);
+    auto *raceConfig = System::RaceConfig::Instance();
+    raceConfig->menuScenario().courseId = votingBackPage->getCourseVote(selectedPlayer);
+
+    // The roulette takes a few seconds, which is enough to get a head start on the course. The
+    // race copies the menu scenario, so its path replacement is the one loadCourse will use.
+    auto courseId = static_cast<u32>(votingBackPage->getCourseVote(selectedPlayer));
+    System::ResourceManager::Instance()->courseCache()->load(courseId,
+            raceConfig->m_spMenu.pathReplacement.c_str());
 }
 
 bool RoulettePage::calcPlayer(u8 playerIdx) {
@@ -125,6 +125,11 @@ void StorageBenchmarkPage::transition(State state) {
     auto printMebibytes = [](u32 val, wchar_t(&mebibytes)[0x10]) {
         swprintf(mebibytes, std::size(mebibytes), L"%.2f", (f32)val / (1024 * 1024));
     };
+    // Aligned and unaligned reads share the column, there is no room for more strings.
+    auto printReadMebibytes = [](u32 val, u32 unalignedVal, wchar_t(&mebibytes)[0x10]) {
+        swprintf(mebibytes, std::size(mebibytes), L"%.2f/%.2f", (f32)val / (1024 * 1024),
+                (f32)unalignedVal / (1024 * 1024));
+    };
     switch (state) {
     case State::Prev:
         startReplace(Anim::Prev, 0.0f);
@@ -160,7 +165,8 @@ void StorageBenchmarkPage::transition(State state) {
         info.messageIds[0] = getStorageMessageId() + 1;
         for (u32 i = 0; i < 4; i++) {
             info.intVals[i] = m_throughputs->sizes[i] / 1024;
-            printMebibytes(m_throughputs->read[i], throughputs[2 * i + 0]);
+            printReadMebibytes(m_throughputs->read[i], m_throughputs->unalignedRead[i],
+                    throughputs[2 * i + 0]);
             printMebibytes(m_throughputs->write[i], throughputs[2 * i + 1]);
             info.strings[2 * i + 0] = throughputs[2 * i + 0];
             info.strings[2 * i + 1] = throughputs[2 * i + 1];
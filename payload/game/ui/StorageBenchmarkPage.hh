@@ -51,7 +51,7 @@ private:
     u8 m_stack[0x1000 /* 4 KiB */];
     OSThread m_thread;
     SP::Storage::StorageType m_type;
-    u8 m_buffer[SP::Storage::BENCHMARK_BUFFER_SIZE];
+    u8 m_buffer[SP::Storage::BENCHMARK_BUFFER_SIZE + SP::Storage::BENCHMARK_BUFFER_PADDING];
     std::optional<SP::Storage::Throughputs> m_throughputs;
 };
 
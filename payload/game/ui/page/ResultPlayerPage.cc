@@ -1,12 +1,26 @@
 #include "ResultPlayerPage.hh"
 
 #include "game/system/RaceConfig.hh"
+#include "game/system/ResourceManager.hh"
+#include "game/ui/SectionManager.hh"
 #include "game/ui/page/RaceMenuPage.hh"
 
 namespace UI {
 
 PageId ResultRaceUpdatePage::getReplacement() {
     const auto &raceScenario = System::RaceConfig::Instance()->raceScenario();
+
+    // Prefetch the next track of the playlist while the results and the menu are shown.
+    auto *globalContext = SectionManager::Instance()->globalContext();
+    if (!raceScenario.isOnline() && !RaceMenuPage::IsLastMatch()) {
+        if (auto *nextTrack = globalContext->getTrack(globalContext->m_match)) {
+            auto courseId = static_cast<u32>(nextTrack->m_courseId);
+            auto pathReplacement = nextTrack->pathReplacement();
+            System::ResourceManager::Instance()->courseCache()->load(courseId,
+                    pathReplacement.c_str());
+        }
+    }
+
     return raceScenario.spMaxTeamSize < 2 ? PageId::ResultRaceTotal : PageId::ResultTeamVSTotal;
 }
 
@@ -49,6 +49,9 @@ void WU8LibraryPage::afterCalc() {
 
     MessageInfo info;
     info.strings[0] = fileWide;
+    info.intVals[0] = extractionState.completedCount;
+    info.intVals[1] = extractionState.totalCount;
+    info.intVals[2] = extractionState.throughput;
 
     using enum SP::WU8Library::ExtractionStage;
     switch (extractionState.stage) {
@@ -57,9 +60,6 @@ void WU8LibraryPage::afterCalc() {
     case Ripping:
         info.messageIds[0] = 10443;
         break;
-    case Decompressing:
-        info.messageIds[0] = 10444;
-        break;
     case Processing:
         info.messageIds[0] = 10445;
         break;
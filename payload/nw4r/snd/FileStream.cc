@@ -44,7 +44,13 @@ s32 FileStream::read(void *dst, u32 size) {
         return -1;
     }
 
-    bool result = m_file->read(dst, size, m_start + m_offset);
+    bool result;
+    u32 offset = m_start + m_offset;
+    if (auto request = m_file->readAsync(dst, size, offset, SP::Storage::IOPriority::Stream)) {
+        result = request->wait();
+    } else {
+        result = m_file->read(dst, size, offset);
+    }
 
     {
         SP::ScopeLock<SP::NoInterrupts> lock;
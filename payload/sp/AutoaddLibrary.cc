@@ -0,0 +1,364 @@
+#include "AutoaddLibrary.hh"
+
+#include <common/Bytes.hh>
+
+#include <algorithm>
+#include <cstring>
+
+#define LIBRARY_PATH L"autoadd/library.bin"
+#define MANIFEST_PATH L"autoadd/manifest.bin"
+
+namespace SP {
+
+static const u32 LIBRARY_MAGIC = 0x5350414c; // SPAL
+static const u32 HEADER_SIZE = 0x10;
+static const u32 ENTRY_SIZE = 0x10;
+static const u32 MAX_INDEX_SIZE = 0x40000;
+static const u32 MANIFEST_MAGIC = 0x5350414d; // SPAM
+static const u32 MANIFEST_HEADER_SIZE = 0x20;
+
+// FNV-1a
+static u32 HashPath(const char *path) {
+    u32 hash = 0x811c9dc5;
+    for (; *path; path++) {
+        hash = (hash ^ static_cast<u8>(*path)) * 0x01000193;
+    }
+    return hash;
+}
+
+AutoaddLibrary::AutoaddLibrary(EGG::Heap *heap) : m_index(HeapAllocator<u8>({heap})) {
+    m_file = Storage::Open(LIBRARY_PATH, "r");
+    m_openCount++;
+    if (!m_file) {
+        return;
+    }
+
+    m_fileSize = m_file->size();
+    alignas(0x20) u8 header[HEADER_SIZE];
+    if (m_fileSize < HEADER_SIZE || !m_file->read(header, sizeof(header), 0) ||
+            Bytes::Read<u32>(header, 0x0) != LIBRARY_MAGIC) {
+        SP_LOG("No valid auto-add library pack, falling back to loose files");
+        m_file.reset();
+        return;
+    }
+
+    u32 entryCount = Bytes::Read<u32>(header, 0x4);
+    u32 stringTableSize = Bytes::Read<u32>(header, 0x8);
+    u64 indexSize = HEADER_SIZE + static_cast<u64>(entryCount) * ENTRY_SIZE + stringTableSize;
+    if (indexSize > MAX_INDEX_SIZE || indexSize > m_fileSize) {
+        SP_LOG("Invalid auto-add library index, falling back to loose files");
+        m_file.reset();
+        return;
+    }
+
+    m_index.resize(indexSize);
+    if (!m_file->read(m_index.data(), m_index.size(), 0) ||
+            (stringTableSize != 0 && m_index.back() != '\0')) {
+        SP_LOG("Invalid auto-add library index, falling back to loose files");
+        m_file.reset();
+        m_index.clear();
+        return;
+    }
+
+    m_entryCount = entryCount;
+    m_stringTableOffset = HEADER_SIZE + entryCount * ENTRY_SIZE;
+    m_stringTableSize = stringTableSize;
+}
+
+bool AutoaddLibrary::isPacked() const {
+    return m_file.has_value();
+}
+
+u32 AutoaddLibrary::openCount() const {
+    return m_openCount;
+}
+
+std::optional<AutoaddLibrary::Entry> AutoaddLibrary::lookup(const char *path) const {
+    if (!isPacked()) {
+        return {};
+    }
+
+    u32 hash = HashPath(path);
+    u32 low = 0;
+    u32 high = m_entryCount;
+    while (low < high) {
+        u32 mid = low + (high - low) / 2;
+        if (entryHash(mid) < hash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    for (u32 i = low; i < m_entryCount && entryHash(i) == hash; i++) {
+        u32 nameOffset = Bytes::Read<u32>(entry(i), 0x4);
+        if (nameOffset >= m_stringTableSize) {
+            continue;
+        }
+
+        const char *name = reinterpret_cast<const char *>(m_index.data() + m_stringTableOffset);
+        if (!strcmp(name + nameOffset, path)) {
+            return Entry{
+                    .offset = Bytes::Read<u32>(entry(i), 0x8),
+                    .size = Bytes::Read<u32>(entry(i), 0xc),
+            };
+        }
+    }
+
+    return {};
+}
+
+std::optional<bool> AutoaddLibrary::read(const char *path,
+        std::vector<u8, HeapAllocator<u8>> *out) {
+    if (isPacked()) {
+        auto entry = lookup(path);
+        if (!entry) {
+            return false;
+        }
+        if (static_cast<u64>(entry->offset) + entry->size > m_fileSize) {
+            return {};
+        }
+
+        if (out) {
+            out->resize(entry->size);
+            if (!m_file->read(out->data(), entry->size, entry->offset)) {
+                return {};
+            }
+        }
+        return true;
+    }
+
+    wchar_t loosePath[64];
+    swprintf(loosePath, std::size(loosePath), L"autoadd/%s", path);
+    auto file = Storage::Open(loosePath, "r");
+    m_openCount++;
+    if (!file) {
+        return false;
+    }
+
+    if (out) {
+        out->resize(file->size());
+        if (!file->read(out->data(), file->size(), 0)) {
+            return {};
+        }
+    }
+    return true;
+}
+
+bool AutoaddLibrary::readMany(const char *const *paths, u32 count,
+        std::vector<u8, HeapAllocator<u8>> *out, std::optional<u32> *sizes) {
+    assert(count <= Storage::MAX_READ_RANGE_COUNT);
+
+    out->clear();
+    if (!isPacked()) {
+        std::vector<u8, HeapAllocator<u8>> file(out->get_allocator());
+        for (u32 i = 0; i < count; i++) {
+            auto result = read(paths[i], &file);
+            if (!result) {
+                return false;
+            }
+            sizes[i].reset();
+            if (*result) {
+                sizes[i] = file.size();
+                out->insert(out->end(), file.begin(), file.end());
+            }
+        }
+        return true;
+    }
+
+    Entry entries[Storage::MAX_READ_RANGE_COUNT];
+    u32 totalSize = 0;
+    for (u32 i = 0; i < count; i++) {
+        sizes[i].reset();
+        auto entry = lookup(paths[i]);
+        if (!entry) {
+            continue;
+        }
+        if (static_cast<u64>(entry->offset) + entry->size > m_fileSize) {
+            return false;
+        }
+        entries[i] = *entry;
+        sizes[i] = entry->size;
+        totalSize += entry->size;
+    }
+
+    out->resize(totalSize);
+    Storage::ReadRange ranges[Storage::MAX_READ_RANGE_COUNT];
+    u32 rangeCount = 0;
+    for (u32 i = 0, offset = 0; i < count; i++) {
+        if (sizes[i]) {
+            ranges[rangeCount++] = {out->data() + offset, entries[i].size, entries[i].offset};
+            offset += entries[i].size;
+        }
+    }
+    return rangeCount == 0 || m_file->readv(ranges, rangeCount);
+}
+
+u32 AutoaddLibrary::entryHash(u32 index) const {
+    return Bytes::Read<u32>(entry(index), 0x0);
+}
+
+const u8 *AutoaddLibrary::entry(u32 index) const {
+    return m_index.data() + HEADER_SIZE + index * ENTRY_SIZE;
+}
+
+AutoaddLibraryWriter::AutoaddLibraryWriter(EGG::Heap *heap, u32 maxEntryCount,
+        u32 stringTableSize)
+    : m_entries(HeapAllocator<PendingEntry>({heap})), m_strings(HeapAllocator<u8>({heap})),
+      m_index(HeapAllocator<u8>({heap})), m_maxEntryCount(maxEntryCount),
+      m_stringTableSize(stringTableSize) {
+    m_entries.reserve(maxEntryCount);
+    m_strings.reserve(stringTableSize);
+    m_index.resize(AlignUp(HEADER_SIZE + maxEntryCount * ENTRY_SIZE + stringTableSize, 0x20));
+    m_manifest = new (heap, 0x20) u8[MANIFEST_HEADER_SIZE + m_index.size()];
+    m_dataStart = m_index.size();
+    m_dataOffset = m_dataStart;
+
+    if (resume()) {
+        SP_LOG("Resuming the auto-add library extraction at %u", m_progress);
+        return;
+    }
+
+    // Zero the index up front, so that an interrupted extraction leaves an invalid pack behind.
+    m_file = Storage::Open(LIBRARY_PATH, "w");
+    if (m_file && !m_file->write(m_index.data(), m_index.size(), 0)) {
+        m_file.reset();
+    }
+}
+
+AutoaddLibraryWriter::~AutoaddLibraryWriter() {
+    delete[] m_manifest;
+}
+
+u32 AutoaddLibraryWriter::progress() const {
+    return m_progress;
+}
+
+bool AutoaddLibraryWriter::add(const char *path, const u8 *src, u32 size) {
+    u32 nameSize = strlen(path) + 1;
+    if (!m_file || m_entries.size() == m_maxEntryCount ||
+            m_strings.size() + nameSize > m_stringTableSize) {
+        return false;
+    }
+
+    if (!m_file->write(src, size, m_dataOffset)) {
+        return false;
+    }
+
+    m_entries.push_back(PendingEntry{
+            .hash = HashPath(path),
+            .nameOffset = static_cast<u32>(m_strings.size()),
+            .offset = m_dataOffset,
+            .size = size,
+    });
+    m_strings.insert(m_strings.end(), path, path + nameSize);
+    m_dataOffset = AlignUp(m_dataOffset + size, 0x20);
+    return true;
+}
+
+bool AutoaddLibraryWriter::checkpoint(u32 progress) {
+    if (!m_file || !m_file->sync()) {
+        return false;
+    }
+
+    Bytes::Write<u32>(m_manifest, 0x00, MANIFEST_MAGIC);
+    Bytes::Write<u32>(m_manifest, 0x04, progress);
+    Bytes::Write<u32>(m_manifest, 0x08, m_maxEntryCount);
+    Bytes::Write<u32>(m_manifest, 0x0c, m_stringTableSize);
+    Bytes::Write<u32>(m_manifest, 0x10, m_dataOffset);
+    Bytes::Write<u32>(m_manifest, 0x14, m_entries.size());
+    Bytes::Write<u32>(m_manifest, 0x18, m_strings.size());
+    Bytes::Write<u32>(m_manifest, 0x1c, 0);
+    for (u32 i = 0; i < m_entries.size(); i++) {
+        u8 *entry = m_manifest + MANIFEST_HEADER_SIZE + i * ENTRY_SIZE;
+        Bytes::Write<u32>(entry, 0x0, m_entries[i].hash);
+        Bytes::Write<u32>(entry, 0x4, m_entries[i].nameOffset);
+        Bytes::Write<u32>(entry, 0x8, m_entries[i].offset);
+        Bytes::Write<u32>(entry, 0xc, m_entries[i].size);
+    }
+    u32 stringsOffset = MANIFEST_HEADER_SIZE + m_entries.size() * ENTRY_SIZE;
+    memcpy(m_manifest + stringsOffset, m_strings.data(), m_strings.size());
+    if (!Storage::WriteFile(MANIFEST_PATH, m_manifest, stringsOffset + m_strings.size(), true)) {
+        return false;
+    }
+
+    m_progress = progress;
+    return true;
+}
+
+bool AutoaddLibraryWriter::finish() {
+    if (!m_file) {
+        return false;
+    }
+
+    std::sort(m_entries.begin(), m_entries.end(),
+            [](const auto &a, const auto &b) { return a.hash < b.hash; });
+
+    for (u32 i = 0; i < m_entries.size(); i++) {
+        u8 *entry = m_index.data() + HEADER_SIZE + i * ENTRY_SIZE;
+        Bytes::Write<u32>(entry, 0x0, m_entries[i].hash);
+        Bytes::Write<u32>(entry, 0x4, m_entries[i].nameOffset);
+        Bytes::Write<u32>(entry, 0x8, m_entries[i].offset);
+        Bytes::Write<u32>(entry, 0xc, m_entries[i].size);
+    }
+    u32 stringTableOffset = HEADER_SIZE + m_entries.size() * ENTRY_SIZE;
+    memcpy(m_index.data() + stringTableOffset, m_strings.data(), m_strings.size());
+
+    Bytes::Write<u32>(m_index.data(), 0x0, LIBRARY_MAGIC);
+    Bytes::Write<u32>(m_index.data(), 0x4, m_entries.size());
+    Bytes::Write<u32>(m_index.data(), 0x8, m_strings.size());
+    Bytes::Write<u32>(m_index.data(), 0xc, 0);
+    if (!m_file->write(m_index.data(), stringTableOffset + m_strings.size(), 0) ||
+            !m_file->sync()) {
+        return false;
+    }
+
+    m_file.reset();
+    Storage::Remove(MANIFEST_PATH, true);
+    return true;
+}
+
+bool AutoaddLibraryWriter::resume() {
+    u32 manifestSize = MANIFEST_HEADER_SIZE + m_index.size();
+    auto size = Storage::ReadFile(MANIFEST_PATH, m_manifest, manifestSize);
+    if (!size || *size < MANIFEST_HEADER_SIZE ||
+            Bytes::Read<u32>(m_manifest, 0x00) != MANIFEST_MAGIC ||
+            Bytes::Read<u32>(m_manifest, 0x08) != m_maxEntryCount ||
+            Bytes::Read<u32>(m_manifest, 0x0c) != m_stringTableSize) {
+        return false;
+    }
+
+    u32 progress = Bytes::Read<u32>(m_manifest, 0x04);
+    u32 dataOffset = Bytes::Read<u32>(m_manifest, 0x10);
+    u32 entryCount = Bytes::Read<u32>(m_manifest, 0x14);
+    u32 stringsSize = Bytes::Read<u32>(m_manifest, 0x18);
+    if (entryCount > m_maxEntryCount || stringsSize > m_stringTableSize ||
+            *size != MANIFEST_HEADER_SIZE + entryCount * ENTRY_SIZE + stringsSize ||
+            dataOffset < m_dataStart) {
+        return false;
+    }
+
+    auto file = Storage::Open(LIBRARY_PATH, "r+");
+    if (!file || file->size() < dataOffset) {
+        return false;
+    }
+
+    for (u32 i = 0; i < entryCount; i++) {
+        const u8 *entry = m_manifest + MANIFEST_HEADER_SIZE + i * ENTRY_SIZE;
+        m_entries.push_back(PendingEntry{
+                .hash = Bytes::Read<u32>(entry, 0x0),
+                .nameOffset = Bytes::Read<u32>(entry, 0x4),
+                .offset = Bytes::Read<u32>(entry, 0x8),
+                .size = Bytes::Read<u32>(entry, 0xc),
+        });
+    }
+    const u8 *strings = m_manifest + MANIFEST_HEADER_SIZE + entryCount * ENTRY_SIZE;
+    m_strings.assign(strings, strings + stringsSize);
+
+    m_file = std::move(*file);
+    m_dataOffset = dataOffset;
+    m_progress = progress;
+    return true;
+}
+
+} // namespace SP
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "sp/HeapAllocator.hh"
+#include "sp/storage/Storage.hh"
+
+#include <vector>
+
+namespace SP {
+
+// The vanilla course files which WU8 archives are XORed against. New extractions pack them into a
+// single file behind an index sorted by path hash, older ones stored them loose under autoadd/.
+class AutoaddLibrary {
+public:
+    struct Entry {
+        u32 offset;
+        u32 size;
+    };
+
+    AutoaddLibrary(EGG::Heap *heap);
+    AutoaddLibrary(const AutoaddLibrary &) = delete;
+
+    bool isPacked() const;
+    // The number of files opened so far, including the pack itself.
+    u32 openCount() const;
+
+    // Paths are relative to autoadd/.
+    std::optional<Entry> lookup(const char *path) const;
+    // Returns whether the file exists, and reads it into out unless it is null. Returns nothing if
+    // the file exists but could not be read.
+    std::optional<bool> read(const char *path, std::vector<u8, HeapAllocator<u8>> *out);
+    // Reads up to Storage::MAX_READ_RANGE_COUNT files one after the other into out, with a single
+    // vectored read if the library is packed. sizes receives the size of each file, or nothing if it
+    // doesn't exist. Returns false if a file exists but could not be read.
+    bool readMany(const char *const *paths, u32 count, std::vector<u8, HeapAllocator<u8>> *out,
+            std::optional<u32> *sizes);
+
+private:
+    u32 entryHash(u32 index) const;
+    const u8 *entry(u32 index) const;
+
+    std::optional<Storage::FileHandle> m_file;
+    u64 m_fileSize = 0;
+    std::vector<u8, HeapAllocator<u8>> m_index;
+    u32 m_entryCount = 0;
+    u32 m_stringTableOffset = 0;
+    u32 m_stringTableSize = 0;
+    u32 m_openCount = 0;
+};
+
+// Everything is allocated in the constructor, so the other methods may run on a different thread.
+class AutoaddLibraryWriter {
+public:
+    // The string table has to be sized up front, as file data is written before the index. If a
+    // manifest from an interrupted extraction with the same sizes exists, it is resumed from.
+    AutoaddLibraryWriter(EGG::Heap *heap, u32 maxEntryCount, u32 stringTableSize);
+    AutoaddLibraryWriter(const AutoaddLibraryWriter &) = delete;
+    ~AutoaddLibraryWriter();
+
+    // The value passed to the last checkpoint, or 0 for a fresh extraction.
+    u32 progress() const;
+
+    bool add(const char *path, const u8 *src, u32 size);
+    // Makes everything added so far survive an interruption.
+    bool checkpoint(u32 progress);
+    bool finish();
+
+private:
+    struct PendingEntry {
+        u32 hash;
+        u32 nameOffset;
+        u32 offset;
+        u32 size;
+    };
+
+    bool resume();
+
+    std::optional<Storage::FileHandle> m_file;
+    std::vector<PendingEntry, HeapAllocator<PendingEntry>> m_entries;
+    std::vector<u8, HeapAllocator<u8>> m_strings;
+    std::vector<u8, HeapAllocator<u8>> m_index;
+    u8 *m_manifest;
+    u32 m_maxEntryCount;
+    u32 m_stringTableSize;
+    u32 m_dataStart;
+    u32 m_dataOffset;
+    u32 m_progress = 0;
+};
+
+} // namespace SP
@@ -0,0 +1,14 @@
+#include "Decoder.hh"
+
+namespace SP {
+
+void Decoder::setSHA1Sink(NETSHA1Context *sha1Sink) {
+    m_sha1Sink = sha1Sink;
+}
+
+void Decoder::hashOutput(const u8 *dst, size_t dstOffset) {
+    NETSHA1Update(m_sha1Sink, dst + m_sha1Offset, dstOffset - m_sha1Offset);
+    m_sha1Offset = dstOffset;
+}
+
+} // namespace SP
@@ -2,6 +2,10 @@
 
 #include <Common.hh>
 
+extern "C" {
+#include <revolution.h>
+}
+
 namespace SP {
 
 class Decoder {
@@ -12,6 +16,26 @@ public:
     virtual bool ok() const = 0;
     virtual bool done() const = 0;
     virtual size_t headerSize() const = 0;
+
+    // The output is hashed as it is produced, while it is still in the cache, which saves a second
+    // pass over it.
+    void setSHA1Sink(NETSHA1Context *sha1Sink);
+
+protected:
+    // Unless flushing, waits for a whole step to be produced, so this can be called for each group.
+    void updateSHA1Sink(const u8 *dst, size_t dstOffset, bool flush) {
+        if (m_sha1Sink && (flush || dstOffset - m_sha1Offset >= SHA1_SINK_STEP_SIZE)) {
+            hashOutput(dst, dstOffset);
+        }
+    }
+
+private:
+    void hashOutput(const u8 *dst, size_t dstOffset);
+
+    NETSHA1Context *m_sha1Sink = nullptr;
+    size_t m_sha1Offset = 0;
+
+    static const size_t SHA1_SINK_STEP_SIZE = 0x4000;
 };
 
 } // namespace SP
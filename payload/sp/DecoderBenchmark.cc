@@ -0,0 +1,325 @@
+#include "sp/LZ77Decoder.hh"
+#include "sp/WU8Library.hh"
+#include "sp/YAZDecoder.hh"
+#include "sp/storage/DecompLoader.hh"
+
+#include <game/system/ResourceManager.hh>
+#include <game/system/RootScene.hh>
+extern "C" {
+#include <sp/Commands.h>
+}
+#include <vendor/libhydrogen/hydrogen.h>
+
+#include <cstring>
+
+namespace SP::DecoderBenchmark {
+
+static u32 KibibytesPerSecond(u64 size, OSTime duration) {
+    if (duration == 0) {
+        return 0;
+    }
+    return OSSecondsToTicks(size / 1024) / duration;
+}
+
+sp_define_command("/bench_yaz", "Benchmark YAZ decoding of the vanilla courses", const char *) {
+    auto *heap = System::RootScene::Instance()->m_heapCollection.mem2;
+    auto *dvdStorage = Storage::GetStorage(Storage::StorageType::DVD);
+
+    u64 totalSize = 0;
+    OSTime streamDuration = 0;
+    OSTime bulkDuration = 0;
+    OSTime loaderDuration = 0;
+    for (u32 courseId = 0; courseId < 42; courseId++) {
+        const char *courseFilename = System::ResourceManager::CourseFilenames[courseId];
+        wchar_t path[64];
+        swprintf(path, std::size(path), L"ro:/Race/Course/%s.szs", courseFilename);
+        auto file = dvdStorage->open(path, "r");
+        if (!file) {
+            OSReport("&abench_yaz: Failed to open %ls\n", path);
+            return;
+        }
+
+        u32 srcSize = file->size();
+        u8 *src = new (heap, 0x20) u8[srcSize];
+        if (!file->read(src, srcSize, 0)) {
+            OSReport("&abench_yaz: Failed to read %ls\n", path);
+            delete[] src;
+            return;
+        }
+
+        auto dstSize = YAZDecoder::GetDecodedSize(src, srcSize);
+        if (!dstSize) {
+            delete[] src;
+            continue;
+        }
+        u8 *dst = new (heap, 0x20) u8[*dstSize];
+
+        bool ok = true;
+        OSTime durations[2];
+        for (u32 i = 0; i < std::size(durations); i++) {
+            OSTime startTime = OSGetTime();
+            ok = ok && YAZDecoder::Decode(src, srcSize, dst, *dstSize, i == 1);
+            durations[i] = OSGetTime() - startTime;
+        }
+        delete[] dst;
+        delete[] src;
+        if (!ok) {
+            OSReport("&abench_yaz: Failed to decode %ls\n", path);
+            return;
+        }
+
+        // Also time the full loader path (I/O included) to catch regressions in the pipeline.
+        char roPath[64];
+        snprintf(roPath, std::size(roPath), "Race/Course/%s.szs", courseFilename);
+        u8 *loaded;
+        size_t loadedSize;
+        OSTime startTime = OSGetTime();
+        if (!Storage::DecompLoader::LoadRO(roPath, &loaded, &loadedSize, heap,
+                    Storage::StorageType::DVD)) {
+            OSReport("&abench_yaz: Failed to load %s\n", roPath);
+            return;
+        }
+        loaderDuration += OSGetTime() - startTime;
+        delete[] loaded;
+
+        OSReport("bench_yaz: %s: %u KiB, stream %u KiB/s, bulk %u KiB/s\n", courseFilename,
+                *dstSize / 1024, KibibytesPerSecond(*dstSize, durations[0]),
+                KibibytesPerSecond(*dstSize, durations[1]));
+        totalSize += *dstSize;
+        streamDuration += durations[0];
+        bulkDuration += durations[1];
+    }
+
+    OSReport("bench_yaz: Total %u KiB, stream %u KiB/s, bulk %u KiB/s, loader %u KiB/s\n",
+            static_cast<u32>(totalSize / 1024), KibibytesPerSecond(totalSize, streamDuration),
+            KibibytesPerSecond(totalSize, bulkDuration),
+            KibibytesPerSecond(totalSize, loaderDuration));
+}
+
+sp_define_command("/bench_sha1", "Benchmark hashing the vanilla courses while decoding them",
+        const char *) {
+    auto *heap = System::RootScene::Instance()->m_heapCollection.mem2;
+    auto *dvdStorage = Storage::GetStorage(Storage::StorageType::DVD);
+
+    u64 totalSize = 0;
+    OSTime separateDuration = 0;
+    OSTime sinkDuration = 0;
+    for (u32 courseId = 0; courseId < 42; courseId++) {
+        const char *courseFilename = System::ResourceManager::CourseFilenames[courseId];
+        wchar_t path[64];
+        swprintf(path, std::size(path), L"ro:/Race/Course/%s.szs", courseFilename);
+        auto file = dvdStorage->open(path, "r");
+        if (!file) {
+            OSReport("&abench_sha1: Failed to open %ls\n", path);
+            return;
+        }
+
+        u32 srcSize = file->size();
+        u8 *src = new (heap, 0x20) u8[srcSize];
+        if (!file->read(src, srcSize, 0)) {
+            OSReport("&abench_sha1: Failed to read %ls\n", path);
+            delete[] src;
+            return;
+        }
+
+        auto dstSize = YAZDecoder::GetDecodedSize(src, srcSize);
+        if (!dstSize) {
+            delete[] src;
+            continue;
+        }
+        u8 *dst = new (heap, 0x20) u8[*dstSize];
+
+        u8 separateDigest[NET_SHA1_DIGEST_SIZE];
+        OSTime startTime = OSGetTime();
+        bool ok = YAZDecoder::Decode(src, srcSize, dst, *dstSize).has_value();
+        NETSHA1Context context;
+        NETSHA1Init(&context);
+        NETSHA1Update(&context, dst, *dstSize);
+        NETSHA1GetDigest(&context, separateDigest);
+        OSTime separate = OSGetTime() - startTime;
+
+        u8 sinkDigest[NET_SHA1_DIGEST_SIZE];
+        startTime = OSGetTime();
+        NETSHA1Init(&context);
+        ok = ok && YAZDecoder::Decode(src, srcSize, dst, *dstSize, true, &context);
+        NETSHA1GetDigest(&context, sinkDigest);
+        OSTime sink = OSGetTime() - startTime;
+        delete[] dst;
+        delete[] src;
+        if (!ok) {
+            OSReport("&abench_sha1: Failed to decode %ls\n", path);
+            return;
+        }
+        if (memcmp(separateDigest, sinkDigest, sizeof(sinkDigest))) {
+            OSReport("&abench_sha1: Digest mismatch for %ls\n", path);
+            return;
+        }
+
+        OSReport("bench_sha1: %s: %u KiB, separate %u KiB/s, sink %u KiB/s\n", courseFilename,
+                *dstSize / 1024, KibibytesPerSecond(*dstSize, separate),
+                KibibytesPerSecond(*dstSize, sink));
+        totalSize += *dstSize;
+        separateDuration += separate;
+        sinkDuration += sink;
+    }
+
+    OSReport("bench_sha1: Total %u KiB, separate %u KiB/s, sink %u KiB/s\n",
+            static_cast<u32>(totalSize / 1024), KibibytesPerSecond(totalSize, separateDuration),
+            KibibytesPerSecond(totalSize, sinkDuration));
+}
+
+// Builds a random but well-formed LZ77 stream which decodes to dstSize bytes.
+static size_t GenerateLZ77(u8 *src, u32 dstSize) {
+    src[0] = 0x10;
+    src[1] = dstSize >> 0;
+    src[2] = dstSize >> 8;
+    src[3] = dstSize >> 16;
+    size_t srcOffset = sizeof(u32);
+
+    u32 dstOffset = 0;
+    while (dstOffset < dstSize) {
+        u8 &groupHeader = src[srcOffset++];
+        groupHeader = 0;
+        for (u8 i = 0; i < 8 && dstOffset < dstSize; i++) {
+            u32 maxRefSize = std::min<u32>(dstSize - dstOffset, 0xf + 0x3);
+            if (dstOffset == 0 || maxRefSize < 0x3 || hydro_random_uniform(2) == 0) {
+                src[srcOffset++] = hydro_random_uniform(4);
+                dstOffset++;
+                continue;
+            }
+
+            groupHeader |= 0x80 >> i;
+            u32 refOffset = hydro_random_uniform(std::min<u32>(dstOffset, 0x1000)) + 0x1;
+            u32 refSize = hydro_random_uniform(maxRefSize - 0x3 + 1) + 0x3;
+            src[srcOffset++] = (refSize - 0x3) << 4 | (refOffset - 0x1) >> 8;
+            src[srcOffset++] = refOffset - 0x1;
+            dstOffset += refSize;
+        }
+    }
+
+    return srcOffset;
+}
+
+sp_define_command("/fuzz_lz77", "Compare the LZ77 decoding paths on random inputs",
+        const char *tmp) {
+    u32 iterations = 100;
+    sscanf(tmp, "/fuzz_lz77 %u", &iterations);
+
+    auto *heap = System::RootScene::Instance()->m_heapCollection.mem2;
+    const u32 maxDstSize = 0x40000;
+    u8 *src = new (heap, 0x20) u8[sizeof(u32) + maxDstSize + maxDstSize / 8 + 1];
+    u8 *dsts[2];
+    for (u32 i = 0; i < std::size(dsts); i++) {
+        dsts[i] = new (heap, 0x20) u8[maxDstSize];
+    }
+
+    u64 totalSize = 0;
+    OSTime durations[2] = {};
+    u32 failures = 0;
+    for (u32 iteration = 0; iteration < iterations; iteration++) {
+        u32 dstSize = hydro_random_uniform(maxDstSize) + 1;
+        size_t srcSize;
+        if (iteration % 4 == 3) {
+            // Garbage, both paths have to agree on whether and where it fails.
+            srcSize = hydro_random_uniform(maxDstSize) + sizeof(u32);
+            hydro_random_buf(src, srcSize);
+            src[0] = 0x10;
+        } else {
+            srcSize = GenerateLZ77(src, dstSize);
+        }
+
+        std::optional<u32> results[2];
+        for (u32 i = 0; i < std::size(results); i++) {
+            OSTime startTime = OSGetTime();
+            results[i] = LZ77Decoder::Decode(src, srcSize, dsts[i], maxDstSize, i == 1);
+            durations[i] += OSGetTime() - startTime;
+        }
+
+        if (results[0] != results[1] || (results[0] && memcmp(dsts[0], dsts[1], *results[0]))) {
+            OSReport("&afuzz_lz77: Mismatch on iteration %u (%zu bytes)\n", iteration, srcSize);
+            failures++;
+        } else if (results[0]) {
+            totalSize += *results[0];
+        }
+    }
+
+    for (u32 i = 0; i < std::size(dsts); i++) {
+        delete[] dsts[i];
+    }
+    delete[] src;
+
+    OSReport("fuzz_lz77: %u / %u mismatches, stream %u KiB/s, bulk %u KiB/s\n", failures,
+            iterations, KibibytesPerSecond(totalSize, durations[0]),
+            KibibytesPerSecond(totalSize, durations[1]));
+}
+
+// The byte-by-byte loop DecodeWU8 used before XorWU8, kept as the reference.
+static void XorWU8Reference(std::span<u8> buf, std::span<const u8> pattern, u8 key) {
+    size_t patternIndex = 0;
+    for (size_t i = 0; i < buf.size(); i++) {
+        if (patternIndex == pattern.size()) {
+            patternIndex = 0;
+        }
+
+        buf[i] ^= key ^ (pattern.empty() ? 0 : pattern[patternIndex]);
+        patternIndex++;
+    }
+}
+
+sp_define_command("/bench_wu8", "Compare and benchmark the WU8 XOR kernel", const char *tmp) {
+    u32 iterations = 100;
+    sscanf(tmp, "/bench_wu8 %u", &iterations);
+
+    auto *heap = System::RootScene::Instance()->m_heapCollection.mem2;
+    const u32 maxBufSize = 0x80000;
+    const u32 maxPatternSize = 0x20000;
+    u8 *pattern = new (heap, 0x20) u8[maxPatternSize + 0x20];
+    u8 *bufs[2];
+    for (u32 i = 0; i < std::size(bufs); i++) {
+        bufs[i] = new (heap, 0x20) u8[maxBufSize + 0x20];
+    }
+
+    u64 totalSize = 0;
+    OSTime durations[2] = {};
+    u32 failures = 0;
+    for (u32 iteration = 0; iteration < iterations; iteration++) {
+        // Misalign both buffers independently, and every 4th iteration use no pattern at all.
+        u32 bufOffset = hydro_random_uniform(0x20);
+        u32 bufSize = hydro_random_uniform(maxBufSize) + 1;
+        u32 patternOffset = hydro_random_uniform(0x20);
+        u32 patternSize = iteration % 4 == 3 ? 0 : hydro_random_uniform(maxPatternSize) + 1;
+        u8 key = hydro_random_uniform(0x100);
+        hydro_random_buf(pattern + patternOffset, patternSize);
+        hydro_random_buf(bufs[0] + bufOffset, bufSize);
+        memcpy(bufs[1] + bufOffset, bufs[0] + bufOffset, bufSize);
+
+        for (u32 i = 0; i < std::size(bufs); i++) {
+            std::span<u8> buf(bufs[i] + bufOffset, bufSize);
+            std::span<const u8> patternSpan(pattern + patternOffset, patternSize);
+            OSTime startTime = OSGetTime();
+            if (i == 0) {
+                XorWU8Reference(buf, patternSpan, key);
+            } else {
+                XorWU8(buf, patternSpan, key);
+            }
+            durations[i] += OSGetTime() - startTime;
+        }
+
+        if (memcmp(bufs[0] + bufOffset, bufs[1] + bufOffset, bufSize)) {
+            OSReport("&abench_wu8: Mismatch on iteration %u (%u bytes, pattern %u bytes)\n",
+                    iteration, bufSize, patternSize);
+            failures++;
+        }
+        totalSize += bufSize;
+    }
+
+    for (u32 i = 0; i < std::size(bufs); i++) {
+        delete[] bufs[i];
+    }
+    delete[] pattern;
+
+    OSReport("bench_wu8: %u / %u mismatches, byte %u KiB/s, word %u KiB/s\n", failures, iterations,
+            KibibytesPerSecond(totalSize, durations[0]), KibibytesPerSecond(totalSize, durations[1]));
+}
+
+} // namespace SP::DecoderBenchmark
@@ -2,29 +2,30 @@
 
 #include <common/Bytes.hh>
 
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
 namespace SP {
 
 LZ77Decoder::LZ77Decoder(const u8 *src, size_t srcSize, EGG::Heap *heap) {
-    if (srcSize < sizeof(u32)) {
+    auto dstSize = GetDecodedSize(src, srcSize);
+    if (!dstSize) {
         m_ok = false;
         return;
     }
-    m_dstSize = Bytes::Read<u32, std::endian::little>(src, 0x0) >> 8;
-    if (m_dstSize == 0) {
-        if (srcSize < 2 * sizeof(u32)) {
-            m_ok = false;
-            return;
-        }
-        m_headerSize = 2 * sizeof(u32);
-        m_dstSize = Bytes::Read<u32, std::endian::little>(src, 0x4);
-    } else {
-        m_headerSize = sizeof(u32);
-    }
+    m_headerSize = GetHeaderSize(src);
+    m_dstSize = *dstSize;
     m_dst = new (heap, 0x20) u8[m_dstSize];
 }
 
+LZ77Decoder::LZ77Decoder(u8 *dst, size_t dstSize, bool bulk)
+    : m_owning(false), m_dst(dst), m_dstSize(dstSize), m_bulk(bulk) {}
+
 LZ77Decoder::~LZ77Decoder() {
-    delete[] m_dst;
+    if (m_owning) {
+        delete[] m_dst;
+    }
     m_dst = nullptr;
     m_dstSize = 0;
 }
@@ -75,13 +76,64 @@ bool LZ77Decoder::process(const u8 *src, size_t &srcOffset) {
     assert(false);
 }
 
+// Only called on group boundaries. Decodes as many complete groups as are guaranteed to fit in
+// both the remaining input and output, leaving the edges to the byte-wise state machine.
+bool LZ77Decoder::processGroups(const u8 *src, size_t srcSize, size_t &srcOffset) {
+    while (srcSize - srcOffset >= MAX_GROUP_SRC_SIZE &&
+            m_dstSize - m_dstOffset >= MAX_GROUP_DST_SIZE) {
+        u8 groupHeader = src[srcOffset++];
+        for (u8 i = 0; i < 8;) {
+            // Literals are flagged with zeroes, so a whole run of them can be copied at once.
+            u8 literalCount = std::min(std::countl_zero(groupHeader), 8 - i);
+            if (literalCount != 0) {
+                memcpy(m_dst + m_dstOffset, src + srcOffset, literalCount);
+                m_dstOffset += literalCount;
+                srcOffset += literalCount;
+                groupHeader <<= literalCount;
+                i += literalCount;
+                continue;
+            }
+
+            u8 val0 = src[srcOffset++];
+            u8 val1 = src[srcOffset++];
+            size_t refOffset = ((val0 & 0xf) << 8 | val1) + 0x1;
+            size_t refSize = (val0 >> 4) + 0x3;
+            if (refOffset > m_dstOffset) {
+                return false;
+            }
+
+            u8 *dst = m_dst + m_dstOffset;
+            const u8 *ref = dst - refOffset;
+            if (refOffset >= refSize) {
+                memcpy(dst, ref, refSize);
+            } else {
+                // Overlapping references repeat the last refOffset bytes, so they must be copied
+                // front to back.
+                for (size_t j = 0; j < refSize; j++) {
+                    dst[j] = ref[j];
+                }
+            }
+            m_dstOffset += refSize;
+            groupHeader <<= 1;
+            i++;
+        }
+
+        updateSHA1Sink(m_dst, m_dstOffset, false);
+    }
+
+    return true;
+}
+
 bool LZ77Decoder::decode(const u8 *src, size_t srcSize) {
     assert(ok() && !done());
 
     size_t srcOffset = 0;
-    do {
+    while (true) {
+        updateSHA1Sink(m_dst, m_dstOffset, false);
+
         if (m_dstOffset == m_dstSize) {
             if (m_state == State::GroupHeader) {
+                updateSHA1Sink(m_dst, m_dstOffset, true);
                 return true;
             }
             m_ok = false;
@@ -91,9 +143,24 @@ bool LZ77Decoder::decode(const u8 *src, size_t srcSize) {
         if (srcOffset == srcSize &&
                 ((m_state != State::GroupHeader || m_groupHeaderIndex == 7) &&
                         m_state != State::RefCopy)) {
+            updateSHA1Sink(m_dst, m_dstOffset, true);
             return true;
         }
-    } while (process(src, srcOffset));
+
+        if (m_bulk && m_state == State::GroupHeader && m_groupHeaderIndex == 7) {
+            size_t dstOffset = m_dstOffset;
+            if (!processGroups(src, srcSize, srcOffset)) {
+                break;
+            }
+            if (m_dstOffset != dstOffset) {
+                continue;
+            }
+        }
+
+        if (!process(src, srcOffset)) {
+            break;
+        }
+    }
 
     m_ok = false;
     return false;
@@ -124,4 +191,51 @@ bool LZ77Decoder::CheckMagic(u32 magic) {
     return (magic & 0xff) == 0x10;
 }
 
+std::optional<u32> LZ77Decoder::GetDecodedSize(const u8 *src, size_t srcSize) {
+    if (srcSize < sizeof(u32)) {
+        return {};
+    }
+    if (srcSize < GetHeaderSize(src)) {
+        return {};
+    }
+    u32 dstSize = Bytes::Read<u32, std::endian::little>(src, 0x0) >> 8;
+    if (dstSize == 0) {
+        dstSize = Bytes::Read<u32, std::endian::little>(src, 0x4);
+    }
+    return dstSize;
+}
+
+size_t LZ77Decoder::GetHeaderSize(const u8 *src) {
+    // A zero 24-bit size means that the real size follows as a separate word.
+    if (Bytes::Read<u32, std::endian::little>(src, 0x0) >> 8 == 0) {
+        return 2 * sizeof(u32);
+    }
+    return sizeof(u32);
+}
+
+std::optional<u32> LZ77Decoder::Decode(const u8 *src, size_t srcSize, u8 *dst, size_t dstSize,
+        bool bulk, NETSHA1Context *sha1Sink) {
+    if (srcSize < sizeof(u32) || !CheckMagic(Bytes::Read<u32, std::endian::little>(src, 0x0))) {
+        return {};
+    }
+    auto tmp = GetDecodedSize(src, srcSize);
+    if (!tmp) {
+        return {};
+    }
+    dstSize = std::min(static_cast<u32>(dstSize), *tmp);
+    if (dstSize == 0) {
+        return dstSize;
+    }
+    LZ77Decoder decoder(dst, dstSize, bulk);
+    decoder.setSHA1Sink(sha1Sink);
+    size_t headerSize = GetHeaderSize(src);
+    if (!decoder.decode(src + headerSize, srcSize - headerSize)) {
+        return {};
+    }
+    if (!decoder.done()) {
+        return {};
+    }
+    return dstSize;
+}
+
 } // namespace SP
@@ -26,10 +26,20 @@ public:
     size_t headerSize() const override;
 
     static bool CheckMagic(u32 magic);
+    static std::optional<u32> GetDecodedSize(const u8 *src, size_t srcSize);
+    // The bulk path decodes whole groups at once and is only disabled for benchmarking.
+    static std::optional<u32> Decode(const u8 *src, size_t srcSize, u8 *dst, size_t dstSize,
+            bool bulk = true, NETSHA1Context *sha1Sink = nullptr);
 
 private:
+    LZ77Decoder(u8 *dst, size_t dstSize, bool bulk);
+
+    static size_t GetHeaderSize(const u8 *src);
+
     bool process(const u8 *src, size_t &srcOffset);
+    bool processGroups(const u8 *src, size_t srcSize, size_t &srcOffset);
 
+    bool m_owning = true;
     size_t m_headerSize = 0;
     u8 *m_dst = nullptr;
     size_t m_dstSize = 0;
@@ -40,6 +50,11 @@ private:
     u16 m_refSize;
     u16 m_refOffset;
     bool m_ok = true;
+    bool m_bulk = true;
+
+    // A group is a header followed by up to 8 chunks of up to 2 bytes each.
+    static const size_t MAX_GROUP_SRC_SIZE = 1 + 8 * 2;
+    static const size_t MAX_GROUP_DST_SIZE = 8 * (0xf + 0x3);
 };
 
 } // namespace SP
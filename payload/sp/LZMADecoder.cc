@@ -77,6 +77,8 @@ bool LZMADecoder::decode(const u8 *src, size_t srcSize) {
             return false;
         }
     } while (srcSize != 0);
+    // LzmaDec consumes the whole input at once, so this hashes the output of each call.
+    updateSHA1Sink(m_dec.dic, m_dec.dicPos, true);
     if (!m_knownDstSize && status == LZMA_STATUS_FINISHED_WITH_MARK) {
         m_done = true;
     } else if (m_knownDstSize && m_dec.dicPos == m_dec.dicBufSize) {
@@ -1,6 +1,7 @@
 #include "PerfOverlay.hh"
 
 #include "sp/ScopeLock.hh"
+#include "sp/storage/SectorCache.hh"
 
 #include <egg/core/eggSystem.hh>
 #include <game/system/SaveManager.hh>
@@ -98,6 +99,16 @@ void PerfOverlay::measureBeginFrame(OSTime frameDuration) {
 
     m_gpuWidth = 600 * m_gpuDuration / m_frameDuration;
 
+    auto sectorCacheStats = Storage::SectorCache::GetStats();
+    u32 sectorCacheHits[2] = {sectorCacheStats.metadataHits, sectorCacheStats.dataHits};
+    u32 sectorCacheMisses[2] = {sectorCacheStats.metadataMisses, sectorCacheStats.dataMisses};
+    for (size_t i = 0; i < std::size(m_sectorCacheWidths); i++) {
+        u32 count = sectorCacheHits[i] + sectorCacheMisses[i];
+        if (count != 0) {
+            m_sectorCacheWidths[i] = 600 * static_cast<u64>(sectorCacheHits[i]) / count;
+        }
+    }
+
     for (size_t i = 0; i < std::size(m_memColors); i++) {
         auto &system = EGG::TSystem::Instance();
         u32 lo = reinterpret_cast<u32>(i == 0 ? system.mem1ArenaLo() : system.mem2ArenaLo());
@@ -171,6 +182,10 @@ void PerfOverlay::draw() {
     GXClearVtxDesc();
     GXSetVtxAttrFmt(GX_VTXFMT0, GX_VA_POS, GX_POS_XY, GX_S16, 0);
 
+    DrawRectangle(4, 424, 600, 6, {0, 0, 0, 102});
+    DrawRectangle(4, 425, m_sectorCacheWidths[0], 2, {255, 160, 80, 255});
+    DrawRectangle(4, 427, m_sectorCacheWidths[1], 2, {80, 255, 160, 255});
+
     DrawRectangle(4, 432, 600, 6, {0, 0, 0, 102});
     DrawRectangle(m_cpuDrawX, 433, m_cpuDrawWidth, 2, {80, 255, 80, 255});
     DrawRectangle(m_cpuCalcX, 433, m_cpuCalcWidth, 2, {255, 80, 255, 255});
@@ -52,6 +52,8 @@ private:
     s16 m_gpuX = 0;
     s16 m_gpuWidth = 0;
     GXColor m_memColors[2][600];
+    // The hit rates of the FAT sector cache, for metadata and data sectors.
+    s16 m_sectorCacheWidths[2] = {};
 
     static std::optional<PerfOverlay> s_instance;
     static OSSwitchThreadCallback s_switchThreadCallback;
@@ -0,0 +1,67 @@
+#include "StoredDecoder.hh"
+
+#include <common/Bytes.hh>
+
+#include <cstring>
+
+namespace SP {
+
+const u32 StoredDecoder::STORED_MAGIC = 0x53505374; // SPSt
+
+StoredDecoder::StoredDecoder(const u8 *src, size_t srcSize, EGG::Heap *heap) {
+    if (srcSize < HEADER_SIZE) {
+        m_ok = false;
+        return;
+    }
+    m_dstSize = Bytes::Read<u32>(src, 0x4);
+    m_dst = new (heap, 0x20) u8[m_dstSize];
+}
+
+StoredDecoder::~StoredDecoder() {
+    delete[] m_dst;
+    m_dst = nullptr;
+    m_dstSize = 0;
+}
+
+bool StoredDecoder::decode(const u8 *src, size_t size) {
+    assert(ok() && !done());
+
+    size = std::min(size, m_dstSize - m_dstOffset);
+    memcpy(m_dst + m_dstOffset, src, size);
+    m_dstOffset += size;
+    updateSHA1Sink(m_dst, m_dstOffset, true);
+    return true;
+}
+
+void StoredDecoder::release(u8 **dst, size_t *dstSize) {
+    assert(ok() && done() && m_dst != nullptr);
+
+    *dst = m_dst;
+    *dstSize = m_dstSize;
+    m_dst = nullptr;
+    m_dstSize = 0;
+}
+
+bool StoredDecoder::ok() const {
+    return m_ok;
+}
+
+bool StoredDecoder::done() const {
+    return m_dstOffset == m_dstSize;
+}
+
+size_t StoredDecoder::headerSize() const {
+    return HEADER_SIZE;
+}
+
+bool StoredDecoder::CheckMagic(u32 magic) {
+    return magic == STORED_MAGIC;
+}
+
+void StoredDecoder::WriteHeader(u8 *dst, u32 dstSize) {
+    memset(dst, 0, HEADER_SIZE);
+    Bytes::Write<u32>(dst, 0x0, STORED_MAGIC);
+    Bytes::Write<u32>(dst, 0x4, dstSize);
+}
+
+} // namespace SP
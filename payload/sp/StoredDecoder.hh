@@ -0,0 +1,35 @@
+#pragma once
+
+#include "sp/Decoder.hh"
+
+#include <egg/core/eggHeap.hh>
+
+namespace SP {
+
+// Uncompressed data behind a 0x20-byte header: the magic, the data size, then bytes which are left
+// to the writer (the archive cache stores its key there).
+class StoredDecoder : public Decoder {
+public:
+    StoredDecoder(const u8 *src, size_t srcSize, EGG::Heap *heap);
+    ~StoredDecoder() override;
+    bool decode(const u8 *src, size_t size) override;
+    void release(u8 **dst, size_t *dstSize) override;
+    bool ok() const override;
+    bool done() const override;
+    size_t headerSize() const override;
+
+    static bool CheckMagic(u32 magic);
+    static void WriteHeader(u8 *dst, u32 dstSize);
+
+    static const size_t HEADER_SIZE = 0x20;
+
+private:
+    u8 *m_dst = nullptr;
+    size_t m_dstSize = 0;
+    size_t m_dstOffset = 0;
+    bool m_ok = true;
+
+    static const u32 STORED_MAGIC;
+};
+
+} // namespace SP
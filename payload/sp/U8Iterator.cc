@@ -1,6 +1,6 @@
 #include "U8Iterator.hh"
 
-#include "sp/storage/Storage.hh"
+#include <cstdio>
 
 namespace SP {
 
@@ -10,23 +10,24 @@ void U8Iterator::reset(size_t startPos) {
     m_cursor.setPosition(startPos);
 }
 
-std::array<wchar_t, 64> U8Iterator::getPath(const char *name) const {
-    std::array<wchar_t, 64> path;
-    std::array<wchar_t, 64> pathBuf;
-    wcscpy(pathBuf.data(), L"autoadd");
+std::array<char, 64> U8Iterator::getPath(const char *name) const {
+    std::array<char, 64> path;
+    std::array<char, 64> pathBuf;
+    pathBuf[0] = '\0';
 
     for (u8 i = 0; i < m_dirStack.count(); i++) {
         auto dirName = m_cursor.readString(m_stringTableStart, m_dirStack[i]->nameOffset);
 
         // Avoid writing to path while it is being read by double buffering.
-        swprintf(path.data(), path.size(), L"%ls/%s", pathBuf.data(), dirName);
+        snprintf(path.data(), path.size(), i == 0 ? "%s%s" : "%s/%s", pathBuf.data(), dirName);
         pathBuf = path;
     }
 
     if (name == nullptr) {
         return pathBuf;
     } else {
-        swprintf(path.data(), path.size(), L"%ls/%s", pathBuf.data(), name);
+        snprintf(path.data(), path.size(), m_dirStack.count() == 0 ? "%s%s" : "%s/%s",
+                pathBuf.data(), name);
         return path;
     }
 }
@@ -64,18 +65,15 @@ std::optional<U8IterItem> U8Iterator::next(bool skipReadingFile) {
         return U8IterItem::Dir();
     }
 
-    auto path = getPath(name);
-    auto file = Storage::Open(path.data(), "r");
     bool hasData = false;
-    if (file.has_value()) {
-        hasData = true;
-        if (!skipReadingFile) {
-            assert(m_fileOut != nullptr);
-            m_fileOut->resize(file->size());
-            if (!file->read(m_fileOut->data(), file->size(), 0)) {
-                return U8IterItem::Err();
-            }
+    if (m_library != nullptr) {
+        assert(skipReadingFile || m_fileOut != nullptr);
+        auto path = getPath(name);
+        auto result = m_library->read(path.data(), skipReadingFile ? nullptr : m_fileOut);
+        if (!result) {
+            return U8IterItem::Err();
         }
+        hasData = *result;
     }
 
     U8IterFile outFile;
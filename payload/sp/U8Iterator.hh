@@ -2,6 +2,7 @@
 
 #include "U8Cursor.hh"
 
+#include "sp/AutoaddLibrary.hh"
 #include "sp/CircularBuffer.hh"
 #include "sp/HeapAllocator.hh"
 
@@ -49,14 +50,15 @@ public:
 
 class U8Iterator {
 public:
-    U8Iterator(U8Cursor &cursor, std::vector<u8, HeapAllocator<u8>> *fileOut, u32 nodeCount,
-            u32 stringTableStart)
+    // The library may be null, in which case no file has data.
+    U8Iterator(U8Cursor &cursor, AutoaddLibrary *library,
+            std::vector<u8, HeapAllocator<u8>> *fileOut, u32 nodeCount, u32 stringTableStart)
         : m_nodeCount(nodeCount), m_stringTableStart(stringTableStart), m_cursor(cursor),
-          m_fileOut(fileOut){};
+          m_library(library), m_fileOut(fileOut){};
 
     void reset(size_t startPos);
-    // May be null, to just get the dir path.
-    std::array<wchar_t, 64> getPath(const char *name) const;
+    // The path relative to the library root. May be null, to just get the dir path.
+    std::array<char, 64> getPath(const char *name) const;
 
     std::optional<U8IterItem> next(bool skipReadingFile);
 
@@ -68,6 +70,7 @@ private:
     CircularBuffer<U8Node, 10> m_dirStack;
 
     U8Cursor &m_cursor;
+    AutoaddLibrary *m_library;
     std::vector<u8, HeapAllocator<u8>> *m_fileOut;
 };
 
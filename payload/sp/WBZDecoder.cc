@@ -1,79 +1,110 @@
 #include "WBZDecoder.hh"
 
-#include "sp/U8Iterator.hh"
+#include "sp/U8Cursor.hh"
 #include "sp/WU8Library.hh"
 
 #include <common/Bytes.hh>
-#include <egg/core/eggSystem.hh>
-extern "C" {
-#include <revolution.h>
-}
 
+#include <algorithm>
 #include <cstring>
 
 // WBZaWU8a
 constexpr u64 WBZ_MAGIC = 6287687403886164065;
+// WU8a
+constexpr u32 WU8_MAGIC = 0x57553861;
+// Anything bigger than this is assumed to be a corrupted node table.
+constexpr size_t MAX_ARCHIVE_SIZE = 0x4000000 /* 64 MiB */;
 
 namespace SP {
 
-void *WBZDecoder::Alloc(void *heap_erased, int item, int count) {
-    auto *heap = reinterpret_cast<EGG::Heap *>(heap_erased);
-    return heap->alloc(item * count, -0x4);
+void *WBZDecoder::Alloc(void *decoder_erased, int item, int count) {
+    auto *decoder = reinterpret_cast<WBZDecoder *>(decoder_erased);
+    // bzip2 only frees its state at the end, so the total never needs to be decremented.
+    decoder->m_allocatedSize += item * count;
+    decoder->m_peakAllocatedSize =
+            std::max(decoder->m_peakAllocatedSize, decoder->m_allocatedSize);
+    return decoder->m_heap->alloc(item * count, -0x4);
 }
 
-void WBZDecoder::Free(void *heap_erased, void *addr) {
-    auto *heap = reinterpret_cast<EGG::Heap *>(heap_erased);
-    return heap->free(addr);
+void WBZDecoder::Free(void *decoder_erased, void *addr) {
+    auto *decoder = reinterpret_cast<WBZDecoder *>(decoder_erased);
+    return decoder->m_heap->free(addr);
 }
 
-WBZDecoder::WBZDecoder(const u8 * /* src */, size_t /* srcSize */, EGG::Heap *heap)
-    : m_wu8Buf(HeapAllocator<u8>({heap})) {
+WBZDecoder::WBZDecoder(const u8 * /* src */, size_t /* srcSize */, EGG::Heap *heap) {
     memset(&m_stream, 0, sizeof(m_stream));
     m_stream.bzalloc = WBZDecoder::Alloc;
     m_stream.bzfree = WBZDecoder::Free;
-    m_stream.opaque = heap;
+    m_stream.opaque = this;
 
     m_heap = heap;
+    m_startTime = OSGetTime();
     m_done = false;
     m_ok = BZ2_bzDecompressInit(&m_stream, /* Verbosity */ 0, /* Small */ false) == BZ_OK;
 }
 
-WBZDecoder::~WBZDecoder() = default;
+WBZDecoder::~WBZDecoder() {
+    // The stream is only ended by decode once it has either finished or failed.
+    if (m_ok && !m_done) {
+        BZ2_bzDecompressEnd(&m_stream);
+    }
+    if (m_dst != m_header) {
+        delete[] m_dst;
+    }
+}
 
 bool WBZDecoder::decode(const u8 *src, size_t size) {
     assert(m_ok && !m_done);
 
-    std::array<char, 0x5000> decodeBuf;
-
     m_stream.next_in = reinterpret_cast<char *>(const_cast<u8 *>(src));
     m_stream.avail_in = size;
 
-    do {
-        m_stream.next_out = decodeBuf.data();
-        m_stream.avail_out = decodeBuf.size();
-    } while (processOutBuffer(BZ2_bzDecompress(&m_stream), decodeBuf));
+    while (true) {
+        m_stream.next_out = reinterpret_cast<char *>(m_dst + m_dstOffset);
+        m_stream.avail_out = m_dstSize - m_dstOffset;
+        int retCode = BZ2_bzDecompress(&m_stream);
+        m_dstOffset = m_dstSize - m_stream.avail_out;
+
+        if (retCode == BZ_STREAM_END) {
+            m_done = true;
+            break;
+        } else if (retCode != BZ_OK) {
+            m_ok = false;
+            break;
+        } else if (m_stream.avail_out != 0) {
+            // All of the input was consumed.
+            return true;
+        } else if (!grow()) {
+            m_ok = false;
+            break;
+        }
+    }
 
+    BZ2_bzDecompressEnd(&m_stream);
     if (!m_ok) {
-        BZ2_bzDecompressEnd(&m_stream);
         return false;
-    } else if (m_done) {
-        BZ2_bzDecompressEnd(&m_stream);
-        return DecodeWU8(m_wu8Buf);
-    } else {
-        return true;
     }
+
+    // The archive may be smaller than the header or metadata stage buffer.
+    if (m_dst == m_header && !reserve(m_dstOffset)) {
+        m_ok = false;
+        return false;
+    }
+    m_ok = DecodeWU8({m_dst, m_dstOffset}, m_heap);
+    // The WU8 layer is decoded in place once bzip2 is done, so the output is only final here.
+    updateSHA1Sink(m_dst, m_dstOffset, true);
+    logStats();
+    return m_ok;
 }
 
 void WBZDecoder::release(u8 **dst, size_t *dstSize) {
     assert(m_done && m_ok);
 
-    // We have to leak the vector's internal memory, but std::vector
-    // does not supply an interface to avoid deallocating it's memory.
-    u8 *leakedBuf = new (m_heap, 0x20) u8[m_wu8Buf.size()];
-    memcpy(leakedBuf, m_wu8Buf.data(), m_wu8Buf.size());
-
-    *dst = leakedBuf;
-    *dstSize = m_wu8Buf.size();
+    *dst = m_dst;
+    *dstSize = m_dstOffset;
+    m_dst = m_header;
+    m_dstSize = sizeof(m_header);
+    m_dstOffset = 0;
 }
 
 size_t WBZDecoder::headerSize() const {
@@ -92,24 +123,103 @@ bool WBZDecoder::CheckMagic(u64 magic) {
     return magic == WBZ_MAGIC;
 }
 
-bool WBZDecoder::processOutBuffer(int retCode, std::span<char> decodeBuf) {
-    auto writtenSize = std::end(decodeBuf) - m_stream.avail_out;
-    m_wu8Buf.insert(m_wu8Buf.end(), std::begin(decodeBuf), writtenSize);
-
-    if (retCode == BZ_OK) {
-        if (m_stream.avail_out > 0) {
+// Called whenever the current buffer is full but the stream is not done yet.
+bool WBZDecoder::grow() {
+    switch (m_stage) {
+    case Stage::Header: {
+        if (Bytes::Read<u32>(m_header, 0x0) != WU8_MAGIC) {
             return false;
-        } else {
-            return true;
         }
-    } else if (retCode == BZ_STREAM_END) {
-        // Set m_done to signal that we need to move to WU8 decoding.
-        m_done = true;
-        return false;
-    } else {
-        m_ok = false;
+        u32 nodeOffset = Bytes::Read<u32>(m_header, 0x4);
+        u32 metadataSize = Bytes::Read<u32>(m_header, 0x8);
+        if (nodeOffset > MAX_ARCHIVE_SIZE || metadataSize > MAX_ARCHIVE_SIZE - nodeOffset) {
+            return false;
+        }
+        m_stage = Stage::Metadata;
+        return reserve(std::max<size_t>(nodeOffset + metadataSize, m_dstSize + 1));
+    }
+    case Stage::Metadata: {
+        auto archiveSize = getArchiveSize();
+        if (!archiveSize) {
+            return false;
+        }
+        m_stage = Stage::Data;
+        // Leave some room for padding, and for bzip2 to reach the end of the stream without
+        // running out of space.
+        return reserve(std::max(*archiveSize + 0x20, m_dstSize + 1));
+    }
+    case Stage::Data:
+        // Only reached if there is trailing data after the last file, which should be very rare.
+        SP_LOG("WBZ archive is larger than its node table suggests");
+        return reserve(m_dstSize + 0x20000);
+    }
+
+    assert(false);
+}
+
+// Moves the decompressed data to a new buffer of the given size.
+bool WBZDecoder::reserve(size_t size) {
+    size = AlignUp(size, 0x20);
+    if (m_dst != m_header && m_heap->resizeForMBlock(m_dst, size) >= size) {
+        m_allocatedSize += size - m_dstSize;
+        m_dstSize = size;
+        m_peakAllocatedSize = std::max(m_peakAllocatedSize, m_allocatedSize);
+        return true;
+    }
+
+    u8 *dst = new (m_heap, 0x20) u8[size];
+    if (!dst) {
         return false;
     }
+    m_allocatedSize += size;
+    m_peakAllocatedSize = std::max(m_peakAllocatedSize, m_allocatedSize);
+
+    memcpy(dst, m_dst, m_dstOffset);
+    if (m_dst != m_header) {
+        delete[] m_dst;
+        m_allocatedSize -= m_dstSize;
+    }
+    m_dst = dst;
+    m_dstSize = size;
+    return true;
+}
+
+// The archive ends with the data of the last file. The node table is still obfuscated at this
+// point, but the root node is always a directory, which is enough to recover the key.
+std::optional<size_t> WBZDecoder::getArchiveSize() const {
+    u32 nodeOffset = Bytes::Read<u32>(m_dst, 0x4);
+    u32 metadataSize = Bytes::Read<u32>(m_dst, 0x8);
+    if (metadataSize < 12) {
+        return {};
+    }
+
+    u8 key = m_dst[nodeOffset] ^ 0x01;
+    u32 key32 = key * 0x01010101;
+    u32 nodeCount = Bytes::Read<u32>(m_dst, nodeOffset + 0x8) ^ key32;
+    if (nodeCount == 0 || nodeCount > metadataSize / 12) {
+        return {};
+    }
+
+    size_t archiveSize = nodeOffset + metadataSize;
+    for (u32 i = 0; i < nodeCount; i++) {
+        const u8 *node = m_dst + nodeOffset + i * 12;
+        if ((node[0x0] ^ key) != 0x00) {
+            continue;
+        }
+        u32 dataOffset = Bytes::Read<u32>(node, 0x4) ^ key32;
+        u32 size = Bytes::Read<u32>(node, 0x8) ^ key32;
+        if (dataOffset > MAX_ARCHIVE_SIZE || size > MAX_ARCHIVE_SIZE - dataOffset) {
+            return {};
+        }
+        archiveSize = std::max<size_t>(archiveSize, dataOffset + size);
+    }
+    return archiveSize;
+}
+
+void WBZDecoder::logStats() const {
+    OSTime duration = OSGetTime() - m_startTime;
+    SP_LOG("Decoded WBZ archive (%zu KiB) in %u ms, peak %zu KiB allocated", m_dstOffset / 1024,
+            static_cast<u32>(OSTicksToMilliseconds(duration)), m_peakAllocatedSize / 1024);
 }
 
 } // namespace SP
@@ -2,15 +2,23 @@
 
 #include "Decoder.hh"
 
-#include "sp/HeapAllocator.hh"
+#include <egg/core/eggHeap.hh>
+extern "C" {
+#include <revolution.h>
+}
 
-#include <span>
-#include <vector>
 #include <vendor/bzip2/bzlib.h>
 
 namespace SP {
 
 class WBZDecoder : public Decoder {
+private:
+    enum class Stage {
+        Header,   // Staging the U8 header, to find the size of the metadata
+        Metadata, // Staging the node and string tables, to find the size of the archive
+        Data,     // Decompressing straight into the final buffer
+    };
+
 public:
     WBZDecoder(const u8 *src, size_t srcSize, EGG::Heap *heap);
     ~WBZDecoder() override;
@@ -23,15 +31,25 @@ public:
     static bool CheckMagic(u64 magic);
 
 private:
-    bool processOutBuffer(int retCode, std::span<char> decodeBuf);
-    bool decodeWU8();
+    bool grow();
+    bool reserve(size_t size);
+    std::optional<size_t> getArchiveSize() const;
+    void logStats() const;
 
-    static void *Alloc(void *heap_erased, int item, int count);
-    static void Free(void *heap, void *addr);
+    static void *Alloc(void *decoder_erased, int item, int count);
+    static void Free(void *decoder_erased, void *addr);
 
     EGG::Heap *m_heap;
     bz_stream m_stream;
-    std::vector<u8, HeapAllocator<u8>> m_wu8Buf;
+    Stage m_stage = Stage::Header;
+    alignas(0x20) u8 m_header[0x20];
+    u8 *m_dst = m_header;
+    size_t m_dstSize = sizeof(m_header);
+    size_t m_dstOffset = 0;
+
+    size_t m_allocatedSize = 0;
+    size_t m_peakAllocatedSize = 0;
+    OSTime m_startTime;
 
     bool m_ok;
     bool m_done;
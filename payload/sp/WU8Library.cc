@@ -2,8 +2,7 @@
 
 #include "sp/ScopeLock.hh"
 #include "sp/U8Iterator.hh"
-#include "sp/YAZDecoder.hh"
-#include "sp/storage/Storage.hh"
+#include "sp/storage/DecompLoader.hh"
 
 #include <egg/core/eggExpHeap.hh>
 #include <game/system/SaveManager.hh>
@@ -279,29 +278,64 @@ constexpr u32 WU8_MAGIC = 1465202785;
 
 namespace WU8Library {
 
-// Minimum required sizes for vanilla tracks to be ripped and extracted.
-// This avoids using up too much memory by having to reallocate and copy
-// if using a std::vector<u8>, and this lack of reallocation means it can
-// run while heaps are locked (eg: while WU8LibraryPage is shown).
-constexpr size_t CompressedMaxSize = 3000000;
+// Minimum required size for vanilla tracks to be extracted. Each archive in flight gets a heap of
+// its own which is never shared, so that there is no fragmentation and this can run while heaps
+// are locked (eg: while WU8LibraryPage is shown).
 constexpr size_t DecompressedMaxSize = 6000000;
-constexpr size_t ExtractionHeapSize = CompressedMaxSize + DecompressedMaxSize + 1024;
+constexpr size_t SlotHeapSize = DecompressedMaxSize + 0x1000;
+// Archives are decoded while the previous one is being written. The second slot costs 3 MB more
+// than the former 3 MB compressed staging buffer, which DecompLoader's streaming made unnecessary,
+// for about 12 MB in total. A depth of 1 would fit in 6 MB but serialize decoding and writing.
+constexpr u32 PipelineDepth = 2;
+// The library index and the writer's bookkeeping.
+constexpr size_t LibraryIndexMaxSize = 0x10000;
+constexpr size_t ExtractionHeapSize = PipelineDepth * SlotHeapSize + LibraryIndexMaxSize + 1024;
+
+struct WriteJob {
+    EGG::Heap *heap;
+    u32 archiveIndex;
+    u8 *buffer;
+    size_t size;
+};
 
 ExtractionStage s_extractionStage = ExtractionStage::Started;
 std::array<char, 64> s_currentlyExtracting;
+u32 s_completedCount = 0;
+u64 s_completedSize = 0;
+OSTime s_startTime = 0;
 Mutex s_extractionStateLock;
 
 u8 s_extractionStack[1024 * 10];
 OSThread s_extractionThread;
+u8 s_writerStack[1024 * 10];
+OSThread s_writerThread;
+
+WriteJob s_writeJobs[PipelineDepth];
+// One more than there are jobs, for the final null message.
+OSMessage s_writeMessages[PipelineDepth + 1];
+OSMessageQueue s_writeQueue;
+OSMessage s_freeMessages[PipelineDepth];
+OSMessageQueue s_freeQueue;
 
 void *ExtractThread(void *param);
 
 ExtractionState GetExtractionState() {
     ScopeLock<Mutex> g(s_extractionStateLock);
 
+    u32 throughput = 0;
+    if (s_startTime != 0) {
+        OSTime duration = OSGetTime() - s_startTime;
+        if (duration != 0) {
+            throughput = OSSecondsToTicks(s_completedSize / 1024) / duration;
+        }
+    }
+
     return ExtractionState{
             .stage = s_extractionStage,
             .archive = s_currentlyExtracting,
+            .completedCount = s_completedCount,
+            .totalCount = static_cast<u32>(std::size(s_autoaddLibrary)),
+            .throughput = throughput,
     };
 }
 
@@ -316,6 +350,13 @@ void SetExtractionState(ExtractionStage stage, const char *currentFile) {
     }
 }
 
+static void CompleteArchive(u32 count, size_t size) {
+    ScopeLock<Mutex> g(s_extractionStateLock);
+
+    s_completedCount = count;
+    s_completedSize += size;
+}
+
 bool ContainsWBZ(SP::Storage::DirHandle &dir);
 
 bool ContainsWBZ(SP::Storage::NodeId dirId) {
@@ -364,50 +405,149 @@ void StartExtraction(EGG::Heap *mem2) {
     u8 *stackTop = s_extractionStack + stackSize;
 
     OSCreateThread(&s_extractionThread, ExtractThread, extractionHeap, stackTop, stackSize, 25, 0);
+    Storage::SetIOPriority(&s_extractionThread, Storage::IOPriority::Background);
     OSResumeThread(&s_extractionThread);
     OSDetachThread(&s_extractionThread);
 }
 
-void *ExtractThread(void *param) {
-    auto *extractionHeap = reinterpret_cast<EGG::ExpHeap *>(param);
-    assert(Storage::CreateDir(L"autoadd/", true));
-
-    void *compressedBlock = extractionHeap->alloc(CompressedMaxSize, -0x20);
-    void *decompressedBlock = extractionHeap->alloc(DecompressedMaxSize, -0x20);
-    std::span<u8> compressedBuf(reinterpret_cast<u8 *>(compressedBlock), CompressedMaxSize);
-    std::span<u8> decompressedBuf(reinterpret_cast<u8 *>(decompressedBlock), DecompressedMaxSize);
-
+static void WriteArchive(AutoaddLibraryWriter &writer, const WriteJob &job) {
     u32 u8MagicInt = 0;
     memcpy(&u8MagicInt, U8_MAGIC, 4);
 
-    auto *saveManager = System::SaveManager::Instance();
-    auto *dvdStorage = SP::Storage::GetStorage(SP::Storage::StorageType::DVD);
-    for (auto pair : s_autoaddLibrary) {
-        auto archive = pair.first.first;
-        auto courseId = static_cast<Registry::Course>(pair.first.second);
-        auto files = pair.second;
+    auto files = s_autoaddLibrary[job.archiveIndex].second;
 
-        wchar_t sourcePath[64];
-        swprintf(sourcePath, sizeof(sourcePath), L"ro:/Race/Course/%s.szs", archive);
+    U8Cursor cursor{{job.buffer, job.size}};
+    auto header = cursor.readU8Header().value();
+    assert(header.magic == u8MagicInt);
 
-        auto fileHandle = dvdStorage->open(sourcePath, "r");
-        if (!fileHandle) {
-            panic("Unable to load original game file!");
+    cursor.setPosition(header.nodeOffset);
+    auto rootNode = cursor.readNode().value();
+    cursor.setPosition(header.nodeOffset);
+
+    auto nodeHeaderSize = rootNode.size * 12;
+    auto stringTableStart = header.nodeOffset + nodeHeaderSize;
+
+    U8Iterator iterator{cursor, nullptr, nullptr, rootNode.size, stringTableStart};
+    std::optional<U8IterItem> item;
+
+    u8 filesToExtract = files.size();
+    while ((item = iterator.next(/* skipReadingFile */ true))) {
+        if (item->isDir) {
+            continue;
+        } else if (item->isErr || !item->file) {
+            panic("Error while iterating");
         }
 
-        SetExtractionState(ExtractionStage::Ripping, archive);
-        assert(fileHandle->read(compressedBuf.data(), fileHandle->size(), 0));
+        auto path = iterator.getPath(item->file->name);
+        auto strcmpPred = [&](const char *file) { return !strcmp(file, path.data()); };
+        if (std::find_if(files.begin(), files.end(), strcmpPred) == files.end()) {
+            // File is not needed for the auto-add library.
+            continue;
+        }
+
+        filesToExtract -= 1;
+
+        auto &node = item->file->node;
+        if (!writer.add(path.data(), &job.buffer[node.dataOffset], node.size)) {
+            panic("Unable to write the auto-add library!");
+        }
+    }
+
+    // panic is skipped when the file has already been found.
+    if (filesToExtract != 0) {
+        panic("Unable to find all required files!\n%hhd files left", filesToExtract);
+    }
+}
+
+static void *WriteThread(void *param) {
+    auto *writer = reinterpret_cast<AutoaddLibraryWriter *>(param);
+
+    while (true) {
+        OSMessage message;
+        OSReceiveMessage(&s_writeQueue, &message, OS_MESSAGE_BLOCK);
+        auto *job = reinterpret_cast<WriteJob *>(message);
+        if (!job) {
+            return nullptr;
+        }
+
+        WriteArchive(*writer, *job);
+        if (!writer->checkpoint(job->archiveIndex + 1)) {
+            panic("Unable to write the auto-add library!");
+        }
+        CompleteArchive(job->archiveIndex + 1, job->size);
+
+        OSSendMessage(&s_freeQueue, job, OS_MESSAGE_BLOCK);
+    }
+}
+
+static WriteJob *AcquireJob(u32 archiveIndex) {
+    OSMessage message;
+    if (!OSReceiveMessage(&s_freeQueue, &message, OS_MESSAGE_NOBLOCK)) {
+        // The writer is behind, which means the previous archive is still being written.
+        auto archive = s_autoaddLibrary[archiveIndex - 1].first.first;
+        SetExtractionState(ExtractionStage::Writing, archive);
+        OSReceiveMessage(&s_freeQueue, &message, OS_MESSAGE_BLOCK);
+    }
+    return reinterpret_cast<WriteJob *>(message);
+}
+
+// Returns false if a vanilla course was replaced. Archives are read, decoded and hashed by
+// DecompLoader, which overlaps the three, then written on the writer thread.
+static bool ExtractLibrary(EGG::Heap *heap) {
+    u32 entryCount = 0;
+    u32 stringTableSize = 0;
+    for (auto pair : s_autoaddLibrary) {
+        for (auto *file : pair.second) {
+            entryCount++;
+            stringTableSize += strlen(file) + 1;
+        }
+    }
+    AutoaddLibraryWriter writer(heap, entryCount, stringTableSize);
+
+    OSInitMessageQueue(&s_writeQueue, s_writeMessages, std::size(s_writeMessages));
+    OSInitMessageQueue(&s_freeQueue, s_freeMessages, std::size(s_freeMessages));
+    for (u32 i = 0; i < PipelineDepth; i++) {
+        s_writeJobs[i].heap = EGG::ExpHeap::Create(SlotHeapSize, heap, 0);
+        s_writeJobs[i].buffer = nullptr;
+        OSSendMessage(&s_freeQueue, &s_writeJobs[i], OS_MESSAGE_NOBLOCK);
+    }
+
+    u32 startIndex = writer.progress();
+    {
+        ScopeLock<Mutex> g(s_extractionStateLock);
+        s_completedCount = startIndex;
+        s_completedSize = 0;
+        s_startTime = OSGetTime();
+    }
+
+    u8 *stackTop = s_writerStack + sizeof(s_writerStack);
+    OSCreateThread(&s_writerThread, WriteThread, &writer, stackTop, sizeof(s_writerStack), 25, 0);
+    Storage::SetIOPriority(&s_writerThread, Storage::IOPriority::Background);
+    OSResumeThread(&s_writerThread);
+
+    bool ok = true;
+    auto *saveManager = System::SaveManager::Instance();
+    for (u32 i = startIndex; i < std::size(s_autoaddLibrary); i++) {
+        auto archive = s_autoaddLibrary[i].first.first;
+        auto courseId = static_cast<Registry::Course>(s_autoaddLibrary[i].first.second);
 
-        SetExtractionState(ExtractionStage::Decompressing, archive);
-        auto decompressedSize = YAZDecoder::Decode(compressedBuf.data(), fileHandle->size(),
-                decompressedBuf.data(), decompressedBuf.size())
-                                        .value();
+        auto &job = *AcquireJob(i);
+        delete[] job.buffer;
+        job.buffer = nullptr;
+
+        SetExtractionState(ExtractionStage::Ripping, archive);
+        char sourcePath[64];
+        snprintf(sourcePath, sizeof(sourcePath), "Race/Course/%s.szs", archive);
+        NETSHA1Context shaContext;
+        NETSHA1Init(&shaContext);
+        if (!Storage::DecompLoader::LoadRO(sourcePath, &job.buffer, &job.size, job.heap,
+                    Storage::StorageType::DVD, &shaContext)) {
+            panic("Unable to load original game file!");
+        }
 
         if (static_cast<u32>(courseId) < 42) {
+            SetExtractionState(ExtractionStage::Processing, archive);
             Sha1 courseSha;
-            NETSHA1Context shaContext;
-            NETSHA1Init(&shaContext);
-            NETSHA1Update(&shaContext, decompressedBuf.data(), decompressedSize);
             NETSHA1GetDigest(&shaContext, &courseSha);
 
             auto vanillaSha = saveManager->vanillaSHA1(courseId);
@@ -418,76 +558,39 @@ void *ExtractThread(void *param) {
                         courseShaStr.data());
 
                 SetExtractionState(ExtractionStage::ReplacedCourse, archive);
+                ok = false;
                 break;
             }
         }
 
-        SetExtractionState(ExtractionStage::Processing, archive);
-        U8Cursor cursor{{decompressedBuf.data(), decompressedSize}};
-        auto header = cursor.readU8Header().value();
-        assert(header.magic == u8MagicInt);
-
-        cursor.setPosition(header.nodeOffset);
-        auto rootNode = cursor.readNode().value();
-        cursor.setPosition(header.nodeOffset);
-
-        auto nodeHeaderSize = rootNode.size * 12;
-        auto stringTableStart = header.nodeOffset + nodeHeaderSize;
-
-        U8Iterator iterator{cursor, nullptr, rootNode.size, stringTableStart};
-        std::optional<U8IterItem> item;
-
-        u8 filesToExtract = files.size();
-        CircularBuffer<const char *, 3> dirStack;
-        // We must set skipReadingFile to true as we aren't passing an out buffer.
-        while ((item = iterator.next(/* skipReadingFile */ true))) {
-            if (item->isDir) {
-                auto dirPath = iterator.getPath(nullptr);
-                assert(Storage::CreateDir(dirPath.data(), true));
-                continue;
-            } else if (item->isErr || !item->file) {
-                panic("Error while iterating");
-            }
-
-            char path[64];
-            std::array<wchar_t, 64> pathWide = iterator.getPath(item->file->name);
-            if (snprintf(path, sizeof(path), "%ls", pathWide.data()) <= 0) {
-                panic("Overflowed path");
-            }
-
-            const char *pathClean = path + strlen("autoadd/");
-            auto strcmpPred = [&](const char *file) { return !strcmp(file, pathClean); };
-            if (std::find_if(files.begin(), files.end(), strcmpPred) == files.end()) {
-                // File is not needed for the auto-add library.
-                continue;
-            };
-
-            filesToExtract -= 1;
-            if (item->file->hasData) {
-                continue;
-            }
+        job.archiveIndex = i;
+        OSSendMessage(&s_writeQueue, &job, OS_MESSAGE_BLOCK);
+    }
 
-            SetExtractionState(ExtractionStage::Writing, pathClean);
-            auto file = Storage::Open(pathWide.data(), "w").value();
-            auto filePtr = &decompressedBuf[item->file->node.dataOffset];
+    OSSendMessage(&s_writeQueue, nullptr, OS_MESSAGE_BLOCK);
+    OSJoinThread(&s_writerThread, nullptr);
 
-            assert(file.write(filePtr, item->file->node.size, 0));
-            SetExtractionState(ExtractionStage::Processing, archive);
-        }
+    for (u32 i = 0; i < PipelineDepth; i++) {
+        delete[] s_writeJobs[i].buffer;
+        s_writeJobs[i].buffer = nullptr;
+        s_writeJobs[i].heap->destroy();
+    }
 
-        // panic is skipped when the file has already been found.
-        if (filesToExtract != 0) {
-            panic("Unable to find all required files!\n%hhd files left", filesToExtract);
-        }
+    if (ok && !writer.finish()) {
+        panic("Unable to write the auto-add library!");
     }
+    return ok;
+}
 
-    if (GetExtractionState().stage != ExtractionStage::ReplacedCourse) {
+void *ExtractThread(void *param) {
+    auto *extractionHeap = reinterpret_cast<EGG::ExpHeap *>(param);
+    assert(Storage::CreateDir(L"autoadd/", true));
+
+    if (ExtractLibrary(extractionHeap)) {
         Storage::Open(L"autoadd/.finished", "w").value();
         SetExtractionState(ExtractionStage::Finished, nullptr);
     }
 
-    extractionHeap->free(decompressedBlock);
-    extractionHeap->free(compressedBlock);
     extractionHeap->destroy();
     return nullptr;
 }
@@ -499,8 +602,48 @@ u8 DeriveStartingKey(u32 size) {
     return p[0] ^ p[1] ^ p[2] ^ p[3];
 }
 
-bool DecodeWU8(std::vector<u8, HeapAllocator<u8>> &wu8Buf) {
-    U8Cursor cursor({wu8Buf.begin(), wu8Buf.end()});
+template <bool HasPattern>
+static void XorSpan(u8 *dst, const u8 *pattern, size_t size, u32 key) {
+    size_t i = 0;
+    // Broadway handles misaligned word loads in hardware, so only the destination is aligned and
+    // the pattern is read at whatever offset it ends up at.
+    for (; i < size && reinterpret_cast<uintptr_t>(dst + i) % sizeof(u32) != 0; i++) {
+        dst[i] ^= (HasPattern ? pattern[i] : 0) ^ key;
+    }
+    for (; i + 2 * sizeof(u32) <= size; i += 2 * sizeof(u32)) {
+        u32 words[2];
+        memcpy(words, dst + i, sizeof(words));
+        if constexpr (HasPattern) {
+            u32 patternWords[2];
+            memcpy(patternWords, pattern + i, sizeof(patternWords));
+            words[0] ^= patternWords[0];
+            words[1] ^= patternWords[1];
+        }
+        words[0] ^= key;
+        words[1] ^= key;
+        memcpy(dst + i, words, sizeof(words));
+    }
+    for (; i < size; i++) {
+        dst[i] ^= (HasPattern ? pattern[i] : 0) ^ key;
+    }
+}
+
+void XorWU8(std::span<u8> buf, std::span<const u8> pattern, u8 key) {
+    u32 key32 = key * 0x01010101;
+    if (pattern.empty()) {
+        XorSpan<false>(buf.data(), nullptr, buf.size(), key32);
+        return;
+    }
+
+    // Split the buffer at every wrap-around of the pattern so that each span is contiguous.
+    for (size_t offset = 0; offset < buf.size(); offset += pattern.size()) {
+        size_t size = std::min(buf.size() - offset, pattern.size());
+        XorSpan<true>(buf.data() + offset, pattern.data(), size, key32);
+    }
+}
+
+bool DecodeWU8(std::span<u8> wu8Buf, EGG::Heap *heap) {
+    U8Cursor cursor(wu8Buf);
 
     auto header = cursor.readU8Header().value();
     assert(header.magic == WU8_MAGIC);
@@ -511,9 +654,7 @@ bool DecodeWU8(std::vector<u8, HeapAllocator<u8>> &wu8Buf) {
     u8 derivedKey = startingKey;
 
     // Initial pass, XOR all node and string table bytes with starting key
-    for (u32 i = header.nodeOffset; i < (header.nodeOffset + header.metaSize); i++) {
-        wu8Buf[i] ^= startingKey;
-    }
+    XorWU8(wu8Buf.subspan(header.nodeOffset, header.metaSize), {}, startingKey);
 
     cursor.setPosition(header.nodeOffset);
     auto rootNode = cursor.readNode();
@@ -522,39 +663,73 @@ bool DecodeWU8(std::vector<u8, HeapAllocator<u8>> &wu8Buf) {
     auto nodeHeaderSize = rootNode->size * 12;
     auto stringTableStart = header.nodeOffset + nodeHeaderSize;
 
-    std::vector<u8, HeapAllocator<u8>> originalData({wu8Buf.get_allocator()});
-    U8Iterator iterator(cursor, &originalData, rootNode->size, stringTableStart);
+    AutoaddLibrary library(heap);
+    std::vector<u8, HeapAllocator<u8>> originalData(HeapAllocator<u8>({heap}));
+
+    // The library files are read in batches, each with one vectored read rather than one read per
+    // file. The WU8 files are about the size of the library files, which bounds the batch size.
+    constexpr u32 BATCH_MAX_COUNT = 16;
+    constexpr u32 BATCH_MAX_SIZE = 0x100000 /* 1 MiB */;
+    std::array<char, 64> batchPaths[BATCH_MAX_COUNT];
+    U8Node batchNodes[BATCH_MAX_COUNT];
+    u32 batchCount = 0;
+    u32 batchSize = 0;
+    auto xorBatch = [&]() {
+        const char *paths[BATCH_MAX_COUNT];
+        for (u32 i = 0; i < batchCount; i++) {
+            paths[i] = batchPaths[i].data();
+        }
+        std::optional<u32> sizes[BATCH_MAX_COUNT];
+        if (!library.readMany(paths, batchCount, &originalData, sizes)) {
+            panic("Error while reading the auto-add library");
+        }
+
+        u32 offset = 0;
+        for (u32 i = 0; i < batchCount; i++) {
+            if (!sizes[i]) {
+                continue;
+            }
+
+            std::span<const u8> original(originalData.data() + offset, *sizes[i]);
+            offset += *sizes[i];
+            derivedKey ^= original[original.size() / 2] ^ original[original.size() / 3] ^
+                    original[original.size() / 4];
+
+            auto &node = batchNodes[i];
+            XorWU8(wu8Buf.subspan(node.dataOffset, node.size), original, startingKey);
+        }
+        batchCount = 0;
+        batchSize = 0;
+    };
+
+    U8Iterator batchIterator(cursor, nullptr, nullptr, rootNode->size, stringTableStart);
     std::optional<U8IterItem> item;
 
     SP_LOG("Starting decode path 1 (XOR all object files with auto-add library)");
-    while ((item = iterator.next(false))) {
+    while ((item = batchIterator.next(true))) {
         if (item->isDir) {
             continue;
         } else if (item->isErr || !item->file) {
             panic("Error while iterating");
-        } else if (!item->file->hasData) {
-            continue;
         }
 
-        auto originalSize = originalData.size();
-        derivedKey ^= originalData[originalSize / 2] ^ originalData[originalSize / 3] ^
-                originalData[originalSize / 4];
-
-        size_t archiveIndex = 0;
-        size_t originalIndex = 0;
-        while (archiveIndex != item->file->node.size) {
-            if (originalIndex == originalSize) {
-                originalIndex = 0;
-            }
-
-            auto archiveOffset = item->file->node.dataOffset + archiveIndex;
-            wu8Buf[archiveOffset] ^= startingKey ^ originalData[originalIndex];
-
-            originalIndex++;
-            archiveIndex++;
+        auto &node = item->file->node;
+        if (batchCount != 0 && batchSize + node.size > BATCH_MAX_SIZE) {
+            xorBatch();
+        }
+        batchPaths[batchCount] = batchIterator.getPath(item->file->name);
+        batchNodes[batchCount++] = node;
+        batchSize += node.size;
+        if (batchCount == BATCH_MAX_COUNT) {
+            xorBatch();
         }
     }
+    if (batchCount != 0) {
+        xorBatch();
+    }
 
+    // This time only to know which files the library has.
+    U8Iterator iterator(cursor, &library, nullptr, rootNode->size, stringTableStart);
     iterator.reset(header.nodeOffset);
 
     SP_LOG("Starting decode pass 2 (XOR all non-object files with derived key %hhu)", derivedKey);
@@ -568,11 +743,12 @@ bool DecodeWU8(std::vector<u8, HeapAllocator<u8>> &wu8Buf) {
         }
 
         auto &node = item->file->node;
-        for (auto i = node.dataOffset; i < (node.dataOffset + node.size); i++) {
-            wu8Buf[i] ^= derivedKey;
-        }
+        XorWU8(wu8Buf.subspan(node.dataOffset, node.size), {}, derivedKey);
     }
 
+    SP_LOG("Resolved auto-add library files with %u opens (%s)", library.openCount(),
+            library.isPacked() ? "packed" : "loose");
+
     memcpy(wu8Buf.data(), U8_MAGIC, 4);
     return true;
 }
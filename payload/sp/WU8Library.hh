@@ -2,6 +2,7 @@
 
 #include "sp/HeapAllocator.hh"
 
+#include <span>
 #include <vector>
 
 namespace SP {
@@ -11,7 +12,6 @@ namespace WU8Library {
 enum class ExtractionStage {
     Started,
     Ripping,
-    Decompressing,
     Processing,
     Writing,
     Finished,
@@ -21,6 +21,9 @@ enum class ExtractionStage {
 struct ExtractionState {
     ExtractionStage stage;
     std::array<char, 64> archive;
+    u32 completedCount;
+    u32 totalCount;
+    u32 throughput; // KiB/s of decompressed archives
 };
 
 bool ShouldExtract();
@@ -29,7 +32,11 @@ ExtractionState GetExtractionState();
 
 } // namespace WU8Library
 
+// XORs buf with key and pattern, restarting pattern whenever its end is reached. An empty pattern
+// XORs buf with key alone.
+void XorWU8(std::span<u8> buf, std::span<const u8> pattern, u8 key);
+
 // Decodes the WU8 format inplace.
-bool DecodeWU8(std::vector<u8, HeapAllocator<u8>> &wu8Buf);
+bool DecodeWU8(std::span<u8> wu8Buf, EGG::Heap *heap);
 
 } // namespace SP
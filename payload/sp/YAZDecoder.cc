@@ -3,6 +3,7 @@
 #include <common/Bytes.hh>
 
 #include <algorithm>
+#include <cstring>
 
 namespace SP {
 
@@ -18,7 +19,8 @@ YAZDecoder::YAZDecoder(const u8 *src, size_t srcSize, EGG::Heap *heap) {
     m_dst = new (heap, 0x20) u8[m_dstSize];
 }
 
-YAZDecoder::YAZDecoder(u8 *dst, size_t dstSize) : m_owning(false), m_dst(dst), m_dstSize(dstSize) {}
+YAZDecoder::YAZDecoder(u8 *dst, size_t dstSize, bool bulk)
+    : m_owning(false), m_dst(dst), m_dstSize(dstSize), m_bulk(bulk) {}
 
 YAZDecoder::~YAZDecoder() {
     if (m_owning) {
@@ -83,13 +85,61 @@ bool YAZDecoder::process(const u8 *src, size_t &srcOffset) {
     assert(false);
 }
 
+// Only called on group boundaries. Decodes as many complete groups as are guaranteed to fit in
+// both the remaining input and output, leaving the edges to the byte-wise state machine.
+bool YAZDecoder::processGroups(const u8 *src, size_t srcSize, size_t &srcOffset) {
+    while (srcSize - srcOffset >= MAX_GROUP_SRC_SIZE &&
+            m_dstSize - m_dstOffset >= MAX_GROUP_DST_SIZE) {
+        u8 groupHeader = src[srcOffset++];
+        for (u8 i = 0; i < 8; i++, groupHeader <<= 1) {
+            if (groupHeader & 0x80) {
+                m_dst[m_dstOffset++] = src[srcOffset++];
+                continue;
+            }
+
+            u8 val0 = src[srcOffset++];
+            u8 val1 = src[srcOffset++];
+            size_t refOffset = ((val0 & 0xf) << 8 | val1) + 0x1;
+            size_t refSize = val0 >> 4;
+            if (refSize == 0x0) {
+                refSize = src[srcOffset++] + 0x12;
+            } else {
+                refSize += 0x2;
+            }
+            if (refOffset > m_dstOffset) {
+                return false;
+            }
+
+            u8 *dst = m_dst + m_dstOffset;
+            const u8 *ref = dst - refOffset;
+            if (refOffset >= refSize) {
+                memcpy(dst, ref, refSize);
+            } else {
+                // Overlapping references repeat the last refOffset bytes, so they must be copied
+                // front to back.
+                for (size_t j = 0; j < refSize; j++) {
+                    dst[j] = ref[j];
+                }
+            }
+            m_dstOffset += refSize;
+        }
+
+        updateSHA1Sink(m_dst, m_dstOffset, false);
+    }
+
+    return true;
+}
+
 bool YAZDecoder::decode(const u8 *src, size_t srcSize) {
     assert(ok() && !done());
 
     size_t srcOffset = 0;
-    do {
+    while (true) {
+        updateSHA1Sink(m_dst, m_dstOffset, false);
+
         if (m_dstOffset == m_dstSize) {
             if (m_state == State::GroupHeader) {
+                updateSHA1Sink(m_dst, m_dstOffset, true);
                 return true;
             }
             m_ok = false;
@@ -99,9 +149,24 @@ bool YAZDecoder::decode(const u8 *src, size_t srcSize) {
         if (srcOffset == srcSize &&
                 ((m_state != State::GroupHeader || m_groupHeaderIndex == 7) &&
                         m_state != State::RefCopy)) {
+            updateSHA1Sink(m_dst, m_dstOffset, true);
             return true;
         }
-    } while (process(src, srcOffset));
+
+        if (m_bulk && m_state == State::GroupHeader && m_groupHeaderIndex == 7) {
+            size_t dstOffset = m_dstOffset;
+            if (!processGroups(src, srcSize, srcOffset)) {
+                break;
+            }
+            if (m_dstOffset != dstOffset) {
+                continue;
+            }
+        }
+
+        if (!process(src, srcOffset)) {
+            break;
+        }
+    }
 
     m_ok = false;
     return false;
@@ -143,13 +208,15 @@ std::optional<u32> YAZDecoder::GetDecodedSize(const u8 *src, size_t srcSize) {
     return Bytes::Read<u32>(src, 0x4);
 }
 
-std::optional<u32> YAZDecoder::Decode(const u8 *src, size_t srcSize, u8 *dst, size_t dstSize) {
+std::optional<u32> YAZDecoder::Decode(const u8 *src, size_t srcSize, u8 *dst, size_t dstSize,
+        bool bulk, NETSHA1Context *sha1Sink) {
     auto tmp = GetDecodedSize(src, srcSize);
     if (!tmp) {
         return {};
     }
     dstSize = std::min(static_cast<u32>(dstSize), *tmp);
-    YAZDecoder decoder(dst, dstSize);
+    YAZDecoder decoder(dst, dstSize, bulk);
+    decoder.setSHA1Sink(sha1Sink);
     if (!decoder.decode(src + HEADER_SIZE, srcSize - HEADER_SIZE)) {
         return {};
     }
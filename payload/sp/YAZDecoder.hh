@@ -28,14 +28,17 @@ public:
 
     static bool CheckMagic(u32 magic);
     static std::optional<u32> GetDecodedSize(const u8 *src, size_t srcSize);
-    static std::optional<u32> Decode(const u8 *src, size_t srcSize, u8 *dst, size_t dstSize);
+    // The bulk path decodes whole groups at once and is only disabled for benchmarking.
+    static std::optional<u32> Decode(const u8 *src, size_t srcSize, u8 *dst, size_t dstSize,
+            bool bulk = true, NETSHA1Context *sha1Sink = nullptr);
 
     static const size_t HEADER_SIZE = 4 * sizeof(u32);
 
 private:
-    YAZDecoder(u8 *dst, size_t dstSize);
+    YAZDecoder(u8 *dst, size_t dstSize, bool bulk);
 
     bool process(const u8 *src, size_t &srcOffset);
+    bool processGroups(const u8 *src, size_t srcSize, size_t &srcOffset);
 
     bool m_owning = true;
     u8 *m_dst = nullptr;
@@ -47,9 +50,14 @@ private:
     u16 m_refSize;
     u16 m_refOffset;
     bool m_ok = true;
+    bool m_bulk = true;
 
     static const u32 YAZ0_MAGIC;
     static const u32 YAZ1_MAGIC;
+
+    // A group is a header followed by up to 8 chunks of up to 3 bytes each.
+    static const size_t MAX_GROUP_SRC_SIZE = 1 + 8 * 3;
+    static const size_t MAX_GROUP_DST_SIZE = 8 * (0xff + 0x12);
 };
 
 } // namespace SP
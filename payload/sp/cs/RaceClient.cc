@@ -7,6 +7,7 @@
 #include <game/system/RaceManager.hh>
 #include <game/ui/SectionManager.hh>
 
+#include <algorithm>
 #include <cmath>
 
 namespace SP {
@@ -49,50 +50,52 @@ void RaceClient::calcWrite() {
         m_socket.write(buffer, stream.bytes_written, m_connection);
     }
 
+    // Shift the previous frames back, so that each datagram also covers the ones before it.
+    auto &frames = m_upstream.frames;
+    std::copy_backward(frames, frames + std::size(frames) - 1, frames + std::size(frames));
+    m_upstream.frames_count = std::min<pb_size_t>(m_upstream.frames_count + 1, std::size(frames));
+
     auto &raceScenario = System::RaceConfig::Instance()->raceScenario();
-    RoomRequest request;
-    request.which_request = RoomRequest_race_tag;
-    request.request.race.time = System::RaceManager::Instance()->time();
-    request.request.race.serverTime = m_frame ? m_frame->time : 0;
-    request.request.race.players_count = raceScenario.localPlayerCount;
+    PackedRace &race = frames[0];
+    race.time = System::RaceManager::Instance()->time();
+    race.serverTime = m_frame ? m_frame->time : 0;
+    race.players_count = raceScenario.localPlayerCount;
     for (u8 i = 0; i < raceScenario.localPlayerCount; i++) {
         u8 playerId = raceScenario.screenPlayerIds[i];
         auto *player = System::RaceManager::Instance()->player(playerId);
         auto &inputState = player->padProxy()->currentRaceInputState();
-        request.request.race.players[i].inputState.accelerate = inputState.accelerate;
-        request.request.race.players[i].inputState.brake = inputState.brake;
-        request.request.race.players[i].inputState.item = inputState.item;
-        request.request.race.players[i].inputState.drift = inputState.drift;
-        request.request.race.players[i].inputState.brakeDrift = inputState.brakeDrift;
-        request.request.race.players[i].inputState.stickX = inputState.rawStick.x;
-        request.request.race.players[i].inputState.stickY = inputState.rawStick.y;
-        request.request.race.players[i].inputState.trick = inputState.rawTrick;
+        PlayerFrame frame;
+        frame.inputState.accelerate = inputState.accelerate;
+        frame.inputState.brake = inputState.brake;
+        frame.inputState.item = inputState.item;
+        frame.inputState.drift = inputState.drift;
+        frame.inputState.brakeDrift = inputState.brakeDrift;
+        frame.inputState.stickX = inputState.rawStick.x;
+        frame.inputState.stickY = inputState.rawStick.y;
+        frame.inputState.trick = inputState.rawTrick;
         auto *object = Kart::KartObjectManager::Instance()->object(playerId);
-        request.request.race.players[i].timeBeforeRespawn = object->getTimeBeforeRespawn();
-        request.request.race.players[i].timeInRespawn = object->getTimeInRespawn();
-        request.request.race.players[i].timesBeforeBoostEnd_count = 3;
+        frame.timeBeforeRespawn = object->getTimeBeforeRespawn();
+        frame.timeInRespawn = object->getTimeInRespawn();
+        frame.timesBeforeBoostEnd_count = 3;
         for (u32 j = 0; j < 3; j++) {
-            request.request.race.players[i].timesBeforeBoostEnd[j] =
-                    object->getTimeBeforeBoostEnd(j * 2);
+            frame.timesBeforeBoostEnd[j] = object->getTimeBeforeBoostEnd(j * 2);
         }
-        request.request.race.players[i].pos = *object->getPos();
-        request.request.race.players[i].mainRot = *object->getMainRot();
-        request.request.race.players[i].internalSpeed = object->getInternalSpeed();
+        frame.pos = *object->getPos();
+        frame.mainRot = *object->getMainRot();
+        frame.internalSpeed = object->getInternalSpeed();
+        // The server has no history of client frames, so these are always absolute.
+        RaceFrame::Pack(frame, {}, race.players[i]);
     }
 
-    u8 buffer[RoomRequest_size];
+    u8 buffer[RaceClientFrame_size];
     pb_ostream_t stream = pb_ostream_from_buffer(buffer, sizeof(buffer));
 
-    assert(pb_encode(&stream, RoomRequest_fields, &request));
+    assert(pb_encode(&stream, RaceClientFrame_fields, &m_upstream));
 
-    auto *sectionManager = UI::SectionManager::Instance();
-    auto res = m_roomClient.socket().write(buffer, stream.bytes_written);
-    if (!res) {
-        UI::MessageInfo info;
-        info.strings[0] = res.error();
-        return sectionManager->transitionToError(30003, info);
-    }
+    // A lost datagram is made up for by the next ones, so a failed write isn't fatal.
+    m_socket.write(buffer, stream.bytes_written, m_connection);
 
+    auto *sectionManager = UI::SectionManager::Instance();
     if (!m_roomClient.socket().poll()) {
         sectionManager->transitionToError(30001);
     }
@@ -102,7 +105,7 @@ void RaceClient::calcRead() {
     ConnectionGroup connectionGroup(*this);
 
     while (true) {
-        u8 buffer[RaceServerFrame_size];
+        u8 buffer[PackedRaceServerFrame_size];
         auto read = m_socket.read(buffer, sizeof(buffer), connectionGroup);
         if (!read) {
             break;
@@ -110,14 +113,23 @@ void RaceClient::calcRead() {
 
         pb_istream_t stream = pb_istream_from_buffer(buffer, read->size);
 
+        PackedRaceServerFrame packed;
+        if (!pb_decode(&stream, PackedRaceServerFrame_fields, &packed)) {
+            continue;
+        }
+
         RaceServerFrame frame;
-        if (!pb_decode(&stream, RaceServerFrame_fields, &frame)) {
+        RaceFrame::Pos positions[12];
+        if (!unpackFrame(packed, frame, positions)) {
             continue;
         }
 
         if (isFrameValid(frame)) {
             m_frameCount++;
             m_frame = frame;
+            auto &entry = m_history[frame.time % m_history.size()];
+            entry.time = frame.time;
+            std::copy_n(positions, frame.players_count, entry.positions);
         }
     }
 
@@ -162,13 +174,37 @@ RaceClient *RaceClient::Instance() {
 
 RaceClient::RaceClient(RoomClient &roomClient)
     : m_roomClient(roomClient),
-      m_socket("race    ", {}), m_connection{roomClient.ip(), roomClient.port(),
-                                        roomClient.keypair()} {}
+      m_socket("race    ", {}),
+      m_connection(Net::UnreliableSocket::MakeConnection(roomClient.ip(), roomClient.port(),
+              roomClient.keypair())) {}
 
 RaceClient::~RaceClient() {
     hydro_memzero(&m_connection, sizeof(m_connection));
 }
 
+bool RaceClient::unpackFrame(const PackedRaceServerFrame &packed, RaceServerFrame &frame,
+        RaceFrame::Pos (&positions)[12]) {
+    const RaceFrame::Pos *base = nullptr;
+    if (packed.has_baseTime) {
+        // The base frame may have been overwritten by a newer one, or not been valid at all.
+        auto &entry = m_history[packed.baseTime % m_history.size()];
+        if (entry.time != packed.baseTime) {
+            return false;
+        }
+        base = entry.positions;
+    }
+
+    frame.time = packed.time;
+    frame.playerTimes_count = packed.playerTimes_count;
+    std::copy_n(packed.playerTimes, packed.playerTimes_count, frame.playerTimes);
+    frame.players_count = packed.players_count;
+    for (u32 i = 0; i < packed.players_count; i++) {
+        positions[i] = RaceFrame::Unpack(packed.players[i], base ? base[i] : RaceFrame::Pos{},
+                frame.players[i]);
+    }
+    return true;
+}
+
 bool RaceClient::isFrameValid(const RaceServerFrame &frame) {
     if (m_frame && frame.time <= m_frame->time) {
         return false;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "sp/CircularBuffer.hh"
+#include "sp/cs/RaceFrame.hh"
 #include "sp/cs/RaceManager.hh"
 #include "sp/cs/RoomClient.hh"
 
@@ -34,9 +35,17 @@ private:
         RaceClient &m_client;
     };
 
+    // The quantized positions of the last valid frames, which the server sends deltas against.
+    struct HistoryEntry {
+        std::optional<u32> time;
+        RaceFrame::Pos positions[12];
+    };
+
     RaceClient(RoomClient &roomClient);
     ~RaceClient();
 
+    bool unpackFrame(const PackedRaceServerFrame &packed, RaceServerFrame &frame,
+            RaceFrame::Pos (&positions)[12]);
     bool isFrameValid(const RaceServerFrame &frame);
 
     static bool IsVec3Valid(const PlayerFrame_Vec3 &v);
@@ -46,8 +55,10 @@ private:
     RoomClient &m_roomClient;
     Net::UnreliableSocket m_socket;
     Net::UnreliableSocket::Connection m_connection;
+    RaceClientFrame m_upstream{};
     u32 m_frameCount = 0;
     std::optional<RaceServerFrame> m_frame{};
+    std::array<HistoryEntry, 32> m_history{};
     /*CircularBuffer<s32, 60> m_drifts;
     s32 m_drift = 0;*/
 
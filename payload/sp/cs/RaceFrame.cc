@@ -0,0 +1,207 @@
+#include "RaceFrame.hh"
+
+extern "C" {
+#include <sp/Commands.h>
+}
+#include <vendor/libhydrogen/hydrogen.h>
+#include <vendor/nanopb/pb_encode.h>
+
+#include <revolution.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace SP::RaceFrame {
+
+static constexpr u32 QUAT_BITS = 10;
+static constexpr u32 QUAT_MAX = (1 << QUAT_BITS) - 1;
+// No component but the largest can exceed 1/sqrt(2) in a unit quaternion.
+static constexpr f32 QUAT_RANGE = 0.70710678f;
+
+static s32 QuantizeF32(f32 s) {
+    return std::lround(s * POS_SCALE);
+}
+
+// Wrap around rather than overflow on a malformed delta, the result is validated afterwards.
+static s32 AddWrapping(s32 a, s32 b) {
+    return static_cast<s32>(static_cast<u32>(a) + static_cast<u32>(b));
+}
+
+static s32 SubWrapping(s32 a, s32 b) {
+    return static_cast<s32>(static_cast<u32>(a) - static_cast<u32>(b));
+}
+
+Pos QuantizePos(const PlayerFrame_Vec3 &v) {
+    return {QuantizeF32(v.x), QuantizeF32(v.y), QuantizeF32(v.z)};
+}
+
+PlayerFrame_Vec3 DequantizePos(const Pos &pos) {
+    return {pos.x / POS_SCALE, pos.y / POS_SCALE, pos.z / POS_SCALE};
+}
+
+u32 PackQuat(const PlayerFrame_Quat &q) {
+    f32 components[4] = {q.x, q.y, q.z, q.w};
+    u32 largest = 0;
+    for (u32 i = 1; i < 4; i++) {
+        if (std::fabs(components[i]) > std::fabs(components[largest])) {
+            largest = i;
+        }
+    }
+    f32 sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+    u32 packed = largest;
+    for (u32 i = 0; i < 4; i++) {
+        if (i == largest) {
+            continue;
+        }
+        f32 s = (sign * components[i] / QUAT_RANGE + 1.0f) * 0.5f * QUAT_MAX;
+        s32 value = std::clamp<s32>(std::lround(s), 0, QUAT_MAX);
+        packed = packed << QUAT_BITS | value;
+    }
+    return packed;
+}
+
+PlayerFrame_Quat UnpackQuat(u32 packed) {
+    u32 largest = packed >> (3 * QUAT_BITS);
+    f32 components[4];
+    f32 sum = 0.0f;
+    u32 shift = 3 * QUAT_BITS;
+    for (u32 i = 0; i < 4; i++) {
+        if (i == largest) {
+            continue;
+        }
+        shift -= QUAT_BITS;
+        u32 value = packed >> shift & QUAT_MAX;
+        components[i] = (static_cast<f32>(value) / QUAT_MAX * 2.0f - 1.0f) * QUAT_RANGE;
+        sum += components[i] * components[i];
+    }
+    components[largest] = std::sqrt(std::max(1.0f - sum, 0.0f));
+    return {components[0], components[1], components[2], components[3]};
+}
+
+void Pack(const PlayerFrame &frame, const Pos &base, PackedPlayerFrame &packed) {
+    packed.inputState = frame.inputState;
+    packed.timeBeforeRespawn = frame.timeBeforeRespawn;
+    packed.timeInRespawn = frame.timeInRespawn;
+    packed.timesBeforeBoostEnd_count = frame.timesBeforeBoostEnd_count;
+    std::copy_n(frame.timesBeforeBoostEnd, frame.timesBeforeBoostEnd_count,
+            packed.timesBeforeBoostEnd);
+    Pos pos = QuantizePos(frame.pos);
+    packed.posX = SubWrapping(pos.x, base.x);
+    packed.posY = SubWrapping(pos.y, base.y);
+    packed.posZ = SubWrapping(pos.z, base.z);
+    packed.mainRot = PackQuat(frame.mainRot);
+    packed.internalSpeed = frame.internalSpeed;
+}
+
+Pos Unpack(const PackedPlayerFrame &packed, const Pos &base, PlayerFrame &frame) {
+    frame.inputState = packed.inputState;
+    frame.timeBeforeRespawn = packed.timeBeforeRespawn;
+    frame.timeInRespawn = packed.timeInRespawn;
+    frame.timesBeforeBoostEnd_count = packed.timesBeforeBoostEnd_count;
+    std::copy_n(packed.timesBeforeBoostEnd, packed.timesBeforeBoostEnd_count,
+            frame.timesBeforeBoostEnd);
+    Pos pos;
+    pos.x = AddWrapping(base.x, packed.posX);
+    pos.y = AddWrapping(base.y, packed.posY);
+    pos.z = AddWrapping(base.z, packed.posZ);
+    frame.pos = DequantizePos(pos);
+    frame.mainRot = UnpackQuat(packed.mainRot);
+    frame.internalSpeed = packed.internalSpeed;
+    return pos;
+}
+
+static f32 RandomF32(f32 min, f32 max) {
+    return min + (max - min) * (hydro_random_u32() >> 8) / static_cast<f32>(1 << 24);
+}
+
+static PlayerFrame_Quat RandomQuat() {
+    PlayerFrame_Quat q;
+    f32 norm;
+    do {
+        q = {RandomF32(-1.0f, 1.0f), RandomF32(-1.0f, 1.0f), RandomF32(-1.0f, 1.0f),
+                RandomF32(-1.0f, 1.0f)};
+        norm = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    } while (norm < 0.1f || norm > 1.0f);
+    return {q.x / norm, q.y / norm, q.z / norm, q.w / norm};
+}
+
+sp_define_command("/bench_race_frames",
+        "Check the precision and size of packed race frames on random player states",
+        const char *) {
+    constexpr u32 FRAME_COUNT = 600;
+    constexpr u32 PLAYER_COUNT = 12;
+    // How many frames behind the acknowledged frame is for delta frames.
+    constexpr u32 ACK_DISTANCE = 4;
+
+    RaceServerFrame frame{};
+    frame.playerTimes_count = PLAYER_COUNT;
+    frame.players_count = PLAYER_COUNT;
+    for (u32 i = 0; i < PLAYER_COUNT; i++) {
+        auto &player = frame.players[i];
+        player.timesBeforeBoostEnd_count = 3;
+        player.pos = {RandomF32(-3e4f, 3e4f), RandomF32(-5e3f, 5e3f), RandomF32(-3e4f, 3e4f)};
+    }
+
+    Pos history[ACK_DISTANCE][PLAYER_COUNT]{};
+    f32 maxPosError = 0.0f, maxRotError = 0.0f;
+    u64 fullSize = 0, absoluteSize = 0, deltaSize = 0;
+    for (u32 time = 0; time < FRAME_COUNT; time++) {
+        frame.time = time;
+        for (u32 i = 0; i < PLAYER_COUNT; i++) {
+            frame.playerTimes[i] = time;
+            auto &player = frame.players[i];
+            player.inputState.accelerate = true;
+            player.inputState.stickX = hydro_random_uniform(15);
+            player.inputState.stickY = 7;
+            player.pos.x += RandomF32(-120.0f, 120.0f);
+            player.pos.y += RandomF32(-20.0f, 20.0f);
+            player.pos.z += RandomF32(-120.0f, 120.0f);
+            player.mainRot = RandomQuat();
+            player.internalSpeed = RandomF32(0.0f, 100.0f);
+        }
+
+        PackedRaceServerFrame absolute{};
+        PackedRaceServerFrame delta{};
+        absolute.time = delta.time = time;
+        absolute.playerTimes_count = delta.playerTimes_count = PLAYER_COUNT;
+        absolute.players_count = delta.players_count = PLAYER_COUNT;
+        delta.has_baseTime = time >= ACK_DISTANCE;
+        delta.baseTime = time - ACK_DISTANCE;
+        const Pos *base = history[time % ACK_DISTANCE];
+        for (u32 i = 0; i < PLAYER_COUNT; i++) {
+            const auto &player = frame.players[i];
+            absolute.playerTimes[i] = delta.playerTimes[i] = time;
+            Pack(player, {}, absolute.players[i]);
+            Pack(player, delta.has_baseTime ? base[i] : Pos{}, delta.players[i]);
+
+            PlayerFrame unpacked;
+            Pos pos = Unpack(delta.players[i], delta.has_baseTime ? base[i] : Pos{}, unpacked);
+            maxPosError = std::max(maxPosError, std::fabs(unpacked.pos.x - player.pos.x));
+            maxPosError = std::max(maxPosError, std::fabs(unpacked.pos.y - player.pos.y));
+            maxPosError = std::max(maxPosError, std::fabs(unpacked.pos.z - player.pos.z));
+            f32 dot = std::fabs(unpacked.mainRot.x * player.mainRot.x +
+                    unpacked.mainRot.y * player.mainRot.y + unpacked.mainRot.z * player.mainRot.z +
+                    unpacked.mainRot.w * player.mainRot.w);
+            f32 angle = 2.0f * std::acos(std::min(dot, 1.0f)) * 180.0f / 3.14159265f;
+            maxRotError = std::max(maxRotError, angle);
+            history[time % ACK_DISTANCE][i] = pos;
+        }
+
+        size_t size;
+        assert(pb_get_encoded_size(&size, RaceServerFrame_fields, &frame));
+        fullSize += size;
+        assert(pb_get_encoded_size(&size, PackedRaceServerFrame_fields, &absolute));
+        absoluteSize += size;
+        assert(pb_get_encoded_size(&size, PackedRaceServerFrame_fields, &delta));
+        deltaSize += size;
+    }
+
+    OSReport("bench_race_frames: Max position error %f, max rotation error %f degrees\n",
+            maxPosError, maxRotError);
+    OSReport("bench_race_frames: Bytes per frame: full %u, packed %u, delta %u\n",
+            static_cast<u32>(fullSize / FRAME_COUNT), static_cast<u32>(absoluteSize / FRAME_COUNT),
+            static_cast<u32>(deltaSize / FRAME_COUNT));
+}
+
+} // namespace SP::RaceFrame
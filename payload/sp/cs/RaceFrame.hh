@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Common.hh>
+#include <protobuf/Room.pb.h>
+
+namespace SP::RaceFrame {
+
+// Positions are sent as sixteenths of a unit, which covers the range that RaceClient accepts.
+constexpr f32 POS_SCALE = 16.0f;
+
+struct Pos {
+    s32 x;
+    s32 y;
+    s32 z;
+};
+
+Pos QuantizePos(const PlayerFrame_Vec3 &v);
+PlayerFrame_Vec3 DequantizePos(const Pos &pos);
+
+// Smallest three: the index of the largest component in the top 2 bits, then the other three in
+// 10 bits each. The largest component is implied by the unit length, and made positive since q and
+// -q are the same rotation.
+u32 PackQuat(const PlayerFrame_Quat &q);
+PlayerFrame_Quat UnpackQuat(u32 packed);
+
+// The position is written relative to base, which is zero for an absolute frame.
+void Pack(const PlayerFrame &frame, const Pos &base, PackedPlayerFrame &packed);
+// Returns the absolute quantized position, for later frames to be relative to.
+Pos Unpack(const PackedPlayerFrame &packed, const Pos &base, PlayerFrame &frame);
+
+} // namespace SP::RaceFrame
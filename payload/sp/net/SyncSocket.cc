@@ -16,7 +16,8 @@ namespace SP::Net {
 
 // N variant, client-side
 SyncSocket::SyncSocket(const char *hostname, u16 port, const u8 serverPK[hydro_kx_PUBLICKEYBYTES],
-        const char context[hydro_secretbox_CONTEXTBYTES]) {
+        const char context[hydro_secretbox_CONTEXTBYTES], bool splitMessageIDs)
+    : m_splitMessageIDs(splitMessageIDs) {
     char service[0x10];
     snprintf(service, sizeof(service), "%u", port);
     SOAddrInfo hints{};
@@ -83,7 +84,8 @@ SyncSocket::SyncSocket(const char *hostname, u16 port, const u8 serverPK[hydro_k
 }
 
 SyncSocket::SyncSocket(SyncSocket &&that)
-    : m_handle(that.m_handle), m_keypair(that.m_keypair), m_messageID(that.m_messageID) {
+    : m_handle(that.m_handle), m_keypair(that.m_keypair), m_readMessageID(that.m_readMessageID),
+      m_writeMessageID(that.m_writeMessageID), m_splitMessageIDs(that.m_splitMessageIDs) {
     memcpy(m_context, that.m_context, sizeof(m_context));
     hydro_memzero(&that.m_keypair, sizeof(that.m_keypair));
     that.m_handle = -1;
@@ -92,7 +94,9 @@ SyncSocket::SyncSocket(SyncSocket &&that)
 SyncSocket &SyncSocket::operator=(SyncSocket &&that) {
     m_handle = that.m_handle;
     m_keypair = that.m_keypair;
-    m_messageID = that.m_messageID;
+    m_readMessageID = that.m_readMessageID;
+    m_writeMessageID = that.m_writeMessageID;
+    m_splitMessageIDs = that.m_splitMessageIDs;
     memcpy(m_context, that.m_context, sizeof(m_context));
     hydro_memzero(&that.m_keypair, sizeof(that.m_keypair));
     that.m_handle = -1;
@@ -134,8 +138,8 @@ std::expected<std::optional<u16>, const wchar_t *> SyncSocket::read(u8 *message,
     }
 
     const u8 *key = m_keypair.rx;
-    if (hydro_secretbox_decrypt(message, tmp.get() + sizeof(u16), size, m_messageID++, m_context,
-                key) != 0) {
+    if (hydro_secretbox_decrypt(message, tmp.get() + sizeof(u16), size, m_readMessageID++,
+                m_context, key) != 0) {
         return std::unexpected(L"Failed to decrypt message");
     }
     return size - hydro_secretbox_HEADERBYTES;
@@ -146,7 +150,8 @@ std::expected<void, const wchar_t *> SyncSocket::write(const u8 *message, u16 si
     auto tmp = Alloc<u8>(sizeof(u16) + hydro_secretbox_HEADERBYTES + size);
     assert(GetSize(tmp) - 2 <= UINT16_MAX);
     Bytes::Write<u16>(tmp.get(), 0, GetSize(tmp) - 2);
-    if (hydro_secretbox_encrypt(tmp.get() + sizeof(u16), message, size, m_messageID++, m_context,
+    u64 &messageID = m_splitMessageIDs ? m_writeMessageID : m_readMessageID;
+    if (hydro_secretbox_encrypt(tmp.get() + sizeof(u16), message, size, messageID++, m_context,
                 key) != 0) {
         return std::unexpected(L"Failed to encrypt message");
     }
@@ -10,9 +10,10 @@ namespace SP::Net {
 
 class SyncSocket : public Socket {
 public:
-    // N variant, client-side
+    // N variant, client-side. Protocols that send requests before the previous responses are read
+    // must count the messages of each direction separately.
     SyncSocket(const char *hostname, u16 port, const u8 serverPK[hydro_kx_PUBLICKEYBYTES],
-            const char context[hydro_secretbox_CONTEXTBYTES]);
+            const char context[hydro_secretbox_CONTEXTBYTES], bool splitMessageIDs = false);
     SyncSocket(const SyncSocket &) = delete;
     SyncSocket(SyncSocket &&);
     SyncSocket &operator=(SyncSocket &&);
@@ -26,7 +27,9 @@ private:
     s32 m_handle = -1;
     hydro_kx_session_keypair m_keypair;
     char m_context[hydro_secretbox_CONTEXTBYTES];
-    u64 m_messageID = 0;
+    u64 m_readMessageID = 0;
+    u64 m_writeMessageID = 0;
+    bool m_splitMessageIDs = false;
 };
 
 } // namespace SP::Net
@@ -67,19 +67,27 @@ std::optional<UnreliableSocket::Read> UnreliableSocket::read(u8 *message, u16 ma
             return {};
         }
 
-        if (hydro_secretbox_HEADERBYTES + maxSize < result) {
+        if (result < static_cast<s32>(TAG_SIZE + hydro_secretbox_HEADERBYTES) ||
+                TAG_SIZE + hydro_secretbox_HEADERBYTES + maxSize < static_cast<u32>(result)) {
             SP_LOG("Failed to decrypt message");
             continue;
         }
 
+        u32 tag = Bytes::Read<u32>(buffer, 0);
         for (u8 i = 0; i < connectionGroup.count(); i++) {
-            if (hydro_secretbox_decrypt(message, buffer, result, 0, m_context,
-                        connectionGroup[i].keypair.rx) == 0) {
+            if (connectionGroup[i].readTag != tag) {
+                continue;
+            }
+
+            if (hydro_secretbox_decrypt(message, buffer + TAG_SIZE, result - TAG_SIZE, 0,
+                        m_context, connectionGroup[i].keypair.rx) == 0) {
                 // TODO: this sucks
                 connectionGroup[i].ip = address.addr.addr;
                 connectionGroup[i].port = address.port;
-                return Read{static_cast<u16>(result - hydro_secretbox_HEADERBYTES), i};
+                u32 size = result - TAG_SIZE - hydro_secretbox_HEADERBYTES;
+                return Read{static_cast<u16>(size), i};
             }
+            break;
         }
     }
 
@@ -90,13 +98,15 @@ bool UnreliableSocket::write(const u8 *message, u16 size, const Connection &conn
     assert(m_handle >= 0);
 
     u8 buffer[1024];
-    assert(size + hydro_secretbox_HEADERBYTES > size);
-    assert(static_cast<u32>(size + hydro_secretbox_HEADERBYTES) <= sizeof(buffer));
-    if (hydro_secretbox_encrypt(buffer, message, size, 0, m_context, connection.keypair.tx) != 0) {
+    assert(size + TAG_SIZE + hydro_secretbox_HEADERBYTES > size);
+    assert(static_cast<u32>(size + TAG_SIZE + hydro_secretbox_HEADERBYTES) <= sizeof(buffer));
+    Bytes::Write<u32>(buffer, 0, connection.writeTag);
+    if (hydro_secretbox_encrypt(buffer + TAG_SIZE, message, size, 0, m_context,
+                connection.keypair.tx) != 0) {
         SP_LOG("Failed to encrypt message");
         return false;
     }
-    size += hydro_secretbox_HEADERBYTES;
+    size += TAG_SIZE + hydro_secretbox_HEADERBYTES;
 
     SOSockAddrIn address{};
     address.len = sizeof(address);
@@ -113,6 +123,11 @@ bool UnreliableSocket::write(const u8 *message, u16 size, const Connection &conn
     return true;
 }
 
+UnreliableSocket::Connection UnreliableSocket::MakeConnection(u32 ip, u16 port,
+        const hydro_kx_session_keypair &keypair) {
+    return {ip, port, keypair, ConnectionTag(keypair.rx), ConnectionTag(keypair.tx)};
+}
+
 bool UnreliableSocket::makeNonBlocking() {
     s32 result = SOFcntl(m_handle, SO_F_GETFL, 0);
     if (result < 0) {
@@ -129,4 +144,12 @@ bool UnreliableSocket::makeNonBlocking() {
     return true;
 }
 
+u32 UnreliableSocket::ConnectionTag(const u8 key[hydro_kx_SESSIONKEYBYTES]) {
+    static_assert(hydro_kx_SESSIONKEYBYTES == hydro_hash_KEYBYTES);
+
+    u8 hash[hydro_hash_BYTES];
+    hydro_hash_hash(hash, sizeof(hash), nullptr, 0, "conn tag", key);
+    return Bytes::Read<u32>(hash, 0);
+}
+
 } // namespace SP::Net
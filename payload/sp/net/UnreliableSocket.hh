@@ -16,6 +16,9 @@ public:
         u32 ip;
         u16 port;
         hydro_kx_session_keypair keypair;
+        // Sent in the clear ahead of each datagram, so that the receiver only has to try one key.
+        u32 readTag;
+        u32 writeTag;
     };
 
     class ConnectionGroup {
@@ -37,9 +40,16 @@ public:
     std::optional<Read> read(u8 *message, u16 maxSize, ConnectionGroup &connectionGroup);
     bool write(const u8 *message, u16 size, const Connection &connection);
 
+    static Connection MakeConnection(u32 ip, u16 port, const hydro_kx_session_keypair &keypair);
+
 private:
     bool makeNonBlocking();
 
+    // Derived from the key of each direction, which both ends already share.
+    static u32 ConnectionTag(const u8 key[hydro_kx_SESSIONKEYBYTES]);
+
+    static constexpr u32 TAG_SIZE = sizeof(u32);
+
     char m_context[hydro_secretbox_CONTEXTBYTES];
     s32 m_handle = -1;
     std::optional<u16> m_port{};
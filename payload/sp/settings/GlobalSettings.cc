@@ -42,6 +42,17 @@ const Entry entries[] = {
         .valueMessageIds = nullptr,
         .valueExplanationMessageIds = nullptr,
     },
+    // In MiB, 0 disables the cache
+    [static_cast<u32>(Setting::ArchiveCacheSize)] = {
+        .category = Category::Miscellaneous,
+        .name = magic_enum::enum_name(Setting::ArchiveCacheSize),
+        .messageId = 0,
+        .defaultValue = 0,
+        .valueCount = 0,
+        .valueNames = nullptr,
+        .valueMessageIds = nullptr,
+        .valueExplanationMessageIds = nullptr,
+    },
 };
 // clang-format on
 
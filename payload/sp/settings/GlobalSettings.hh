@@ -8,6 +8,7 @@ enum class Setting {
     FileReplacement,
     BootSection,
     LogFileRetention,
+    ArchiveCacheSize,
 };
 
 enum class Category {
@@ -75,4 +76,9 @@ struct Helper<GlobalSettings::Setting, GlobalSettings::Setting::LogFileRetention
     using type = u32;
 };
 
+template <>
+struct Helper<GlobalSettings::Setting, GlobalSettings::Setting::ArchiveCacheSize> {
+    using type = u32;
+};
+
 } // namespace SP::Settings
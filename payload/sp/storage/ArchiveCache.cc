@@ -0,0 +1,216 @@
+#include "ArchiveCache.hh"
+
+#include "sp/ScopeLock.hh"
+#include "sp/StoredDecoder.hh"
+#include "sp/settings/GlobalSettings.hh"
+
+#include <common/Bytes.hh>
+
+#include <algorithm>
+#include <cstring>
+
+#define CACHE_DIRECTORY L"/mkw-spc/cache"
+#define CACHE_INDEX_PATH CACHE_DIRECTORY L"/index.bin"
+
+namespace SP::Storage::ArchiveCache {
+
+struct Entry {
+    u64 id; // The start of the key, which is also used as the file name
+    u32 size;
+    u32 lastUse;
+};
+
+static const u32 INDEX_MAGIC = 0x53504349; // SPCI
+static const u32 INDEX_HEADER_SIZE = 0x8;
+static const u32 INDEX_ENTRY_SIZE = 0x10;
+static const u32 MAX_ENTRY_COUNT = 64;
+// Smaller archives decode quickly enough that going through the cache does not pay off.
+static const u32 MIN_SIZE = 0x40000 /* 256 KiB */;
+
+static Mutex mutex;
+static bool isInit = false;
+static u32 entryCount = 0;
+static u32 useCount = 0;
+static Entry entries[MAX_ENTRY_COUNT];
+
+static u64 GetMaxSize() {
+    return static_cast<u64>(GlobalSettings::Get<GlobalSettings::Setting::ArchiveCacheSize>()) *
+            1024 * 1024;
+}
+
+static void GetPath(u64 id, wchar_t (&path)[64]) {
+    swprintf(path, std::size(path), CACHE_DIRECTORY L"/%016llx.bin", id);
+}
+
+static void WriteIndex() {
+    u8 buffer[INDEX_HEADER_SIZE + MAX_ENTRY_COUNT * INDEX_ENTRY_SIZE];
+    Bytes::Write<u32>(buffer, 0x0, INDEX_MAGIC);
+    Bytes::Write<u32>(buffer, 0x4, entryCount);
+    for (u32 i = 0; i < entryCount; i++) {
+        u8 *entry = buffer + INDEX_HEADER_SIZE + i * INDEX_ENTRY_SIZE;
+        Bytes::Write<u64>(entry, 0x0, entries[i].id);
+        Bytes::Write<u32>(entry, 0x8, entries[i].size);
+        Bytes::Write<u32>(entry, 0xc, entries[i].lastUse);
+    }
+    u32 size = INDEX_HEADER_SIZE + entryCount * INDEX_ENTRY_SIZE;
+    if (!WriteFile(CACHE_INDEX_PATH, buffer, size, true)) {
+        SP_LOG("Failed to write the archive cache index");
+    }
+}
+
+static void Erase(Entry *entry) {
+    wchar_t path[64];
+    GetPath(entry->id, path);
+    if (!Remove(path, true)) {
+        SP_LOG("Failed to remove the cached archive '%ls'", path);
+    }
+    *entry = entries[--entryCount];
+}
+
+static void Clear() {
+    // Without a valid index there is no telling which files are stale, so start over.
+    if (auto dir = OpenDir(CACHE_DIRECTORY)) {
+        while (auto nodeInfo = dir->read()) {
+            if (nodeInfo->type != NodeType::File) {
+                continue;
+            }
+
+            wchar_t path[64];
+            swprintf(path, std::size(path), CACHE_DIRECTORY L"/%ls", nodeInfo->name);
+            Remove(path, true);
+        }
+    }
+    entryCount = 0;
+    useCount = 0;
+}
+
+static void Init() {
+    if (isInit) {
+        return;
+    }
+    isInit = true;
+
+    CreateDir(CACHE_DIRECTORY, true);
+
+    u8 buffer[INDEX_HEADER_SIZE + MAX_ENTRY_COUNT * INDEX_ENTRY_SIZE];
+    auto size = ReadFile(CACHE_INDEX_PATH, buffer, sizeof(buffer));
+    if (!size || *size < INDEX_HEADER_SIZE || Bytes::Read<u32>(buffer, 0x0) != INDEX_MAGIC) {
+        Clear();
+        return;
+    }
+    entryCount = Bytes::Read<u32>(buffer, 0x4);
+    if (entryCount > MAX_ENTRY_COUNT || *size != INDEX_HEADER_SIZE + entryCount * INDEX_ENTRY_SIZE) {
+        Clear();
+        return;
+    }
+
+    for (u32 i = 0; i < entryCount; i++) {
+        const u8 *entry = buffer + INDEX_HEADER_SIZE + i * INDEX_ENTRY_SIZE;
+        entries[i].id = Bytes::Read<u64>(entry, 0x0);
+        entries[i].size = Bytes::Read<u32>(entry, 0x8);
+        entries[i].lastUse = Bytes::Read<u32>(entry, 0xc);
+        useCount = std::max(useCount, entries[i].lastUse + 1);
+    }
+}
+
+static Entry *Find(u64 id) {
+    auto *entry = std::find_if(entries, entries + entryCount,
+            [&](const auto &entry) { return entry.id == id; });
+    return entry != entries + entryCount ? entry : nullptr;
+}
+
+bool IsEnabled() {
+    return GetMaxSize() != 0;
+}
+
+Key GetKey(const wchar_t *path, const NodeInfo &info) {
+    Key key;
+    NETSHA1Context context;
+    NETSHA1Init(&context);
+    NETSHA1Update(&context, path, wcslen(path) * sizeof(wchar_t));
+    NETSHA1Update(&context, &info.size, sizeof(info.size));
+    NETSHA1Update(&context, &info.tick, sizeof(info.tick));
+    NETSHA1GetDigest(&context, key.data());
+    return key;
+}
+
+std::optional<FileHandle> Open(const Key &key) {
+    ScopeLock<Mutex> lock(mutex);
+
+    Init();
+
+    auto *entry = Find(Bytes::Read<u64>(key.data(), 0x0));
+    if (!entry) {
+        return {};
+    }
+
+    wchar_t path[64];
+    GetPath(entry->id, path);
+    auto file = Storage::Open(path, "r");
+    alignas(0x20) u8 header[StoredDecoder::HEADER_SIZE];
+    if (!file || file->size() != sizeof(header) + entry->size ||
+            !file->read(header, sizeof(header), 0) ||
+            !StoredDecoder::CheckMagic(Bytes::Read<u32>(header, 0x0)) ||
+            memcmp(header + 0x8, key.data(), key.size())) {
+        SP_LOG("Dropping invalid cached archive '%ls'", path);
+        file.reset();
+        Erase(entry);
+        WriteIndex();
+        return {};
+    }
+
+    // Only kept in memory until the next insertion writes the index, so that hits don't write to
+    // the SD card. The order of the hits since then is lost on shutdown, which only affects which
+    // archive is evicted first.
+    entry->lastUse = useCount++;
+    return file;
+}
+
+void Insert(const Key &key, const u8 *src, u32 size) {
+    u64 maxSize = GetMaxSize();
+    if (size < MIN_SIZE || StoredDecoder::HEADER_SIZE + size > maxSize) {
+        return;
+    }
+
+    ScopeLock<Mutex> lock(mutex);
+
+    Init();
+
+    u64 id = Bytes::Read<u64>(key.data(), 0x0);
+    if (auto *entry = Find(id)) {
+        Erase(entry);
+    }
+
+    while (true) {
+        u64 totalSize = StoredDecoder::HEADER_SIZE + size;
+        for (u32 i = 0; i < entryCount; i++) {
+            totalSize += StoredDecoder::HEADER_SIZE + entries[i].size;
+        }
+        if (entryCount < MAX_ENTRY_COUNT && totalSize <= maxSize) {
+            break;
+        }
+
+        auto *leastRecentlyUsed = std::min_element(entries, entries + entryCount,
+                [](const auto &a, const auto &b) { return a.lastUse < b.lastUse; });
+        Erase(leastRecentlyUsed);
+    }
+
+    wchar_t path[64];
+    GetPath(id, path);
+    bool ok = false;
+    if (auto file = Storage::Open(path, "w")) {
+        alignas(0x20) u8 header[StoredDecoder::HEADER_SIZE];
+        StoredDecoder::WriteHeader(header, size);
+        memcpy(header + 0x8, key.data(), key.size());
+        ok = file->write(header, sizeof(header), 0) && file->write(src, size, sizeof(header));
+    }
+    if (ok) {
+        entries[entryCount++] = {id, size, useCount++};
+    } else {
+        SP_LOG("Failed to write the cached archive '%ls'", path);
+        Remove(path, true);
+    }
+    WriteIndex();
+}
+
+} // namespace SP::Storage::ArchiveCache
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "sp/ShaUtil.hh"
+#include "sp/storage/Storage.hh"
+
+namespace SP::Storage::ArchiveCache {
+
+// Identifies a source file by its path, size and modification time.
+typedef Sha1 Key;
+
+bool IsEnabled();
+// Only meaningful for nodes with a modification time.
+Key GetKey(const wchar_t *path, const NodeInfo &info);
+// The returned file starts with a StoredDecoder header.
+std::optional<FileHandle> Open(const Key &key);
+void Insert(const Key &key, const u8 *src, u32 size);
+
+} // namespace SP::Storage::ArchiveCache
@@ -150,6 +150,10 @@ u32 DVDStorage::getMessageId() {
     return 0;
 }
 
+ReadQueueConfig DVDStorage::readQueueConfig() {
+    return {2, 0x20000 /* 128 KiB */};
+}
+
 std::optional<FileHandle> DVDStorage::File::clone() {
     ScopeLock<Mutex> lock(m_storage->m_mutex);
 
@@ -192,6 +196,10 @@ u64 DVDStorage::File::size() {
     return AlignUp(this->length, 32);
 }
 
+IStorage *DVDStorage::File::storage() {
+    return m_storage;
+}
+
 std::optional<DirHandle> DVDStorage::Dir::clone() {
     ScopeLock<Mutex> lock(m_storage->m_mutex);
 
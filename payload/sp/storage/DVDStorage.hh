@@ -26,6 +26,7 @@ public:
     std::optional<FileHandle> startBenchmark() override;
     void endBenchmark() override;
     u32 getMessageId() override;
+    ReadQueueConfig readQueueConfig() override;
 
 private:
     class File : public IFile, private DVDFileInfo {
@@ -36,6 +37,7 @@ private:
         bool write(const void *src, u32 size, u32 offset) override;
         bool sync() override;
         u64 size() override;
+        IStorage *storage() override;
 
     private:
         DVDStorage *m_storage = nullptr;
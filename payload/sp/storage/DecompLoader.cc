@@ -3,9 +3,12 @@
 #include "sp/Exchange.hh"
 #include "sp/LZ77Decoder.hh"
 #include "sp/LZMADecoder.hh"
+#include "sp/ScopeLock.hh"
+#include "sp/StoredDecoder.hh"
 #include "sp/ThumbnailManager.hh"
 #include "sp/WBZDecoder.hh"
 #include "sp/YAZDecoder.hh"
+#include "sp/storage/ArchiveCache.hh"
 
 #include <game/system/RaceConfig.hh>
 #include <game/system/ResourceManager.hh>
@@ -15,6 +18,10 @@
 #include <cstring>
 #include <memory>
 
+extern "C" {
+#include <sp/Commands.h>
+}
+
 namespace SP::Storage::DecompLoader {
 
 struct StartInfo {
@@ -22,13 +29,47 @@ struct StartInfo {
     size_t maxSize;
     u64 offset;
     std::optional<StorageType> storageType;
+    bool replacePath;
+    IOPriority priority;
+};
+
+enum class Result {
+    Ok,
+    Error,
+    Preempted, // A background load gave way to another one
 };
 
+struct Chunk {
+    const u8 *src;
+    s32 size; // 0 at the end of the file, -1 on error
+};
+
+static constexpr u32 MAX_QUEUE_DEPTH = 16;
+
 static Exchange<StartInfo, Empty> startExchange;
-static Exchange<bool, s32> updateExchange;
 static u8 stack[0x2000 /* 8 KiB */];
 static OSThread thread;
-alignas(0x20) static u8 srcs[2][0x20000 /* 128 KiB */];
+// Split into ReadQueueConfig::depth slots of ReadQueueConfig::chunkSize bytes for each load.
+alignas(0x20) static u8 srcs[0x40000 /* 256 KiB */];
+static Chunk chunks[MAX_QUEUE_DEPTH];
+static const Chunk endChunk{nullptr, 0};
+static const Chunk errorChunk{nullptr, -1};
+// Filled chunks, sent from the reader to the decoder.
+static OSMessage readyMessages[MAX_QUEUE_DEPTH + 1];
+static OSMessageQueue readyQueue;
+// One message per free slot, sent from the decoder back to the reader.
+static OSMessage freeMessages[MAX_QUEUE_DEPTH];
+static OSMessageQueue freeQueue;
+static volatile bool cancelled = false;
+// Set by the reader when the decoded archive should be added to the cache.
+static std::optional<ArchiveCache::Key> cacheKey;
+static Stats stats{};
+// Loads from different threads take turns, as they share the reader and the slots.
+static Mutex loadMutex;
+static OSThread *volatile abortedThread = nullptr;
+// The loads which are not in the background and wait for loadMutex. Background loads are cancelled
+// and retried when there is one, rather than holding the loader for a whole archive.
+static volatile u32 waitingLoadCount = 0;
 
 std::optional<FileHandle> ReadOptStorage(const wchar_t *path,
         std::optional<StorageType> storageType) {
@@ -40,11 +81,43 @@ std::optional<FileHandle> ReadOptStorage(const wchar_t *path,
     }
 }
 
-static std::optional<FileHandle> Open(const char *path, std::optional<StorageType> storageType) {
+static std::optional<NodeInfo> StatOptStorage(const wchar_t *path,
+        std::optional<StorageType> storageType) {
+    if (storageType.has_value()) {
+        auto *storage = Storage::GetStorage(*storageType);
+        return storage->stat(path);
+    } else {
+        return Storage::Stat(path);
+    }
+}
+
+// The files tried for path, in order: an archive in ro:/ can also be stored as .arc.lzma or .wbz.
+static bool GetCandidatePath(const char *path, u32 index, wchar_t (&filePath)[128]) {
+    size_t length = strlen(path);
+    std::string_view pathSv(path, length);
+    if (pathSv.starts_with("ro:/") && pathSv.ends_with(".szs")) {
+        const wchar_t *suffixes[] = {L".arc.lzma", L".wbz"};
+        if (index < std::size(suffixes)) {
+            swprintf(filePath, std::size(filePath), L"%.*s%ls", length - strlen(".szs"), path,
+                    suffixes[index]);
+            return true;
+        }
+        index -= std::size(suffixes);
+    }
+
+    if (index != 0) {
+        return false;
+    }
+    swprintf(filePath, std::size(filePath), L"%s", path);
+    return true;
+}
+
+static std::optional<FileHandle> Open(const char *path, std::optional<StorageType> storageType,
+        bool replacePath, wchar_t (&filePath)[128]) {
     auto *raceConfig = System::RaceConfig::Instance();
 
     // This is called before the game is loaded, so the nullptr check is actually needed.
-    if (raceConfig != nullptr && raceConfig->m_spRace.pathReplacement.m_len != 0) {
+    if (replacePath && raceConfig != nullptr && raceConfig->m_spRace.pathReplacement.m_len != 0) {
         auto courseId = raceConfig->raceScenario().courseId;
         auto courseFilename = System::ResourceManager::GetCourseFilename(courseId);
 
@@ -56,53 +129,86 @@ static std::optional<FileHandle> Open(const char *path, std::optional<StorageTyp
             raceConfig->m_spRace.pathReplacement = "";
 
             // Recursive call to allow for .arc.lzma or .wbz to be added on.
-            return Open(pathReplacement.c_str(), storageType);
+            return Open(pathReplacement.c_str(), storageType, false, filePath);
         }
     }
 
-    size_t length = strlen(path);
-    std::string_view pathSv(path, length);
-    if (pathSv.starts_with("ro:/") && pathSv.ends_with(".szs")) {
-        wchar_t testPath[128];
-        std::optional<FileHandle> file;
-
-        swprintf(testPath, std::size(testPath), L"%.*s.arc.lzma", length - strlen(".szs"), path);
-        if ((file = ReadOptStorage(testPath, storageType))) {
-            return file;
-        }
-
-        swprintf(testPath, std::size(testPath), L"%.*s.wbz", length - strlen(".szs"), path);
-        if ((file = ReadOptStorage(testPath, storageType))) {
+    for (u32 i = 0; GetCandidatePath(path, i, filePath); i++) {
+        if (auto file = ReadOptStorage(filePath, storageType)) {
             return file;
         }
     }
+    return {};
+}
 
-    wchar_t szsPath[128];
-    swprintf(szsPath, std::size(szsPath), L"%s", path);
-    return ReadOptStorage(szsPath, storageType);
+static void Send(const Chunk *chunk) {
+    OSSendMessage(&readyQueue, const_cast<Chunk *>(chunk), OS_MESSAGE_BLOCK);
 }
 
 static void Read(StartInfo info) {
-    auto file = Open(info.path, info.storageType);
+    // The reader works on behalf of the thread that started the load.
+    SetIOPriority(&thread, info.priority);
+
+    // Slots which the previous load never got to use are still queued.
+    while (OSReceiveMessage(&freeQueue, nullptr, OS_MESSAGE_NOBLOCK)) {}
+
+    wchar_t filePath[128];
+    auto file = Open(info.path, info.storageType, info.replacePath, filePath);
     if (!file || info.offset > file->size()) {
-        updateExchange.right(-1);
+        Send(&errorChunk);
         return;
     }
 
+    cacheKey.reset();
+    if (info.offset == 0 && info.maxSize == SIZE_MAX && ArchiveCache::IsEnabled()) {
+        auto nodeInfo = StatOptStorage(filePath, info.storageType);
+        // Without a modification time, an edited file would still hit the stale cache entry.
+        if (nodeInfo && nodeInfo->tick != 0) {
+            auto key = ArchiveCache::GetKey(filePath, *nodeInfo);
+            if (auto cacheFile = ArchiveCache::Open(key)) {
+                // FileHandle's move assignment does not close the previous file.
+                file.reset();
+                file.emplace(std::move(*cacheFile));
+            } else {
+                cacheKey = key;
+            }
+        }
+    }
+
+    auto config = file->storage()->readQueueConfig();
+    assert(config.depth != 0 && config.depth <= MAX_QUEUE_DEPTH);
+    assert(config.chunkSize % 0x20 == 0 && config.depth * config.chunkSize <= sizeof(srcs));
+    for (u32 i = 0; i < config.depth; i++) {
+        OSSendMessage(&freeQueue, nullptr, OS_MESSAGE_NOBLOCK);
+    }
+
     u64 size = std::min(file->size(), info.offset + info.maxSize);
-    for (u32 offset = info.offset, i = 0; offset < size; offset += sizeof(*srcs), i = (i + 1) % 2) {
-        s32 srcSize = MIN(size - offset, sizeof(*srcs));
-        if (!file->read(srcs[i], srcSize, offset)) {
-            updateExchange.right(-1);
+    for (u32 offset = info.offset, i = 0; offset < size;
+            offset += config.chunkSize, i = (i + 1) % config.depth) {
+        if (!OSReceiveMessage(&freeQueue, nullptr, OS_MESSAGE_NOBLOCK)) {
+            OSTime startTime = OSGetTime();
+            OSReceiveMessage(&freeQueue, nullptr, OS_MESSAGE_BLOCK);
+            stats.readerWaitTime += OSGetTime() - startTime;
+        }
+
+        if (cancelled) {
+            Send(&endChunk);
             return;
         }
 
-        if (!updateExchange.right(srcSize)) {
+        u8 *src = srcs + i * config.chunkSize;
+        s32 srcSize = MIN(size - offset, config.chunkSize);
+        if (!file->read(src, srcSize, offset)) {
+            Send(&errorChunk);
             return;
         }
+        stats.readSize += srcSize;
+
+        chunks[i] = {src, srcSize};
+        Send(&chunks[i]);
     }
 
-    updateExchange.right(0);
+    Send(&endChunk);
 }
 
 static void *Handle(void * /* arg */) {
@@ -112,23 +218,109 @@ static void *Handle(void * /* arg */) {
     }
 }
 
+static const Chunk *Receive() {
+    OSMessage message;
+    if (!OSReceiveMessage(&readyQueue, &message, OS_MESSAGE_NOBLOCK)) {
+        OSTime startTime = OSGetTime();
+        OSReceiveMessage(&readyQueue, &message, OS_MESSAGE_BLOCK);
+        stats.decoderWaitTime += OSGetTime() - startTime;
+    }
+    return reinterpret_cast<const Chunk *>(message);
+}
+
+static void Release() {
+    OSSendMessage(&freeQueue, nullptr, OS_MESSAGE_NOBLOCK);
+}
+
+// Stops the reader and waits for it to finish, so that the slots can be reused by the next load.
+static void Cancel() {
+    cancelled = true;
+    while (Receive()->size > 0) {
+        Release();
+    }
+}
+
 void Init() {
+    OSInitMessageQueue(&readyQueue, readyMessages, std::size(readyMessages));
+    OSInitMessageQueue(&freeQueue, freeMessages, std::size(freeMessages));
     OSCreateThread(&thread, Handle, nullptr, stack + sizeof(stack), sizeof(stack), 24, 0);
     OSResumeThread(&thread);
 }
 
-bool Load(const char *path, size_t srcMaxSize, u64 srcOffset, u8 **dst, size_t *dstSize,
-        EGG::Heap *heap, std::optional<StorageType> storageType) {
-    startExchange.left({path, srcMaxSize, srcOffset, storageType});
+void Abort(OSThread *thread) {
+    abortedThread = thread;
+}
 
-    u32 i = 0;
-    const u8 *src = srcs[i];
-    s32 srcSize = updateExchange.left(true);
+static void AddWaitingLoads(s32 count) {
+    ScopeLock<NoInterrupts> lock;
+    waitingLoadCount = waitingLoadCount + count;
+}
+
+// Nothing for the formats which grow their output as they go.
+static std::optional<size_t> GetDecodedSize(const u8 *src, size_t srcSize) {
+    if (YAZDecoder::CheckMagic(Bytes::Read<u32>(src, 0x0))) {
+        return YAZDecoder::GetDecodedSize(src, srcSize);
+    } else if (LZ77Decoder::CheckMagic(Bytes::Read<u32, std::endian::little>(src, 0x0))) {
+        return LZ77Decoder::GetDecodedSize(src, srcSize);
+    } else if (WBZDecoder::CheckMagic(Bytes::Read<u64, std::endian::big>(src, 0x0))) {
+        return {};
+    } else if (StoredDecoder::CheckMagic(Bytes::Read<u32>(src, 0x0))) {
+        if (srcSize < StoredDecoder::HEADER_SIZE) {
+            return {};
+        }
+        return Bytes::Read<u32>(src, 0x4);
+    } else {
+        if (srcSize < LZMADecoder::HEADER_SIZE) {
+            return {};
+        }
+        u64 dstSize = Bytes::Read<u64, std::endian::little>(src, LZMA_PROPS_SIZE);
+        if (dstSize > SIZE_MAX) {
+            return {};
+        }
+        return dstSize;
+    }
+}
+
+static Result Load(const StartInfo &info, u8 **dst, size_t *dstSize, EGG::Heap *heap,
+        size_t dstMaxSize, bool requiresDecodedSize, NETSHA1Context *sha1Sink) {
+    bool yields = info.priority == IOPriority::Background;
+    if (!yields) {
+        AddWaitingLoads(1);
+    }
+    ScopeLock<Mutex> lock(loadMutex);
+    if (!yields) {
+        AddWaitingLoads(-1);
+    }
+    OSThread *thread = OSGetCurrentThread();
+    if (abortedThread == thread) {
+        return Result::Error;
+    }
+    if (yields && waitingLoadCount != 0) {
+        return Result::Preempted;
+    }
+
+    cancelled = false;
+    stats.loadCount++;
+    startExchange.left(info);
+
+    const Chunk *chunk = Receive();
+    const u8 *src = chunk->src;
+    s32 srcSize = chunk->size;
     if (srcSize <= 0) {
-        return false;
+        return Result::Error;
     } else if (static_cast<size_t>(srcSize) < sizeof(u32)) {
-        updateExchange.left(false);
-        return false;
+        Release();
+        Cancel();
+        return Result::Error;
+    }
+
+    if (dstMaxSize != SIZE_MAX) {
+        auto decodedSize = GetDecodedSize(src, srcSize);
+        if (decodedSize ? *decodedSize > dstMaxSize : requiresDecodedSize) {
+            Release();
+            Cancel();
+            return Result::Error;
+        }
     }
 
     std::unique_ptr<Decoder> decoder;
@@ -138,49 +330,140 @@ bool Load(const char *path, size_t srcMaxSize, u64 srcOffset, u8 **dst, size_t *
         decoder.reset(new (heap, 0x4) LZ77Decoder(src, srcSize, heap));
     } else if (WBZDecoder::CheckMagic(Bytes::Read<u64, std::endian::big>(src, 0x0))) {
         decoder.reset(new (heap, 0x4) WBZDecoder(src, srcSize, heap));
+    } else if (StoredDecoder::CheckMagic(Bytes::Read<u32>(src, 0x0))) {
+        decoder.reset(new (heap, 0x4) StoredDecoder(src, srcSize, heap));
     } else {
         decoder.reset(new (heap, 0x4) LZMADecoder(src, srcSize, heap));
     }
+    decoder->setSHA1Sink(sha1Sink);
 
     src += decoder->headerSize();
     srcSize -= decoder->headerSize();
 
     while (decoder->ok() && !decoder->done() && decoder->decode(src, srcSize)) {
-        srcSize = updateExchange.left(true);
+        Release();
+        if (abortedThread == thread) {
+            Cancel();
+            return Result::Error;
+        }
+        if (yields && waitingLoadCount != 0) {
+            Cancel();
+            return Result::Preempted;
+        }
+
+        chunk = Receive();
+        srcSize = chunk->size;
         if (srcSize < 0 || (srcSize == 0 && !decoder->done())) {
-            return false;
+            return Result::Error;
         } else if (srcSize == 0 && decoder->done()) {
             decoder->release(dst, dstSize);
-            return true;
+            if (cacheKey) {
+                ArchiveCache::Insert(*cacheKey, *dst, *dstSize);
+            }
+            return Result::Ok;
         }
 
-        i = (i + 1) % 2;
-        src = srcs[i];
+        src = chunk->src;
+    }
+
+    Release();
+    Cancel();
+    return Result::Error;
+}
+
+static bool Load(const char *path, size_t srcMaxSize, u64 srcOffset, u8 **dst, size_t *dstSize,
+        EGG::Heap *heap, size_t dstMaxSize, bool requiresDecodedSize,
+        std::optional<StorageType> storageType, bool replacePath, NETSHA1Context *sha1Sink) {
+    IOPriority priority = GetIOPriority(OSGetCurrentThread());
+    StartInfo info{path, srcMaxSize, srcOffset, storageType, replacePath, priority};
+    // The output is hashed from the start again when the load is retried.
+    NETSHA1Context sha1Start;
+    if (sha1Sink) {
+        sha1Start = *sha1Sink;
     }
+    while (true) {
+        if (sha1Sink) {
+            *sha1Sink = sha1Start;
+        }
+        switch (Load(info, dst, dstSize, heap, dstMaxSize, requiresDecodedSize, sha1Sink)) {
+        case Result::Ok:
+            return true;
+        case Result::Error:
+            return false;
+        case Result::Preempted:
+            // Let the other load take the loader before starting over.
+            OSSleepMilliseconds(1);
+            break;
+        }
+    }
+}
 
-    updateExchange.left(false);
-    return false;
+bool Load(const char *path, size_t srcMaxSize, u64 srcOffset, u8 **dst, size_t *dstSize,
+        EGG::Heap *heap, std::optional<StorageType> storageType, NETSHA1Context *sha1Sink) {
+    return Load(path, srcMaxSize, srcOffset, dst, dstSize, heap, SIZE_MAX, false, storageType,
+            true, sha1Sink);
 }
 
 bool LoadRO(const char *path, size_t srcMaxSize, u64 srcOffset, u8 **dst, size_t *dstSize,
-        EGG::Heap *heap, std::optional<StorageType> storageType) {
+        EGG::Heap *heap, std::optional<StorageType> storageType, NETSHA1Context *sha1Sink) {
     char roPath[128];
     if (path[0] == '/') {
         snprintf(roPath, sizeof(roPath), "ro:%s", path);
     } else {
         snprintf(roPath, sizeof(roPath), "ro:/%s", path);
     }
-    return Load(roPath, srcMaxSize, srcOffset, dst, dstSize, heap, storageType);
+    return Load(roPath, srcMaxSize, srcOffset, dst, dstSize, heap, storageType, sha1Sink);
 }
 
 bool Load(const char *path, u8 **dst, size_t *dstSize, EGG::Heap *heap,
-        std::optional<StorageType> storageType) {
-    return Load(path, SIZE_MAX, 0, dst, dstSize, heap, storageType);
+        std::optional<StorageType> storageType, NETSHA1Context *sha1Sink) {
+    return Load(path, SIZE_MAX, 0, dst, dstSize, heap, storageType, sha1Sink);
 }
 
 bool LoadRO(const char *path, u8 **dst, size_t *dstSize, EGG::Heap *heap,
-        std::optional<StorageType> storageType) {
-    return LoadRO(path, SIZE_MAX, 0, dst, dstSize, heap, storageType);
+        std::optional<StorageType> storageType, NETSHA1Context *sha1Sink) {
+    return LoadRO(path, SIZE_MAX, 0, dst, dstSize, heap, storageType, sha1Sink);
+}
+
+bool LoadExact(const char *path, u8 **dst, size_t *dstSize, EGG::Heap *heap, size_t dstMaxSize) {
+    return Load(path, SIZE_MAX, 0, dst, dstSize, heap, dstMaxSize, true, {}, false, nullptr);
+}
+
+bool LoadBounded(const char *path, u8 **dst, size_t *dstSize, EGG::Heap *heap, size_t dstMaxSize,
+        std::optional<StorageType> storageType, NETSHA1Context *sha1Sink) {
+    return Load(path, SIZE_MAX, 0, dst, dstSize, heap, dstMaxSize, false, storageType, false,
+            sha1Sink);
+}
+
+std::optional<NodeInfo> StatRO(const char *path, std::optional<StorageType> storageType,
+        wchar_t (&filePath)[128]) {
+    char roPath[128];
+    if (path[0] == '/') {
+        snprintf(roPath, sizeof(roPath), "ro:%s", path);
+    } else {
+        snprintf(roPath, sizeof(roPath), "ro:/%s", path);
+    }
+    for (u32 i = 0; GetCandidatePath(roPath, i, filePath); i++) {
+        if (auto nodeInfo = StatOptStorage(filePath, storageType)) {
+            return nodeInfo;
+        }
+    }
+    return {};
+}
+
+Stats GetStats() {
+    ScopeLock<NoInterrupts> lock;
+    return stats;
+}
+
+sp_define_command("/decomp_stats", "Show how long DecompLoader waited on reads and decoding",
+        const char *) {
+    auto stats = GetStats();
+    OSReport("decomp_stats: %u loads, %u KiB read\n", stats.loadCount,
+            static_cast<u32>(stats.readSize / 1024));
+    OSReport("decomp_stats: Decoder waited %u ms on reads, reader waited %u ms on decoding\n",
+            static_cast<u32>(OSTicksToMilliseconds(stats.decoderWaitTime)),
+            static_cast<u32>(OSTicksToMilliseconds(stats.readerWaitTime)));
 }
 
 } // namespace SP::Storage::DecompLoader
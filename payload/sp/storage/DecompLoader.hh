@@ -10,14 +10,40 @@ extern "C" {
 
 namespace SP::Storage::DecompLoader {
 
+struct Stats {
+    u32 loadCount;
+    u64 readSize;
+    OSTime decoderWaitTime; // Time the decoder was blocked on the reader
+    OSTime readerWaitTime;  // Time the reader was blocked on the decoder
+};
+
 void Init();
+// Makes the loads of thread fail early, including the one in progress, until it is called again
+// with another thread or nullptr. Used to drop background loads which are no longer needed.
+void Abort(OSThread *thread);
+// The decoded output is hashed into sha1Sink, if any, as it is produced.
 bool Load(const char *path, size_t srcMaxSize, u64 srcOffset, u8 **dst, size_t *dstSize,
-        EGG::Heap *heap, std::optional<StorageType> storageType = {});
+        EGG::Heap *heap, std::optional<StorageType> storageType = {},
+        NETSHA1Context *sha1Sink = nullptr);
 bool LoadRO(const char *path, size_t srcMaxSize, u64 srcOffset, u8 **dst, size_t *dstSize,
-        EGG::Heap *heap, std::optional<StorageType> storageType = {});
+        EGG::Heap *heap, std::optional<StorageType> storageType = {},
+        NETSHA1Context *sha1Sink = nullptr);
 bool Load(const char *path, u8 **dst, size_t *dstSize, EGG::Heap *heap,
-        std::optional<StorageType> = {});
+        std::optional<StorageType> = {}, NETSHA1Context *sha1Sink = nullptr);
 bool LoadRO(const char *path, u8 **dst, size_t *dstSize, EGG::Heap *heap,
-        std::optional<StorageType> = {});
+        std::optional<StorageType> = {}, NETSHA1Context *sha1Sink = nullptr);
+// Like Load, but ignores the race path replacement, which threads other than the main one must not
+// read. Loads from threads with the Background IO priority give way to the other loads in any case.
+// Fails before allocating anything if the decoded size is above dstMaxSize, or not known up front.
+bool LoadExact(const char *path, u8 **dst, size_t *dstSize, EGG::Heap *heap, size_t dstMaxSize);
+// Like LoadExact, but archives which don't store their decoded size (WBZ) are loaded anyway, and
+// then only bounded by heap.
+bool LoadBounded(const char *path, u8 **dst, size_t *dstSize, EGG::Heap *heap, size_t dstMaxSize,
+        std::optional<StorageType> storageType = {}, NETSHA1Context *sha1Sink = nullptr);
+// Stats the file that LoadRO would read, without the race path replacement, and writes its path
+// to filePath.
+std::optional<NodeInfo> StatRO(const char *path, std::optional<StorageType> storageType,
+        wchar_t (&filePath)[128]);
+Stats GetStats();
 
 } // namespace SP::Storage::DecompLoader
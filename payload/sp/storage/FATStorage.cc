@@ -1,6 +1,7 @@
 #include "FATStorage.hh"
 
 #include "sp/CircularBuffer.hh"
+#include "sp/storage/SectorCache.hh"
 #include "sp/settings/FileReplacement.hh"
 #include "sp/settings/GlobalSettings.hh"
 
@@ -14,8 +15,14 @@ extern "C" {
 #include <array>
 #include <cstring>
 
+extern "C" {
+#include <sp/Commands.h>
+}
+
 namespace SP::Storage {
 
+static FATStorage::ReplacementStats s_replacementStats{};
+
 OSTime FATStorage::ConvertTimeToTicks(u16 date, u16 time) {
     OSCalendarTime calendarTime = {};
     calendarTime.sec = (time & 0x1F) << 1;
@@ -40,18 +47,20 @@ FATStorage::FATStorage() {
         m_dirs[i].m_storage = this;
     }
 
-    SP::CircularBuffer<InitFunc, 2> initFuncs = {};
-    initFuncs.push_back(SdiStorage_init);
+    // SD cards have higher and more variable latency than USB devices, so read deeper ahead.
+    SP::CircularBuffer<std::pair<InitFunc, ReadQueueConfig>, 2> initFuncs = {};
+    initFuncs.push_back({SdiStorage_init, {4, 0x10000 /* 64 KiB */}});
     if (IOS::GetNumber() == 36) {
-        initFuncs.push_back(UsbStorage_init);
+        initFuncs.push_back({UsbStorage_init, {2, 0x20000 /* 128 KiB */}});
     }
 
     for (u8 i = 0; i < initFuncs.count(); i += 1) {
-        auto initFunc = *initFuncs[i];
+        auto [initFunc, readQueueConfig] = *initFuncs[i];
         if (!initFunc(&s_storage)) {
             SP_LOG("Failed to initialize the device");
             continue;
         }
+        SectorCache::Init(s_storage, m_fs.win);
 
         if (f_mount(&m_fs, L"", 1) != FR_OK) {
             SP_LOG("Failed to mount the filesystem");
@@ -90,8 +99,10 @@ FATStorage::FATStorage() {
         if (m_prefixCount == 0) {
             createDir(L"/mkw-spc/My Stuff", true);
         }
+        buildReplacementIndex();
 
         SP_LOG("Successfully completed initialization");
+        m_readQueueConfig = readQueueConfig;
         m_ok = true;
         return;
     }
@@ -116,6 +127,7 @@ std::optional<FileHandle> FATStorage::fastOpen(u64 id) {
     }
 
     file->m_isOpen = true;
+    file->m_linkMapIsTooSmall = false;
     return file;
 }
 
@@ -134,6 +146,8 @@ std::optional<FileHandle> FATStorage::open(const wchar_t *path, const char *mode
         fMode = FA_CREATE_ALWAYS | FA_WRITE;
     } else if (!strcmp(mode, "wx")) {
         fMode = FA_CREATE_NEW | FA_WRITE;
+    } else if (!strcmp(mode, "r+")) {
+        fMode = FA_READ | FA_WRITE;
     } else {
         panic("Unknown opening mode");
     }
@@ -141,11 +155,15 @@ std::optional<FileHandle> FATStorage::open(const wchar_t *path, const char *mode
     if (!nodePath) {
         return {};
     }
+    if (fMode & (FA_CREATE_ALWAYS | FA_CREATE_NEW)) {
+        invalidateReplacementIndex(nodePath->path);
+    }
     if (f_open(file, nodePath->path, fMode) != FR_OK) {
         return {};
     }
 
     file->m_isOpen = true;
+    file->m_linkMapIsTooSmall = false;
     return file;
 }
 
@@ -154,6 +172,7 @@ bool FATStorage::createDir(const wchar_t *path, bool allowNop) {
 
     auto nodePath = convertPath(path);
     assert(nodePath);
+    invalidateReplacementIndex(nodePath->path);
     FRESULT fResult = f_mkdir(nodePath->path);
     return fResult == FR_OK || (allowNop && fResult == FR_EXIST);
 }
@@ -228,6 +247,8 @@ bool FATStorage::rename(const wchar_t *srcPath, const wchar_t *dstPath) {
     auto dstNodePath = convertPath(dstPath);
     assert(srcNodePath);
     assert(dstNodePath);
+    invalidateReplacementIndex(srcNodePath->path);
+    invalidateReplacementIndex(dstNodePath->path);
     FRESULT fResult = f_rename(srcNodePath->path, dstNodePath->path);
     return fResult == FR_OK;
 }
@@ -237,6 +258,7 @@ bool FATStorage::remove(const wchar_t *path, bool allowNop) {
 
     auto nodePath = convertPath(path);
     assert(nodePath);
+    invalidateReplacementIndex(nodePath->path);
     FRESULT fResult = f_unlink(nodePath->path);
     return fResult == FR_OK || (allowNop && fResult == FR_NO_FILE);
 }
@@ -254,6 +276,7 @@ std::optional<FileHandle> FATStorage::startBenchmark() {
     }
 
     file->m_isOpen = true;
+    file->m_linkMapIsTooSmall = false;
     return file;
 }
 
@@ -267,6 +290,10 @@ u32 FATStorage::getMessageId() {
     return s_storage->getMessageId();
 }
 
+ReadQueueConfig FATStorage::readQueueConfig() {
+    return m_readQueueConfig;
+}
+
 std::optional<FileHandle> FATStorage::File::clone() {
     ScopeLock<Mutex> lock(m_storage->m_mutex);
 
@@ -276,6 +303,9 @@ std::optional<FileHandle> FATStorage::File::clone() {
     }
 
     *file = *this;
+    if (file->cltbl) {
+        file->cltbl = file->m_linkMap;
+    }
     f_rewind(file);
     return file;
 }
@@ -294,6 +324,10 @@ bool FATStorage::File::close() {
 bool FATStorage::File::read(void *dst, u32 size, u32 offset) {
     ScopeLock<Mutex> lock(m_storage->m_mutex);
 
+    if (!cltbl && !m_linkMapIsTooSmall && s_fastSeekIsEnabled) {
+        createLinkMap();
+    }
+
     if (f_lseek(this, offset) != FR_OK) {
         return false;
     }
@@ -309,6 +343,11 @@ bool FATStorage::File::read(void *dst, u32 size, u32 offset) {
 bool FATStorage::File::write(const void *src, u32 size, u32 offset) {
     ScopeLock<Mutex> lock(m_storage->m_mutex);
 
+    // The link map can't describe clusters that get appended to the chain.
+    if (offset + size > f_size(this)) {
+        destroyLinkMap();
+    }
+
     if (f_lseek(this, offset) != FR_OK) {
         return false;
     }
@@ -321,6 +360,31 @@ bool FATStorage::File::write(const void *src, u32 size, u32 offset) {
     return writtenSize == size;
 }
 
+bool FATStorage::File::readv(const ReadRange *ranges, u32 count) {
+    ScopeLock<Mutex> lock(m_storage->m_mutex);
+
+    const ReadRange *sortedRanges[MAX_READ_RANGE_COUNT];
+    SortReadRanges(ranges, count, sortedRanges);
+
+    for (u32 i = 0; i < count;) {
+        auto *dst = reinterpret_cast<u8 *>(sortedRanges[i]->dst);
+        u32 size = sortedRanges[i]->size;
+        u32 offset = sortedRanges[i]->offset;
+        for (i++; i < count; i++) {
+            if (sortedRanges[i]->offset != offset + size || sortedRanges[i]->dst != dst + size) {
+                break;
+            }
+            size += sortedRanges[i]->size;
+        }
+
+        if (!read(dst, size, offset)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool FATStorage::File::sync() {
     ScopeLock<Mutex> lock(m_storage->m_mutex);
 
@@ -331,6 +395,31 @@ u64 FATStorage::File::size() {
     return f_size(this);
 }
 
+IStorage *FATStorage::File::storage() {
+    return m_storage;
+}
+
+void FATStorage::File::createLinkMap() {
+    // Files within a single cluster never walk the FAT anyway.
+    u64 clusterSize = static_cast<u64>(m_storage->m_fs.csize) * m_storage->m_fs.ssize;
+    if (f_size(this) <= clusterSize) {
+        return;
+    }
+
+    m_linkMap[0] = std::size(m_linkMap);
+    cltbl = m_linkMap;
+    if (f_lseek(this, CREATE_LINKMAP) != FR_OK) {
+        // Too fragmented, keep walking the FAT for this file.
+        cltbl = nullptr;
+        m_linkMapIsTooSmall = true;
+    }
+}
+
+void FATStorage::File::destroyLinkMap() {
+    cltbl = nullptr;
+    m_linkMapIsTooSmall = false;
+}
+
 std::optional<DirHandle> FATStorage::Dir::clone() {
     ScopeLock<Mutex> lock(m_storage->m_mutex);
 
@@ -356,30 +445,43 @@ bool FATStorage::Dir::close() {
 }
 
 std::optional<NodeInfo> FATStorage::Dir::read() {
-    ScopeLock<Mutex> lock(m_storage->m_mutex);
-
-    FILINFO fInfo;
-    if (f_readdir(this, &fInfo) != FR_OK) {
+    NodeInfo info;
+    if (readBatch(&info, 1) != 1) {
         return {};
     }
 
-    if (fInfo.fname[0] == L'\0') {
-        return {};
-    }
+    return info;
+}
 
-    NodeInfo info{};
-    info.id.storage = m_storage;
-    info.id.id = fInfo.dir_ofs;
-    if (fInfo.fattrib & AM_DIR) {
-        info.type = NodeType::Dir;
-    } else {
-        info.type = NodeType::File;
+u32 FATStorage::Dir::readBatch(NodeInfo *infos, u32 count) {
+    ScopeLock<Mutex> lock(m_storage->m_mutex);
+
+    for (u32 i = 0; i < count; i++) {
+        FILINFO fInfo;
+        if (f_readdir(this, &fInfo) != FR_OK) {
+            return i;
+        }
+
+        if (fInfo.fname[0] == L'\0') {
+            return i;
+        }
+
+        NodeInfo &info = infos[i];
+        info = {};
+        info.id.storage = m_storage;
+        info.id.id = fInfo.dir_ofs;
+        if (fInfo.fattrib & AM_DIR) {
+            info.type = NodeType::Dir;
+        } else {
+            info.type = NodeType::File;
+        }
+        info.tick = ConvertTimeToTicks(fInfo.fdate, fInfo.ftime);
+        info.size = fInfo.fsize;
+        static_assert(sizeof(fInfo.fname) <= sizeof(info.name));
+        memcpy(info.name, fInfo.fname, sizeof(fInfo.fname));
     }
-    info.tick = ConvertTimeToTicks(fInfo.fdate, fInfo.ftime);
-    info.size = fInfo.fsize;
-    static_assert(sizeof(fInfo.fname) <= sizeof(info.name));
-    memcpy(info.name, fInfo.fname, sizeof(fInfo.fname));
-    return info;
+
+    return count;
 }
 
 std::optional<FATStorage::Path> FATStorage::convertPath(const wchar_t *path) {
@@ -415,36 +517,184 @@ std::optional<FATStorage::Path> FATStorage::convertPath(const wchar_t *path) {
         break;
     }
 
-    for (u32 i = m_prefixCount; i-- > 0;) {
-        FILINFO fInfo;
-        swprintf(nodePath.path, std::size(nodePath.path), L"%ls/%ls", m_prefixes[i],
-                path + wcslen(L"ro:/"));
-        if (f_stat(nodePath.path, &fInfo) == FR_OK) {
-            return nodePath;
+    if (m_replacementIndexIsDirty) {
+        buildReplacementIndex();
+    }
+
+    OSTime startTime = OSGetTime();
+    s_replacementStats.lookupCount++;
+    const wchar_t *relative = path + wcslen(L"ro:/");
+    const wchar_t *bare = path;
+    for (const wchar_t *s = path; *s != '\0'; s++) {
+        if (*s == L'/') {
+            bare = s + 1;
         }
-        const wchar_t *bare = path;
-        for (const wchar_t *s = path; *s != '\0'; s++) {
-            if (*s == L'/') {
-                bare = s + 1;
+    }
+    const wchar_t *candidates[2] = {relative, bare != path && bare != relative ? bare : nullptr};
+    std::optional<Path> result{};
+    for (u32 i = m_prefixCount; i-- > 0 && !result;) {
+        for (const wchar_t *candidate : candidates) {
+            if (!candidate) {
+                continue;
             }
+            // A miss in the index is definitive, but a hit may be a hash collision.
+            if (m_replacementIndexIsValid &&
+                    !containsReplacementHash(HashReplacementPath(i, candidate))) {
+                s_replacementStats.savedStatCount++;
+                continue;
+            }
+            FILINFO fInfo;
+            swprintf(nodePath.path, std::size(nodePath.path), L"%ls/%ls", m_prefixes[i],
+                    candidate);
+            s_replacementStats.statCount++;
+            if (f_stat(nodePath.path, &fInfo) == FR_OK) {
+                result = nodePath;
+                break;
+            }
+        }
+    }
+    s_replacementStats.lookupTime += OSGetTime() - startTime;
+    return result;
+}
+
+void FATStorage::buildReplacementIndex() {
+    OSTime startTime = OSGetTime();
+    m_replacementIndexIsDirty = false;
+    m_replacementIndexIsValid = false;
+    m_replacementCount = 0;
+    std::fill(std::begin(m_replacementHashes), std::end(m_replacementHashes), 0);
+
+    FILINFO fInfo;
+    for (u32 i = 0; i < m_prefixCount; i++) {
+        wchar_t path[128];
+        swprintf(path, std::size(path), L"%ls", m_prefixes[i]);
+        size_t prefixLength = wcslen(path);
+        if (!indexReplacementDir(i, path, prefixLength, prefixLength, &fInfo)) {
+            SP_LOG("Failed to index the file replacement prefixes, falling back to f_stat");
+            return;
         }
-        if (bare == path) {
+    }
+
+    m_replacementIndexIsValid = true;
+    s_replacementStats.indexedCount = m_replacementCount;
+    s_replacementStats.indexTime += OSGetTime() - startTime;
+    SP_LOG("Indexed %u file replacement paths in %u ms", m_replacementCount,
+            static_cast<u32>(OSTicksToMilliseconds(OSGetTime() - startTime)));
+}
+
+bool FATStorage::indexReplacementDir(u32 prefixIndex, wchar_t *path, size_t prefixLength,
+        size_t length, FILINFO *fInfo) {
+    DIR dir;
+    if (f_opendir(&dir, path) != FR_OK) {
+        return false;
+    }
+
+    bool ok = true;
+    while (ok && f_readdir(&dir, fInfo) == FR_OK && fInfo->fname[0] != L'\0') {
+        size_t nameLength = wcslen(fInfo->fname);
+        if (length + 1 + nameLength + 1 > 128) {
+            // Too long to ever be produced by convertPath.
             continue;
         }
-        swprintf(nodePath.path, std::size(nodePath.path), L"%ls/%ls", m_prefixes[i], bare);
-        if (f_stat(nodePath.path, &fInfo) == FR_OK) {
-            return nodePath;
+        path[length] = L'/';
+        memcpy(path + length + 1, fInfo->fname, (nameLength + 1) * sizeof(wchar_t));
+        size_t childLength = length + 1 + nameLength;
+        ok = insertReplacementHash(HashReplacementPath(prefixIndex, path + prefixLength + 1));
+        if (ok && (fInfo->fattrib & AM_DIR)) {
+            ok = indexReplacementDir(prefixIndex, path, prefixLength, childLength, fInfo);
+        }
+        path[length] = L'\0';
+    }
+
+    f_closedir(&dir);
+    return ok;
+}
+
+bool FATStorage::insertReplacementHash(u32 hash) {
+    // Keep the load factor at 75% so that probes stay short.
+    if (m_replacementCount >= std::size(m_replacementHashes) * 3 / 4) {
+        return false;
+    }
+
+    u32 mask = std::size(m_replacementHashes) - 1;
+    for (u32 i = hash & mask;; i = (i + 1) & mask) {
+        if (m_replacementHashes[i] == hash) {
+            return true;
+        }
+        if (m_replacementHashes[i] == 0) {
+            m_replacementHashes[i] = hash;
+            m_replacementCount++;
+            return true;
         }
     }
+}
+
+bool FATStorage::containsReplacementHash(u32 hash) const {
+    u32 mask = std::size(m_replacementHashes) - 1;
+    for (u32 i = hash & mask;; i = (i + 1) & mask) {
+        if (m_replacementHashes[i] == hash) {
+            return true;
+        }
+        if (m_replacementHashes[i] == 0) {
+            return false;
+        }
+    }
+}
+
+void FATStorage::invalidateReplacementIndex(const wchar_t *nodePath) {
+    if (!wcsncmp(nodePath, L"My Stuff", wcslen(L"My Stuff"))) {
+        m_replacementIndexIsDirty = true;
+    }
+}
 
-    return {};
+u32 FATStorage::HashReplacementPath(u32 prefixIndex, const wchar_t *path) {
+    // FNV-1a, case insensitive like FAT itself.
+    u32 hash = 0x811c9dc5 ^ prefixIndex;
+    for (; *path != L'\0'; path++) {
+        wchar_t c = *path;
+        if (c >= L'a' && c <= L'z') {
+            c -= L'a' - L'A';
+        }
+        hash = (hash ^ static_cast<u32>(c)) * 0x01000193;
+    }
+    // 0 marks an empty slot.
+    return hash != 0 ? hash : 1;
 }
 
 const ::FATStorage *FATStorage::Storage() {
     return s_storage;
 }
 
+FATStorage::ReplacementStats FATStorage::GetReplacementStats() {
+    return s_replacementStats;
+}
+
+bool FATStorage::FastSeekIsEnabled() {
+    return s_fastSeekIsEnabled;
+}
+
+void FATStorage::SetFastSeekIsEnabled(bool fastSeekIsEnabled) {
+    s_fastSeekIsEnabled = fastSeekIsEnabled;
+}
+
 const ::FATStorage *FATStorage::s_storage = nullptr;
+bool FATStorage::s_fastSeekIsEnabled = true;
+
+sp_define_command("/replacement_stats", "Show how many f_stat calls the My Stuff index saved",
+        const char *) {
+    auto stats = FATStorage::GetReplacementStats();
+    OSReport("replacement_stats: %u paths indexed in %u ms\n", stats.indexedCount,
+            static_cast<u32>(OSTicksToMilliseconds(stats.indexTime)));
+    OSReport("replacement_stats: %u lookups in %u ms, %u f_stat calls, %u f_stat calls saved\n",
+            stats.lookupCount, static_cast<u32>(OSTicksToMilliseconds(stats.lookupTime)),
+            stats.statCount, stats.savedStatCount);
+}
+
+sp_define_command("/fast_seek", "Toggle the cluster link maps of FAT files, for benchmarking",
+        const char *) {
+    FATStorage::SetFastSeekIsEnabled(!FATStorage::FastSeekIsEnabled());
+    OSReport("fast_seek: %s\n", FATStorage::FastSeekIsEnabled() ? "enabled" : "disabled");
+}
 
 } // namespace SP::Storage
 
@@ -454,15 +704,15 @@ u32 FATStorage_diskSectorSize(void) {
 }
 
 bool FATStorage_diskRead(u32 firstSector, u32 sectorCount, void *buffer) {
-    return SP::Storage::FATStorage::Storage()->diskRead(firstSector, sectorCount, buffer);
+    return SP::Storage::SectorCache::Read(firstSector, sectorCount, buffer);
 }
 
 bool FATStorage_diskWrite(u32 firstSector, u32 sectorCount, const void *buffer) {
-    return SP::Storage::FATStorage::Storage()->diskWrite(firstSector, sectorCount, buffer);
+    return SP::Storage::SectorCache::Write(firstSector, sectorCount, buffer);
 }
 
 bool FATStorage_diskErase(u32 firstSector, u32 sectorCount) {
-    return SP::Storage::FATStorage::Storage()->diskErase(firstSector, sectorCount);
+    return SP::Storage::SectorCache::Erase(firstSector, sectorCount);
 }
 
 bool FATStorage_diskSync(void) {
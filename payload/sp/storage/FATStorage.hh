@@ -34,8 +34,21 @@ public:
     std::optional<FileHandle> startBenchmark() override;
     void endBenchmark() override;
     u32 getMessageId() override;
+    ReadQueueConfig readQueueConfig() override;
+
+    struct ReplacementStats {
+        u32 lookupCount;
+        u32 statCount;
+        u32 savedStatCount;
+        u32 indexedCount;
+        OSTime lookupTime;
+        OSTime indexTime;
+    };
 
     static const ::FATStorage *Storage();
+    static ReplacementStats GetReplacementStats();
+    static bool FastSeekIsEnabled();
+    static void SetFastSeekIsEnabled(bool fastSeekIsEnabled);
 
 private:
     static OSTime convertTimeToTicks(NodeInfo info);
@@ -46,12 +59,22 @@ private:
         bool close() override;
         bool read(void *dst, u32 size, u32 offset) override;
         bool write(const void *src, u32 size, u32 offset) override;
+        // Reads the ranges in file order, merging the ones that are contiguous both in the file and
+        // in memory.
+        bool readv(const ReadRange *ranges, u32 count) override;
         bool sync() override;
         u64 size() override;
+        IStorage *storage() override;
 
     private:
+        // Maps each fragment of the cluster chain so that seeking doesn't have to walk the FAT.
+        void createLinkMap();
+        void destroyLinkMap();
+
         FATStorage *m_storage = nullptr;
         bool m_isOpen = false;
+        bool m_linkMapIsTooSmall = false;
+        DWORD m_linkMap[64];
 
         friend class FATStorage;
     };
@@ -61,6 +84,7 @@ private:
         std::optional<DirHandle> clone() override;
         bool close() override;
         std::optional<NodeInfo> read() override;
+        u32 readBatch(NodeInfo *infos, u32 count) override;
 
     private:
         FATStorage *m_storage = nullptr;
@@ -73,6 +97,16 @@ private:
         wchar_t path[128];
     };
     std::optional<Path> convertPath(const wchar_t *path);
+    // Records which paths exist under the "My Stuff" prefixes, so that convertPath only has to
+    // f_stat candidates that are likely to exist.
+    void buildReplacementIndex();
+    bool indexReplacementDir(u32 prefixIndex, wchar_t *path, size_t prefixLength, size_t length,
+            FILINFO *fInfo);
+    bool insertReplacementHash(u32 hash);
+    bool containsReplacementHash(u32 hash) const;
+    void invalidateReplacementIndex(const wchar_t *nodePath);
+
+    static u32 HashReplacementPath(u32 prefixIndex, const wchar_t *path);
 
     template <typename N>
     static N *FindNode(N (&nodes)[32]) {
@@ -86,11 +120,17 @@ private:
     FATFS m_fs;
     File m_files[32];
     Dir m_dirs[32];
+    ReadQueueConfig m_readQueueConfig;
     u32 m_prefixCount = 0;
     wchar_t m_prefixes[32][32];
+    u32 m_replacementHashes[4096];
+    u32 m_replacementCount = 0;
+    bool m_replacementIndexIsValid = false;
+    bool m_replacementIndexIsDirty = true;
     bool m_ok = false;
 
     static const ::FATStorage *s_storage;
+    static bool s_fastSeekIsEnabled;
 };
 
 } // namespace SP::Storage
@@ -0,0 +1,338 @@
+#include "IOScheduler.hh"
+
+#include "sp/ScopeLock.hh"
+
+extern "C" {
+#include <sp/Commands.h>
+}
+
+#include <algorithm>
+#include <iterator>
+
+namespace SP::Storage {
+
+struct IORequest {
+    IFile *file;
+    bool isWrite;
+    u8 *buffer;
+    u32 size;
+    u32 offset;
+    // Set for vectored reads, which are never split into chunks.
+    const ReadRange *ranges;
+    u32 rangeCount;
+    u32 progress;
+    IOPriority priority;
+    OSTime submitTime;
+    IORequest *next;
+    bool isUsed;
+    bool isDone;
+    bool result;
+    OSThreadQueue doneQueue;
+};
+
+struct ThreadPriority {
+    OSThread *thread;
+    IOPriority priority;
+};
+
+namespace IOScheduler {
+
+static constexpr u32 MAX_REQUEST_COUNT = 32;
+static constexpr u32 PRIORITY_COUNT = 4;
+// Transfers are split into chunks, so that an urgent request never waits on more than one chunk of
+// a large background one.
+static constexpr u32 CHUNK_SIZE = 0x20000 /* 128 KiB */;
+
+static bool isInit = false;
+static u8 stack[0x2000 /* 8 KiB */];
+static OSThread thread;
+static IORequest requests[MAX_REQUEST_COUNT];
+// One FIFO per priority, the request at the head is the one in progress.
+static IORequest *heads[PRIORITY_COUNT];
+static IORequest *tails[PRIORITY_COUNT];
+static OSThreadQueue workerQueue;
+static OSThreadQueue freeQueue;
+static ThreadPriority threadPriorities[16];
+static IOStats stats[PRIORITY_COUNT];
+
+static IORequest *Front() {
+    for (u32 i = 0; i < PRIORITY_COUNT; i++) {
+        if (heads[i]) {
+            return heads[i];
+        }
+    }
+    return nullptr;
+}
+
+static void Complete(IORequest *request, bool result) {
+    u32 i = static_cast<u32>(request->priority);
+    heads[i] = request->next;
+    if (!heads[i]) {
+        tails[i] = nullptr;
+    }
+
+    OSTime latency = OSGetTime() - request->submitTime;
+    stats[i].queueDepth--;
+    stats[i].totalLatency += latency;
+    stats[i].maxLatency = std::max(stats[i].maxLatency, latency);
+
+    request->result = result;
+    request->isDone = true;
+    OSWakeupThread(&request->doneQueue);
+}
+
+static void *Handle(void * /* arg */) {
+    while (true) {
+        IORequest *request;
+        {
+            ScopeLock<NoInterrupts> lock;
+            while (!(request = Front())) {
+                OSSleepThread(&workerQueue);
+            }
+        }
+
+        bool result;
+        if (request->ranges) {
+            result = request->file->readv(request->ranges, request->rangeCount);
+            request->progress = request->size;
+        } else {
+            u32 chunkSize = std::min(request->size - request->progress, CHUNK_SIZE);
+            u8 *buffer = request->buffer + request->progress;
+            u32 offset = request->offset + request->progress;
+            if (request->isWrite) {
+                result = request->file->write(buffer, chunkSize, offset);
+            } else {
+                result = request->file->read(buffer, chunkSize, offset);
+            }
+            request->progress += chunkSize;
+        }
+
+        if (!result || request->progress == request->size) {
+            ScopeLock<NoInterrupts> lock;
+            Complete(request, result);
+        }
+    }
+}
+
+static IORequest *Acquire(IFile *file, bool isWrite, u8 *buffer, u32 size, u32 offset,
+        const ReadRange *ranges, u32 rangeCount, IOPriority priority) {
+    auto *request = std::find_if(std::begin(requests), std::end(requests),
+            [](const auto &slot) { return !slot.isUsed; });
+    if (request == std::end(requests)) {
+        return nullptr;
+    }
+
+    request->file = file;
+    request->isWrite = isWrite;
+    request->buffer = buffer;
+    request->size = size;
+    request->offset = offset;
+    request->ranges = ranges;
+    request->rangeCount = rangeCount;
+    request->progress = 0;
+    request->priority = priority;
+    request->submitTime = OSGetTime();
+    request->next = nullptr;
+    request->isUsed = true;
+    request->isDone = false;
+    request->result = false;
+    OSInitThreadQueue(&request->doneQueue);
+
+    u32 i = static_cast<u32>(priority);
+    stats[i].requestCount++;
+    stats[i].queueDepth++;
+    stats[i].maxQueueDepth = std::max(stats[i].maxQueueDepth, stats[i].queueDepth);
+
+    if (size == 0) {
+        request->result = true;
+        request->isDone = true;
+        stats[i].queueDepth--;
+        return request;
+    }
+
+    if (tails[i]) {
+        tails[i]->next = request;
+    } else {
+        heads[i] = request;
+    }
+    tails[i] = request;
+    OSWakeupThread(&workerQueue);
+    return request;
+}
+
+static bool Wait(IORequest *request) {
+    ScopeLock<NoInterrupts> lock;
+    while (!request->isDone) {
+        OSSleepThread(&request->doneQueue);
+    }
+    return request->result;
+}
+
+static void Release(IORequest *request) {
+    Wait(request);
+
+    ScopeLock<NoInterrupts> lock;
+    request->isUsed = false;
+    OSWakeupThread(&freeQueue);
+}
+
+void Init() {
+    if (isInit) {
+        return;
+    }
+
+    OSInitThreadQueue(&workerQueue);
+    OSInitThreadQueue(&freeQueue);
+    // Above the main thread (16) and all the threads that submit requests (20 to 31), so that the
+    // next chunk is started as soon as one completes rather than after the frame work of the game,
+    // which Stream requests can't afford. The worker spends nearly all of its time blocked on IOS,
+    // so it only takes the per-chunk bookkeeping away from those threads.
+    OSCreateThread(&thread, Handle, nullptr, stack + sizeof(stack), sizeof(stack), 10, 0);
+    OSResumeThread(&thread);
+    isInit = true;
+}
+
+std::optional<IORequestHandle> Submit(IFile *file, bool isWrite, u8 *buffer, u32 size, u32 offset,
+        IOPriority priority) {
+    if (!isInit) {
+        return {};
+    }
+
+    ScopeLock<NoInterrupts> lock;
+    IORequest *request = Acquire(file, isWrite, buffer, size, offset, nullptr, 0, priority);
+    if (!request) {
+        return {};
+    }
+    return IORequestHandle(request);
+}
+
+bool Transfer(IFile *file, bool isWrite, u8 *buffer, u32 size, u32 offset) {
+    // The worker itself and anything running before it was started go straight to the storage.
+    if (!isInit || OSGetCurrentThread() == &thread) {
+        if (isWrite) {
+            return file->write(buffer, size, offset);
+        } else {
+            return file->read(buffer, size, offset);
+        }
+    }
+
+    IOPriority priority = GetIOPriority(OSGetCurrentThread());
+    IORequest *request;
+    {
+        ScopeLock<NoInterrupts> lock;
+        while (!(request = Acquire(file, isWrite, buffer, size, offset, nullptr, 0, priority))) {
+            OSSleepThread(&freeQueue);
+        }
+    }
+    bool result = Wait(request);
+    Release(request);
+    return result;
+}
+
+bool TransferRanges(IFile *file, const ReadRange *ranges, u32 count) {
+    if (!isInit || OSGetCurrentThread() == &thread) {
+        return file->readv(ranges, count);
+    }
+
+    u32 size = 0;
+    for (u32 i = 0; i < count; i++) {
+        size += ranges[i].size;
+    }
+
+    IOPriority priority = GetIOPriority(OSGetCurrentThread());
+    IORequest *request;
+    {
+        ScopeLock<NoInterrupts> lock;
+        while (!(request = Acquire(file, false, nullptr, size, 0, ranges, count, priority))) {
+            OSSleepThread(&freeQueue);
+        }
+    }
+    bool result = Wait(request);
+    Release(request);
+    return result;
+}
+
+} // namespace IOScheduler
+
+IORequestHandle::IORequestHandle(IORequest *request) : m_request(request) {}
+
+IORequestHandle::IORequestHandle(IORequestHandle &&that) : m_request(that.m_request) {
+    that.m_request = nullptr;
+}
+
+IORequestHandle &IORequestHandle::operator=(IORequestHandle &&that) {
+    if (m_request) {
+        IOScheduler::Release(m_request);
+    }
+    m_request = that.m_request;
+    that.m_request = nullptr;
+    return *this;
+}
+
+IORequestHandle::~IORequestHandle() {
+    // The worker may still be writing to the buffer, so the request can't just be dropped.
+    if (m_request) {
+        IOScheduler::Release(m_request);
+    }
+}
+
+bool IORequestHandle::isDone() const {
+    return m_request->isDone;
+}
+
+bool IORequestHandle::wait() {
+    return IOScheduler::Wait(m_request);
+}
+
+IOPriority GetIOPriority(OSThread *thread) {
+    ScopeLock<NoInterrupts> lock;
+    for (const auto &threadPriority : IOScheduler::threadPriorities) {
+        if (threadPriority.thread == thread) {
+            return threadPriority.priority;
+        }
+    }
+    return IOPriority::Course;
+}
+
+void SetIOPriority(OSThread *thread, IOPriority priority) {
+    ScopeLock<NoInterrupts> lock;
+    auto &threadPriorities = IOScheduler::threadPriorities;
+    auto *threadPriority = std::find_if(std::begin(threadPriorities), std::end(threadPriorities),
+            [&](const auto &threadPriority) { return threadPriority.thread == thread; });
+    if (threadPriority == std::end(threadPriorities)) {
+        if (priority == IOPriority::Course) {
+            return;
+        }
+        threadPriority = std::find_if(std::begin(threadPriorities), std::end(threadPriorities),
+                [](const auto &threadPriority) { return !threadPriority.thread; });
+        assert(threadPriority != std::end(threadPriorities));
+    }
+    if (priority == IOPriority::Course) {
+        *threadPriority = {nullptr, IOPriority::Course};
+    } else {
+        *threadPriority = {thread, priority};
+    }
+}
+
+IOStats GetIOStats(IOPriority priority) {
+    ScopeLock<NoInterrupts> lock;
+    return IOScheduler::stats[static_cast<u32>(priority)];
+}
+
+sp_define_command("/io_stats", "Show the queue depths and latencies of each I/O priority",
+        const char *) {
+    const char *names[] = {"stream", "course", "ui", "background"};
+    for (u32 i = 0; i < std::size(names); i++) {
+        auto stats = GetIOStats(static_cast<IOPriority>(i));
+        OSTime averageLatency = 0;
+        if (stats.requestCount != 0) {
+            averageLatency = stats.totalLatency / stats.requestCount;
+        }
+        OSReport("io_stats: %s: %u requests, %u queued (max %u), latency avg %u us, max %u us\n",
+                names[i], stats.requestCount, stats.queueDepth, stats.maxQueueDepth,
+                static_cast<u32>(OSTicksToNanoseconds(averageLatency) / 1000),
+                static_cast<u32>(OSTicksToNanoseconds(stats.maxLatency) / 1000));
+    }
+}
+
+} // namespace SP::Storage
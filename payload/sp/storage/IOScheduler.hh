@@ -0,0 +1,15 @@
+#pragma once
+
+#include "sp/storage/Storage.hh"
+
+namespace SP::Storage::IOScheduler {
+
+void Init();
+std::optional<IORequestHandle> Submit(IFile *file, bool isWrite, u8 *buffer, u32 size, u32 offset,
+        IOPriority priority);
+// Waits for a free request slot if needed, and for the request to complete.
+bool Transfer(IFile *file, bool isWrite, u8 *buffer, u32 size, u32 offset);
+// Same as Transfer, but the ranges are handed to the file as a single unit.
+bool TransferRanges(IFile *file, const ReadRange *ranges, u32 count);
+
+} // namespace SP::Storage::IOScheduler
@@ -191,6 +191,10 @@ u32 NANDArchiveStorage::getMessageId() {
     return 0;
 }
 
+ReadQueueConfig NANDArchiveStorage::readQueueConfig() {
+    return {2, 0x20000 /* 128 KiB */};
+}
+
 std::optional<FileHandle> NANDArchiveStorage::File::clone() {
     ScopeLock<Mutex> lock(m_storage->m_mutex);
 
@@ -262,6 +266,10 @@ u64 NANDArchiveStorage::File::size() {
     return ARCGetLength(this);
 }
 
+IStorage *NANDArchiveStorage::File::storage() {
+    return m_storage;
+}
+
 std::optional<DirHandle> NANDArchiveStorage::Dir::clone() {
     ScopeLock<Mutex> lock(m_storage->m_mutex);
 
@@ -22,7 +22,7 @@ void CheckArgs(std::expected<T, const wchar_t *>, const char *) {}
 #define TRY_WARN(resExpr, name) \
     ({ \
         auto res = (resExpr); \
-        CheckArgs(resExpr, name); \
+        CheckArgs(res, name); \
         if (!res) { \
             SP_LOG("[Warning] Ignoring " name " error: %ls", res.error()); \
             return std::nullopt; \
@@ -173,6 +173,12 @@ u32 NetStorage::getMessageId() {
     return 10158;
 }
 
+ReadQueueConfig NetStorage::readQueueConfig() {
+    // Sequential reads are already pipelined by the read-ahead, so use large chunks to cut the
+    // per-request overhead.
+    return {8, CHUNK_SIZE};
+}
+
 std::optional<FileHandle> NetStorage::File::clone() {
     ScopeLock<Mutex> lock(m_storage->m_mutex);
 
@@ -218,25 +224,27 @@ bool NetStorage::File::read(void *dst, u32 size, u32 offset) {
         return false;
     }
 
-    if (!m_storage->writeRead(*m_handle, size, offset)) {
-        return false;
-    }
+    if (!m_storage->readReadAhead(this, dst, size, offset)) {
+        if (!m_storage->writeRead(*m_handle, size, offset)) {
+            return false;
+        }
 
-    if (!m_storage->readOk()) {
-        return false;
-    }
+        if (!m_storage->readOk()) {
+            return false;
+        }
 
-    auto *ptr = reinterpret_cast<u8 *>(dst);
-    size += offset;
-    while (offset < size) {
-        u16 chunkSize = std::min(size - offset, static_cast<u32>(0x1000));
-        if (!m_storage->m_socketRaw->read(ptr, chunkSize)) {
+        if (!m_storage->readData(dst, size)) {
             return false;
         }
-        ptr += chunkSize;
-        offset += chunkSize;
     }
 
+    // Streaming readers such as DecompLoader go through a file in chunks of the same size, so the
+    // next ones can be requested before they are needed.
+    if (offset == m_nextReadOffset && size >= READ_AHEAD_MIN_SIZE) {
+        m_storage->readAhead(this, size, offset + size);
+    }
+    m_nextReadOffset = offset + size;
+
     return true;
 }
 
@@ -265,6 +273,38 @@ bool NetStorage::File::write(const void *src, u32 size, u32 offset) {
     return m_storage->readOk();
 }
 
+bool NetStorage::File::readv(const ReadRange *ranges, u32 count) {
+    ScopeLock<Mutex> lock(m_storage->m_mutex);
+
+    if (!m_storage->m_socket) {
+        return false;
+    }
+
+    const ReadRange *sortedRanges[MAX_READ_RANGE_COUNT];
+    SortReadRanges(ranges, count, sortedRanges);
+
+    // A request has to fit in a single message.
+    u32 maxBatchSize = std::size(NetStorageRequest_ReadRanges{}.ranges);
+    for (u32 i = 0; i < count; i += maxBatchSize) {
+        u32 batchSize = std::min(count - i, maxBatchSize);
+        if (!m_storage->writeReadRanges(*m_handle, sortedRanges + i, batchSize)) {
+            return false;
+        }
+
+        if (!m_storage->readOk()) {
+            return false;
+        }
+
+        for (u32 j = i; j < i + batchSize; j++) {
+            if (!m_storage->readData(sortedRanges[j]->dst, sortedRanges[j]->size)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 bool NetStorage::File::sync() {
     return true;
 }
@@ -273,6 +313,10 @@ u64 NetStorage::File::size() {
     return m_size;
 }
 
+IStorage *NetStorage::File::storage() {
+    return m_storage;
+}
+
 std::optional<DirHandle> NetStorage::Dir::clone() {
     ScopeLock<Mutex> lock(m_storage->m_mutex);
 
@@ -325,11 +369,25 @@ std::optional<NodeInfo> NetStorage::Dir::read() {
     return m_storage->readNodeInfo();
 }
 
+u32 NetStorage::Dir::readBatch(NodeInfo *infos, u32 count) {
+    ScopeLock<Mutex> lock(m_storage->m_mutex);
+
+    if (!m_storage->m_socket) {
+        return 0;
+    }
+
+    if (!m_storage->writeReadDirBatch(*m_handle, count)) {
+        return 0;
+    }
+
+    return m_storage->readNodeInfos(infos, count);
+}
+
 bool NetStorage::writeFastOpen(u64 id) {
     NetStorageRequest request;
     request.which_request = NetStorageRequest_fastOpen_tag;
     request.request.fastOpen.id = id;
-    return WarnError(m_socket->writeProto(request), "writeFastOpen");
+    return writeRequest(request, "writeFastOpen");
 }
 
 bool NetStorage::writeOpen(const wchar_t *path, const char *mode) {
@@ -337,21 +395,21 @@ bool NetStorage::writeOpen(const wchar_t *path, const char *mode) {
     request.which_request = NetStorageRequest_open_tag;
     snprintf(request.request.open.path, sizeof(request.request.open.path), "%ls", path);
     snprintf(request.request.open.mode, sizeof(request.request.open.mode), "%s", mode);
-    return WarnError(m_socket->writeProto(request), "writeOpen");
+    return writeRequest(request, "writeOpen");
 }
 
 bool NetStorage::writeClone(u32 handle) {
     NetStorageRequest request;
     request.which_request = NetStorageRequest_clone_tag;
     request.request.clone.handle = handle;
-    return WarnError(m_socket->writeProto(request), "writeClone");
+    return writeRequest(request, "writeClone");
 }
 
 bool NetStorage::writeClose(u32 handle) {
     NetStorageRequest request;
     request.which_request = NetStorageRequest_close_tag;
     request.request.close.handle = handle;
-    return WarnError(m_socket->writeProto(request), "writeClose");
+    return writeRequest(request, "writeClose");
 }
 
 bool NetStorage::writeRead(u32 handle, u32 size, u64 offset) {
@@ -360,7 +418,9 @@ bool NetStorage::writeRead(u32 handle, u32 size, u64 offset) {
     request.request.read.handle = handle;
     request.request.read.size = size;
     request.request.read.offset = offset;
-    return WarnError(m_socket->writeProto(request), "writeRead");
+    request.request.read.has_chunkSize = true;
+    request.request.read.chunkSize = CHUNK_SIZE;
+    return writeRequest(request, "writeRead");
 }
 
 bool NetStorage::writeWrite(u32 handle, u32 size, u64 offset) {
@@ -369,59 +429,98 @@ bool NetStorage::writeWrite(u32 handle, u32 size, u64 offset) {
     request.request.write.handle = handle;
     request.request.write.size = size;
     request.request.write.offset = offset;
-    return WarnError(m_socket->writeProto(request), "writeWrite");
+    return writeRequest(request, "writeWrite");
 }
 
 bool NetStorage::writeFastOpenDir(u64 id) {
     NetStorageRequest request;
     request.which_request = NetStorageRequest_fastOpenDir_tag;
     request.request.fastOpenDir.id = id;
-    return WarnError(m_socket->writeProto(request), "writeFastOpenDir");
+    return writeRequest(request, "writeFastOpenDir");
 }
 
 bool NetStorage::writeOpenDir(const wchar_t *path) {
     NetStorageRequest request;
     request.which_request = NetStorageRequest_openDir_tag;
     snprintf(request.request.openDir.path, sizeof(request.request.openDir.path), "%ls", path);
-    return WarnError(m_socket->writeProto(request), "writeOpenDir");
+    return writeRequest(request, "writeOpenDir");
 }
 
 bool NetStorage::writeCloneDir(u32 handle) {
     NetStorageRequest request;
     request.which_request = NetStorageRequest_cloneDir_tag;
     request.request.cloneDir.handle = handle;
-    return WarnError(m_socket->writeProto(request), "writeCloneDir");
+    return writeRequest(request, "writeCloneDir");
 }
 
 bool NetStorage::writeCloseDir(u32 handle) {
     NetStorageRequest request;
     request.which_request = NetStorageRequest_closeDir_tag;
     request.request.closeDir.handle = handle;
-    return WarnError(m_socket->writeProto(request), "writeCloseDir");
+    return writeRequest(request, "writeCloseDir");
 }
 
 bool NetStorage::writeReadDir(u32 handle) {
     NetStorageRequest request;
     request.which_request = NetStorageRequest_readDir_tag;
     request.request.readDir.handle = handle;
-    return WarnError(m_socket->writeProto(request), "writeReadDir");
+    return writeRequest(request, "writeReadDir");
+}
+
+bool NetStorage::writeReadDirBatch(u32 handle, u32 count) {
+    NetStorageRequest request;
+    request.which_request = NetStorageRequest_readDirBatch_tag;
+    request.request.readDirBatch.handle = handle;
+    request.request.readDirBatch.count = count;
+    return writeRequest(request, "writeReadDirBatch");
 }
 
 bool NetStorage::writeStat(const wchar_t *path) {
     NetStorageRequest request;
     request.which_request = NetStorageRequest_stat_tag;
     snprintf(request.request.stat.path, sizeof(request.request.stat.path), "%ls", path);
-    return WarnError(m_socket->writeProto(request), "writeStat");
+    return writeRequest(request, "writeStat");
 }
 
 bool NetStorage::writeStartBenchmark() {
     NetStorageRequest request;
     request.which_request = NetStorageRequest_startBenchmark_tag;
-    return WarnError(m_socket->writeProto(request), "writeStartBenchmark");
+    return writeRequest(request, "writeStartBenchmark");
+}
+
+bool NetStorage::writeReadRanges(u32 handle, const ReadRange *const *ranges, u32 count) {
+    NetStorageRequest request;
+    request.which_request = NetStorageRequest_readRanges_tag;
+    request.request.readRanges.handle = handle;
+    request.request.readRanges.ranges_count = count;
+    for (u32 i = 0; i < count; i++) {
+        request.request.readRanges.ranges[i].size = ranges[i]->size;
+        request.request.readRanges.ranges[i].offset = ranges[i]->offset;
+    }
+    return writeRequest(request, "writeReadRanges");
+}
+
+bool NetStorage::writeRequest(NetStorageRequest &request, const char *name) {
+    if (!drainReadAheads()) {
+        return false;
+    }
+
+    if (!sendRequest(request, name)) {
+        return false;
+    }
+
+    m_responseId = request.id;
+    return true;
+}
+
+bool NetStorage::sendRequest(NetStorageRequest &request, const char *name) {
+    request.has_id = true;
+    request.id = ++m_requestId;
+    return WarnError(m_socket->writeProto(request), name);
 }
 
 std::optional<FileHandle> NetStorage::readOpen(File *file) {
-    auto response = TRY_OPT(TRY_WARN(m_socket->readProto(), "readOpen"));
+    auto response = TRY_OPT(TRY_WARN(readResponse(), "readOpen"));
     if (response.which_response != NetStorageResponse_open_tag) {
         SP_LOG("[Warning] Got wrong response for Open request");
         return std::nullopt;
@@ -429,11 +528,12 @@ std::optional<FileHandle> NetStorage::readOpen(File *file) {
 
     file->m_handle = response.response.open.handle;
     file->m_size = response.response.open.size;
+    file->m_nextReadOffset = 0;
     return file;
 }
 
 std::optional<DirHandle> NetStorage::readOpenDir(Dir *dir) {
-    auto response = TRY_OPT(TRY_WARN(m_socket->readProto(), "readOpenDir"));
+    auto response = TRY_OPT(TRY_WARN(readResponse(), "readOpenDir"));
     if (response.which_response != NetStorageResponse_openDir_tag) {
         SP_LOG("[Warning] Got wrong response for OpenDir request");
         return std::nullopt;
@@ -444,23 +544,53 @@ std::optional<DirHandle> NetStorage::readOpenDir(Dir *dir) {
 }
 
 std::optional<NodeInfo> NetStorage::readNodeInfo() {
-    auto response = TRY_OPT(TRY_WARN(m_socket->readProto(), "readNodeInfo"));
+    auto response = TRY_OPT(TRY_WARN(readResponse(), "readNodeInfo"));
     if (response.which_response != NetStorageResponse_nodeInfo_tag) {
         SP_LOG("[Warning] Got wrong response for readNodeInfo request");
         return std::nullopt;
     }
 
+    return convertNodeInfo(response.response.nodeInfo);
+}
+
+u32 NetStorage::readNodeInfos(NodeInfo *infos, u32 count) {
+    for (u32 i = 0; i <= count; i++) {
+        auto responseRes = readResponse();
+        if (!responseRes || !(*responseRes)) {
+            return i;
+        }
+
+        auto response = **responseRes;
+        if (response.which_response == NetStorageResponse_ok_tag) {
+            return i;
+        }
+        if (response.which_response != NetStorageResponse_nodeInfo_tag || i == count) {
+            SP_LOG("[Warning] Got wrong response for ReadDirBatch request");
+            return i;
+        }
+
+        infos[i] = convertNodeInfo(response.response.nodeInfo);
+    }
+
+    return count;
+}
+
+NodeInfo NetStorage::convertNodeInfo(const NetStorageResponse_NodeInfo &nodeInfo) {
     NodeInfo info{};
     info.id.storage = this;
-    info.id.id = response.response.nodeInfo.id;
-    info.type = static_cast<NodeType>(response.response.nodeInfo.type);
-    info.size = response.response.nodeInfo.size;
-    swprintf(info.name, std::size(info.name), L"%s", response.response.nodeInfo.name);
+    info.id.id = nodeInfo.id;
+    info.type = static_cast<NodeType>(nodeInfo.type);
+    info.size = nodeInfo.size;
+    if (nodeInfo.has_modifiedTime) {
+        // OSTime counts from 2000-01-01.
+        info.tick = OSSecondsToTicks(static_cast<OSTime>(nodeInfo.modifiedTime) - 946684800);
+    }
+    swprintf(info.name, std::size(info.name), L"%s", nodeInfo.name);
     return info;
 }
 
 bool NetStorage::readOk() {
-    auto responseRes = m_socket->readProto();
+    auto responseRes = readResponse();
     if (!responseRes || !(*responseRes)) {
         return false;
     }
@@ -473,10 +603,109 @@ bool NetStorage::readOk() {
     return true;
 }
 
+bool NetStorage::readData(void *dst, u32 size) {
+    // The server picks the chunk size, up to the one that was asked for.
+    auto *ptr = reinterpret_cast<u8 *>(dst);
+    while (size > 0) {
+        u16 maxChunkSize = std::min(size, CHUNK_SIZE);
+        auto chunkSize = m_socketRaw->read(ptr, maxChunkSize);
+        if (!chunkSize || !*chunkSize || **chunkSize == 0) {
+            return false;
+        }
+        ptr += **chunkSize;
+        size -= **chunkSize;
+    }
+
+    return true;
+}
+
+bool NetStorage::discardData(u32 size) {
+    while (size > 0) {
+        u32 chunkSize = std::min(size, CHUNK_SIZE);
+        if (!readData(m_discardBuffer, chunkSize)) {
+            return false;
+        }
+        size -= chunkSize;
+    }
+
+    return true;
+}
+
+std::expected<std::optional<NetStorageResponse>, const wchar_t *> NetStorage::readResponse() {
+    auto response = m_socket->readProto();
+    if (response && *response && (*response)->has_id && (*response)->id != m_responseId) {
+        return std::unexpected(L"Got a response to another request");
+    }
+    return response;
+}
+
+void NetStorage::readAhead(File *file, u32 size, u64 offset) {
+    if (m_readAheadCount != 0) {
+        const auto &last = m_readAheads[m_readAheadCount - 1];
+        if (last.file != file) {
+            return;
+        }
+        offset = last.offset + last.size;
+    }
+
+    while (m_readAheadCount < READ_AHEAD_DEPTH && offset < file->m_size) {
+        u32 readAheadSize = std::min<u64>(size, file->m_size - offset);
+        NetStorageRequest request;
+        request.which_request = NetStorageRequest_read_tag;
+        request.request.read.handle = *file->m_handle;
+        request.request.read.size = readAheadSize;
+        request.request.read.offset = offset;
+        request.request.read.has_chunkSize = true;
+        request.request.read.chunkSize = CHUNK_SIZE;
+        if (!sendRequest(request, "readAhead")) {
+            return;
+        }
+
+        m_readAheads[m_readAheadCount++] = {file, request.id, readAheadSize, offset};
+        offset += readAheadSize;
+    }
+}
+
+bool NetStorage::readReadAhead(File *file, void *dst, u32 size, u64 offset) {
+    if (m_readAheadCount == 0) {
+        return false;
+    }
+
+    ReadAhead readAhead = m_readAheads[0];
+    if (readAhead.file != file || readAhead.size != size || readAhead.offset != offset) {
+        return false;
+    }
+
+    std::copy(m_readAheads + 1, m_readAheads + m_readAheadCount, m_readAheads);
+    m_readAheadCount--;
+
+    m_responseId = readAhead.id;
+    if (!readOk()) {
+        return false;
+    }
+
+    return readData(dst, size);
+}
+
+bool NetStorage::drainReadAheads() {
+    for (u32 i = 0; i < m_readAheadCount; i++) {
+        m_responseId = m_readAheads[i].id;
+        if (readOk() && !discardData(m_readAheads[i].size)) {
+            m_readAheadCount = 0;
+            return false;
+        }
+    }
+
+    m_readAheadCount = 0;
+    return true;
+}
+
 void NetStorage::connect() {
 #if defined(NET_STORAGE_HOSTNAME) && defined(NET_STORAGE_PORT) && defined(NET_STORAGE_PK)
     while (true) {
-        Net::SyncSocket socket(NET_STORAGE_HOSTNAME, NET_STORAGE_PORT, serverPK, "storage ");
+        // Read-aheads are sent before the responses to the previous requests are read.
+        Net::SyncSocket socket(NET_STORAGE_HOSTNAME, NET_STORAGE_PORT, serverPK, "storage ",
+                true);
         if (socket.ok()) {
             m_socketRaw = std::move(socket);
             m_socket = Net::ProtoSocket<NetStorageResponse, NetStorageRequest, Net::SyncSocket>(
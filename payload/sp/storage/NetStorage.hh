@@ -30,6 +30,7 @@ public:
     std::optional<FileHandle> startBenchmark() override;
     void endBenchmark() override;
     u32 getMessageId() override;
+    ReadQueueConfig readQueueConfig() override;
 
 private:
     class File : public IFile {
@@ -38,13 +39,17 @@ private:
         bool close() override;
         bool read(void *dst, u32 size, u32 offset) override;
         bool write(const void *src, u32 size, u32 offset) override;
+        // Sends the ranges in as few requests as possible, in file order.
+        bool readv(const ReadRange *ranges, u32 count) override;
         bool sync() override;
         u64 size() override;
+        IStorage *storage() override;
 
     private:
         NetStorage *m_storage = nullptr;
         std::optional<u32> m_handle{};
         u64 m_size;
+        u64 m_nextReadOffset = 0;
 
         friend class NetStorage;
     };
@@ -54,6 +59,8 @@ private:
         std::optional<DirHandle> clone() override;
         bool close() override;
         std::optional<NodeInfo> read() override;
+        // Gets the whole batch in a single round trip.
+        u32 readBatch(NodeInfo *infos, u32 count) override;
 
     private:
         NetStorage *m_storage = nullptr;
@@ -62,6 +69,17 @@ private:
         friend class NetStorage;
     };
 
+    // A read request that was sent ahead of the matching read call. The responses arrive in
+    // order, so they have to be consumed or drained before anything else is read from the socket.
+    struct ReadAhead {
+        File *file;
+        u32 id;
+        u32 size;
+        u64 offset;
+    };
+
+    bool writeRequest(NetStorageRequest &request, const char *name);
+    bool sendRequest(NetStorageRequest &request, const char *name);
     bool writeFastOpen(u64 id);
     bool writeOpen(const wchar_t *path, const char *mode);
     bool writeClone(u32 handle);
@@ -73,13 +91,26 @@ private:
     bool writeCloneDir(u32 handle);
     bool writeCloseDir(u32 handle);
     bool writeReadDir(u32 handle);
+    bool writeReadDirBatch(u32 handle, u32 count);
     bool writeStat(const wchar_t *path);
     bool writeStartBenchmark();
+    bool writeReadRanges(u32 handle, const ReadRange *const *ranges, u32 count);
 
     std::optional<FileHandle> readOpen(File *file);
     std::optional<DirHandle> readOpenDir(Dir *dir);
     std::optional<NodeInfo> readNodeInfo();
+    u32 readNodeInfos(NodeInfo *infos, u32 count);
+    NodeInfo convertNodeInfo(const NetStorageResponse_NodeInfo &nodeInfo);
     bool readOk();
+    bool readData(void *dst, u32 size);
+    bool discardData(u32 size);
+    std::expected<std::optional<NetStorageResponse>, const wchar_t *> readResponse();
+
+    // Queues reads of the chunks that follow a sequential read of size bytes.
+    void readAhead(File *file, u32 size, u64 offset);
+    // Returns whether the read was served by the oldest read-ahead.
+    bool readReadAhead(File *file, void *dst, u32 size, u64 offset);
+    bool drainReadAheads();
 
     void connect();
 
@@ -91,6 +122,11 @@ private:
                 [](const auto &node) { return !node.m_handle; });
     }
 
+    static constexpr u32 CHUNK_SIZE = 0x8000 /* 32 KiB */;
+    static constexpr u32 READ_AHEAD_DEPTH = 4;
+    // Smaller reads are usually headers rather than streams.
+    static constexpr u32 READ_AHEAD_MIN_SIZE = 0x1000 /* 4 KiB */;
+
     Mutex m_mutex{};
     u8 m_stack[4096];
     OSThread m_thread;
@@ -99,6 +135,11 @@ private:
             m_socket;
     File m_files[32];
     Dir m_dirs[32];
+    u32 m_requestId = 0;
+    u32 m_responseId = 0;
+    ReadAhead m_readAheads[READ_AHEAD_DEPTH];
+    u32 m_readAheadCount = 0;
+    u8 m_discardBuffer[CHUNK_SIZE];
 
     static const u8 serverPK[hydro_kx_PUBLICKEYBYTES];
 };
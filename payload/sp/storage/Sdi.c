@@ -259,6 +259,42 @@ static bool Sdi_transferAligned(bool isWrite, u32 firstSector, u32 sectorCount,
             buffer, NULL);
 }
 
+static bool Sdi_writeUnaligned(u32 firstSector, u32 sectorCount, const u8 *buffer) {
+    while (sectorCount > 0) {
+        u32 chunkSectorCount = MIN(sectorCount, TMP_SECTOR_COUNT);
+        memcpy(tmpBuffer, buffer, chunkSectorCount * SECTOR_SIZE);
+        if (!Sdi_transferAligned(true, firstSector, chunkSectorCount, tmpBuffer)) {
+            return false;
+        }
+        firstSector += chunkSectorCount;
+        sectorCount -= chunkSectorCount;
+        buffer += chunkSectorCount * SECTOR_SIZE;
+    }
+
+    return true;
+}
+
+static bool Sdi_readUnaligned(u32 firstSector, u32 sectorCount, u8 *buffer) {
+    // IOS can only DMA to 32-byte aligned addresses. All sectors but the first one are read in a
+    // single request to the aligned address just below their destination, and shifted up in place.
+    // Only the first sector has to go through the temporary buffer.
+    if (sectorCount > 1) {
+        u32 misalignment = (u32)buffer & 0x1f;
+        u8 *alignedBuffer = buffer + SECTOR_SIZE - misalignment;
+        if (!Sdi_transferAligned(false, firstSector + 1, sectorCount - 1, alignedBuffer)) {
+            return false;
+        }
+        memmove(buffer + SECTOR_SIZE, alignedBuffer, (sectorCount - 1) * SECTOR_SIZE);
+    }
+
+    if (!Sdi_transferAligned(false, firstSector, 1, tmpBuffer)) {
+        return false;
+    }
+    memcpy(buffer, tmpBuffer, SECTOR_SIZE);
+
+    return true;
+}
+
 static bool Sdi_transfer(bool isWrite, u32 firstSector, u32 sectorCount, void *buffer) {
     assert(buffer);
 
@@ -266,33 +302,18 @@ static bool Sdi_transfer(bool isWrite, u32 firstSector, u32 sectorCount, void *b
         return false;
     }
 
-    if ((u32)buffer & 0x1f) {
-        while (sectorCount > 0) {
-            u32 chunkSectorCount = MIN(sectorCount, TMP_SECTOR_COUNT);
-            if (isWrite) {
-                memcpy(tmpBuffer, buffer, chunkSectorCount * SECTOR_SIZE);
-            }
-            if (!Sdi_transferAligned(isWrite, firstSector, chunkSectorCount, tmpBuffer)) {
-                Sdi_deselect();
-                return false;
-            }
-            if (!isWrite) {
-                memcpy(buffer, tmpBuffer, chunkSectorCount * SECTOR_SIZE);
-            }
-            firstSector += chunkSectorCount;
-            sectorCount -= chunkSectorCount;
-            buffer += chunkSectorCount * SECTOR_SIZE;
-        }
+    bool result;
+    if (!((u32)buffer & 0x1f)) {
+        result = Sdi_transferAligned(isWrite, firstSector, sectorCount, buffer);
+    } else if (isWrite) {
+        result = Sdi_writeUnaligned(firstSector, sectorCount, buffer);
     } else {
-        if (!Sdi_transferAligned(isWrite, firstSector, sectorCount, buffer)) {
-            Sdi_deselect();
-            return false;
-        }
+        result = Sdi_readUnaligned(firstSector, sectorCount, buffer);
     }
 
     Sdi_deselect();
 
-    return true;
+    return result;
 }
 
 static u32 Sdi_sectorSize(void) {
@@ -0,0 +1,241 @@
+#include "SectorCache.hh"
+
+extern "C" {
+#include <revolution.h>
+#include <sp/Commands.h>
+}
+
+#include <cstring>
+
+namespace SP::Storage::SectorCache {
+
+struct Entry {
+    u32 sector;
+    u16 hashNext;
+    u16 lruPrev;
+    u16 lruNext;
+    bool isValid;
+};
+
+static const u32 CACHE_SIZE = 0x40000 /* 256 KiB */;
+static const u16 MAX_ENTRY_COUNT = CACHE_SIZE / 512;
+static const u16 NONE = 0xffff;
+
+static const ::FATStorage *storage = nullptr;
+static const void *metadataBuffer = nullptr;
+static u8 *buffer = nullptr;
+static u32 sectorSize = 0;
+static u16 entryCount = 0;
+static Entry entries[MAX_ENTRY_COUNT];
+static u16 buckets[MAX_ENTRY_COUNT];
+// The head is the most recently used entry, the tail is the next one to be evicted.
+static u16 lruHead = NONE;
+static u16 lruTail = NONE;
+static Stats stats{};
+
+static u8 *GetData(u16 index) {
+    return buffer + index * sectorSize;
+}
+
+static u16 Find(u32 sector) {
+    for (u16 index = buckets[sector % entryCount]; index != NONE; index = entries[index].hashNext) {
+        if (entries[index].sector == sector) {
+            return index;
+        }
+    }
+    return NONE;
+}
+
+static void Unlink(u16 index) {
+    Entry &entry = entries[index];
+    if (entry.lruPrev != NONE) {
+        entries[entry.lruPrev].lruNext = entry.lruNext;
+    } else {
+        lruHead = entry.lruNext;
+    }
+    if (entry.lruNext != NONE) {
+        entries[entry.lruNext].lruPrev = entry.lruPrev;
+    } else {
+        lruTail = entry.lruPrev;
+    }
+}
+
+static void PushFront(u16 index) {
+    Entry &entry = entries[index];
+    entry.lruPrev = NONE;
+    entry.lruNext = lruHead;
+    if (lruHead != NONE) {
+        entries[lruHead].lruPrev = index;
+    } else {
+        lruTail = index;
+    }
+    lruHead = index;
+}
+
+static void PushBack(u16 index) {
+    Entry &entry = entries[index];
+    entry.lruPrev = lruTail;
+    entry.lruNext = NONE;
+    if (lruTail != NONE) {
+        entries[lruTail].lruNext = index;
+    } else {
+        lruHead = index;
+    }
+    lruTail = index;
+}
+
+static void Unhash(u16 index) {
+    u16 *next = &buckets[entries[index].sector % entryCount];
+    while (*next != index) {
+        next = &entries[*next].hashNext;
+    }
+    *next = entries[index].hashNext;
+}
+
+static void Invalidate(u32 firstSector, u32 sectorCount) {
+    for (u32 sector = firstSector; sector < firstSector + sectorCount; sector++) {
+        u16 index = Find(sector);
+        if (index == NONE) {
+            continue;
+        }
+        Unhash(index);
+        entries[index].isValid = false;
+        Unlink(index);
+        PushBack(index);
+    }
+}
+
+static void Insert(u32 sector, const void *src) {
+    u16 index = lruTail;
+    Entry &entry = entries[index];
+    if (entry.isValid) {
+        Unhash(index);
+    }
+    entry.sector = sector;
+    entry.isValid = true;
+    u16 &bucket = buckets[sector % entryCount];
+    entry.hashNext = bucket;
+    bucket = index;
+    memcpy(GetData(index), src, sectorSize);
+    Unlink(index);
+    PushFront(index);
+}
+
+void Init(const ::FATStorage *newStorage, const void *newMetadataBuffer) {
+    // The storage may be initialized several times while waiting for a device to be inserted.
+    if (!buffer) {
+        buffer = reinterpret_cast<u8 *>(OSAllocFromMEM2ArenaLo(CACHE_SIZE, 0x20));
+    }
+
+    storage = newStorage;
+    metadataBuffer = newMetadataBuffer;
+    sectorSize = storage->diskSectorSize();
+    entryCount = sectorSize > CACHE_SIZE ? 0 : CACHE_SIZE / sectorSize;
+    lruHead = NONE;
+    lruTail = NONE;
+    for (u16 index = 0; index < entryCount; index++) {
+        entries[index].isValid = false;
+        buckets[index] = NONE;
+        PushBack(index);
+    }
+    stats = {};
+}
+
+bool Read(u32 firstSector, u32 sectorCount, void *dst) {
+    bool isMetadata = dst == metadataBuffer;
+    u32 &hits = isMetadata ? stats.metadataHits : stats.dataHits;
+    u32 &misses = isMetadata ? stats.metadataMisses : stats.dataMisses;
+    if (entryCount == 0) {
+        misses += sectorCount;
+        return storage->diskRead(firstSector, sectorCount, dst);
+    }
+
+    if (sectorCount == 1) {
+        u16 index = Find(firstSector);
+        if (index != NONE) {
+            memcpy(dst, GetData(index), sectorSize);
+            Unlink(index);
+            PushFront(index);
+            hits++;
+            return true;
+        }
+        misses++;
+        if (!storage->diskRead(firstSector, sectorCount, dst)) {
+            return false;
+        }
+        Insert(firstSector, dst);
+        return true;
+    }
+
+    // Multi-sector reads go straight to the file buffers of the caller. They are only served from
+    // the cache as a whole, and never inserted, so that streaming a large file doesn't evict the
+    // FAT and directory sectors.
+    for (u32 i = 0; i < sectorCount; i++) {
+        if (Find(firstSector + i) == NONE) {
+            misses += sectorCount;
+            return storage->diskRead(firstSector, sectorCount, dst);
+        }
+    }
+    for (u32 i = 0; i < sectorCount; i++) {
+        u16 index = Find(firstSector + i);
+        memcpy(reinterpret_cast<u8 *>(dst) + i * sectorSize, GetData(index), sectorSize);
+    }
+    hits += sectorCount;
+    return true;
+}
+
+bool Write(u32 firstSector, u32 sectorCount, const void *src) {
+    if (!storage->diskWrite(firstSector, sectorCount, src)) {
+        Invalidate(firstSector, sectorCount);
+        return false;
+    }
+
+    if (entryCount == 0) {
+        return true;
+    }
+
+    if (sectorCount == 1) {
+        u16 index = Find(firstSector);
+        if (index != NONE) {
+            memcpy(GetData(index), src, sectorSize);
+        } else {
+            Insert(firstSector, src);
+        }
+        return true;
+    }
+
+    for (u32 i = 0; i < sectorCount; i++) {
+        u16 index = Find(firstSector + i);
+        if (index != NONE) {
+            memcpy(GetData(index), reinterpret_cast<const u8 *>(src) + i * sectorSize,
+                    sectorSize);
+        }
+    }
+    return true;
+}
+
+bool Erase(u32 firstSector, u32 sectorCount) {
+    if (entryCount != 0) {
+        Invalidate(firstSector, sectorCount);
+    }
+    return storage->diskErase(firstSector, sectorCount);
+}
+
+Stats GetStats() {
+    return stats;
+}
+
+static u32 GetHitRate(u32 hits, u32 misses) {
+    return hits + misses == 0 ? 0 : static_cast<u64>(hits) * 100 / (hits + misses);
+}
+
+sp_define_command("/sector_cache_stats", "Show the hit rates of the FAT sector cache",
+        const char *) {
+    auto stats = GetStats();
+    OSReport("sector_cache_stats: metadata %u hits, %u misses (%u%%)\n", stats.metadataHits,
+            stats.metadataMisses, GetHitRate(stats.metadataHits, stats.metadataMisses));
+    OSReport("sector_cache_stats: data %u hits, %u misses (%u%%)\n", stats.dataHits,
+            stats.dataMisses, GetHitRate(stats.dataHits, stats.dataMisses));
+}
+
+} // namespace SP::Storage::SectorCache
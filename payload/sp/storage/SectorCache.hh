@@ -0,0 +1,23 @@
+#pragma once
+
+extern "C" {
+#include "sp/storage/FATStorage.h"
+}
+
+namespace SP::Storage::SectorCache {
+
+struct Stats {
+    u32 metadataHits;
+    u32 metadataMisses;
+    u32 dataHits;
+    u32 dataMisses;
+};
+
+// Metadata sectors are the ones FatFs reads into its window, that is FAT and directory sectors.
+void Init(const ::FATStorage *storage, const void *metadataBuffer);
+bool Read(u32 firstSector, u32 sectorCount, void *buffer);
+bool Write(u32 firstSector, u32 sectorCount, const void *buffer);
+bool Erase(u32 firstSector, u32 sectorCount);
+Stats GetStats();
+
+} // namespace SP::Storage::SectorCache
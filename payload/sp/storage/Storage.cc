@@ -2,10 +2,16 @@
 
 #include "sp/storage/DVDStorage.hh"
 #include "sp/storage/FATStorage.hh"
+#include "sp/storage/IOScheduler.hh"
 #include "sp/storage/NANDArchiveStorage.hh"
 #include "sp/storage/NetStorage.hh"
 
 #include <common/Bytes.hh>
+extern "C" {
+#include <sp/Commands.h>
+}
+
+#include <cstring>
 
 namespace SP::Storage {
 
@@ -15,6 +21,26 @@ static std::optional<NANDArchiveStorage> nandArchiveStorage{};
 static DVDStorage dvdStorage;
 static std::optional<BenchmarkStatus> benchmarkStatus{};
 
+bool IFile::readv(const ReadRange *ranges, u32 count) {
+    for (u32 i = 0; i < count; i++) {
+        if (!read(ranges[i].dst, ranges[i].size, ranges[i].offset)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+u32 IDir::readBatch(NodeInfo *infos, u32 count) {
+    for (u32 i = 0; i < count; i++) {
+        auto info = read();
+        if (!info) {
+            return i;
+        }
+        infos[i] = *info;
+    }
+    return count;
+}
+
 FileHandle::FileHandle(IFile *file) : m_file(file) {}
 
 FileHandle::FileHandle(FileHandle &&that) : m_file(that.m_file) {
@@ -40,13 +66,36 @@ std::optional<FileHandle> FileHandle::clone() {
 bool FileHandle::read(void *dst, u32 size, u32 offset) {
     assert(dst);
 
-    return m_file->read(dst, size, offset);
+    return IOScheduler::Transfer(m_file, false, reinterpret_cast<u8 *>(dst), size, offset);
 }
 
 bool FileHandle::write(const void *src, u32 size, u32 offset) {
     assert(src);
 
-    return m_file->write(src, size, offset);
+    auto *buffer = const_cast<u8 *>(reinterpret_cast<const u8 *>(src));
+    return IOScheduler::Transfer(m_file, true, buffer, size, offset);
+}
+
+bool FileHandle::readv(const ReadRange *ranges, u32 count) {
+    assert(ranges);
+    assert(count <= MAX_READ_RANGE_COUNT);
+
+    return IOScheduler::TransferRanges(m_file, ranges, count);
+}
+
+std::optional<IORequestHandle> FileHandle::readAsync(void *dst, u32 size, u32 offset,
+        IOPriority priority) {
+    assert(dst);
+
+    return IOScheduler::Submit(m_file, false, reinterpret_cast<u8 *>(dst), size, offset, priority);
+}
+
+std::optional<IORequestHandle> FileHandle::writeAsync(const void *src, u32 size, u32 offset,
+        IOPriority priority) {
+    assert(src);
+
+    auto *buffer = const_cast<u8 *>(reinterpret_cast<const u8 *>(src));
+    return IOScheduler::Submit(m_file, true, buffer, size, offset, priority);
 }
 
 bool FileHandle::sync() {
@@ -57,6 +106,10 @@ u64 FileHandle::size() {
     return m_file->size();
 }
 
+IStorage *FileHandle::storage() {
+    return m_file->storage();
+}
+
 DirHandle::DirHandle(IDir *dir) : m_dir(dir) {}
 
 DirHandle::DirHandle(DirHandle &&that) : m_dir(that.m_dir) {
@@ -83,7 +136,15 @@ std::optional<NodeInfo> DirHandle::read() {
     return m_dir->read();
 }
 
+u32 DirHandle::readBatch(NodeInfo *infos, u32 count) {
+    assert(infos);
+
+    return m_dir->readBatch(infos, count);
+}
+
 bool Init() {
+    IOScheduler::Init();
+
     if (!netStorage) {
         netStorage.emplace();
     }
@@ -290,6 +351,17 @@ bool Remove(const wchar_t *path, bool allowNop) {
     return Dispatch(&IStorage::remove, path, allowNop);
 }
 
+void SortReadRanges(const ReadRange *ranges, u32 count,
+        const ReadRange *(&sortedRanges)[MAX_READ_RANGE_COUNT]) {
+    assert(count <= MAX_READ_RANGE_COUNT);
+
+    for (u32 i = 0; i < count; i++) {
+        sortedRanges[i] = &ranges[i];
+    }
+    std::sort(sortedRanges, sortedRanges + count,
+            [](const auto *a, const auto *b) { return a->offset < b->offset; });
+}
+
 static std::optional<Throughputs> Benchmark(FileHandle file, void *buffer) {
     for (u32 i = 0; i < 8; i++) {
         u8 seed[hydro_random_SEEDBYTES] = {};
@@ -337,6 +409,29 @@ static std::optional<Throughputs> Benchmark(FileHandle file, void *buffer) {
             throughputs.read[i] = OSSecondsToTicks(UINT64_C(8) * BENCHMARK_BUFFER_SIZE) / duration;
         }
 
+        {
+            u8 *unalignedBuffer = reinterpret_cast<u8 *>(buffer) + 0x4;
+            OSTime startTime = OSGetTime();
+            for (u32 j = 0; j < count; j++) {
+                u8 seed[hydro_random_SEEDBYTES] = {};
+                Bytes::Write<u32>(seed, 0, i);
+                Bytes::Write<u32>(seed, 4, j);
+
+                u32 k;
+                hydro_random_buf_deterministic(&k, sizeof(k), seed);
+                k %= count;
+
+                if (!file.read(unalignedBuffer, sizes[i], k * sizes[i])) {
+                    ScopeLock<NoInterrupts> lock;
+                    benchmarkStatus.reset();
+                    return {};
+                }
+            }
+            OSTime duration = OSGetTime() - startTime;
+            throughputs.unalignedRead[i] =
+                    OSSecondsToTicks(UINT64_C(8) * BENCHMARK_BUFFER_SIZE) / duration;
+        }
+
         {
             {
                 ScopeLock<NoInterrupts> lock;
@@ -363,6 +458,48 @@ static std::optional<Throughputs> Benchmark(FileHandle file, void *buffer) {
         }
     }
 
+    u32 fileSizes[] = {8 * BENCHMARK_BUFFER_SIZE, 16 * BENCHMARK_BUFFER_SIZE,
+            32 * BENCHMARK_BUFFER_SIZE};
+    u32 readSize = 4 * 1024;
+    u32 readCount = 512;
+    for (u32 i = 0; i < std::size(fileSizes); i++) {
+        throughputs.fileSizes[i] = fileSizes[i];
+        for (u32 offset = file.size(); offset < fileSizes[i]; offset += BENCHMARK_BUFFER_SIZE) {
+            if (!file.write(buffer, BENCHMARK_BUFFER_SIZE, offset)) {
+                ScopeLock<NoInterrupts> lock;
+                benchmarkStatus.reset();
+                return {};
+            }
+        }
+
+        {
+            ScopeLock<NoInterrupts> lock;
+            benchmarkStatus = {readSize, BenchmarkStatus::Mode::Read};
+        }
+        u32 count = fileSizes[i] / readSize;
+        OSTime startTime = OSGetTime();
+        for (u32 j = 0; j < readCount; j++) {
+            u8 seed[hydro_random_SEEDBYTES] = {};
+            Bytes::Write<u32>(seed, 0, std::size(sizes) + i);
+            Bytes::Write<u32>(seed, 4, j);
+
+            u32 k;
+            hydro_random_buf_deterministic(&k, sizeof(k), seed);
+            k %= count;
+
+            if (!file.read(buffer, readSize, k * readSize)) {
+                ScopeLock<NoInterrupts> lock;
+                benchmarkStatus.reset();
+                return {};
+            }
+        }
+        OSTime duration = OSGetTime() - startTime;
+        throughputs.randomRead[i] = OSSecondsToTicks(static_cast<u64>(readCount) * readSize) /
+                duration;
+        SP_LOG("Random %u KiB reads in a %u MiB file: %u KiB/s", readSize / 1024,
+                fileSizes[i] / (1024 * 1024), throughputs.randomRead[i] / 1024);
+    }
+
     ScopeLock<NoInterrupts> lock;
     benchmarkStatus.reset();
     return throughputs;
@@ -378,7 +515,8 @@ std::optional<Throughputs> Benchmark(StorageType type, void *buffer) {
         return {};
     }
 
-    auto result = Benchmark(std::move(*file), buffer);
+    auto *alignedBuffer = reinterpret_cast<void *>(OSRoundUp32B(buffer));
+    auto result = Benchmark(std::move(*file), alignedBuffer);
 
     storage->endBenchmark();
 
@@ -394,4 +532,59 @@ u32 GetMessageId(StorageType type) {
     return storage ? storage->getMessageId() : 0;
 }
 
+sp_define_command("/bench_readv", "Compare separate and vectored reads of a file",
+        const char *tmp) {
+    char path[128] = {};
+    if (sscanf(tmp, "/bench_readv %127s", path) != 1) {
+        OSReport("&abench_readv: Usage: /bench_readv <path>\n");
+        return;
+    }
+    wchar_t widePath[128];
+    swprintf(widePath, std::size(widePath), L"%s", path);
+
+    auto file = Open(widePath, "r");
+    if (!file) {
+        OSReport("&abench_readv: Failed to open %s\n", path);
+        return;
+    }
+
+    // Pairs of ranges that are contiguous both in the file and in memory, scattered backwards
+    // through the file so that the backends have to sort them.
+    constexpr u32 rangeSize = 0x40;
+    constexpr u32 pairCount = MAX_READ_RANGE_COUNT / 2;
+    u32 stride = file->size() / pairCount & ~0x1f;
+    if (stride < 2 * rangeSize) {
+        OSReport("&abench_readv: %s is too small\n", path);
+        return;
+    }
+    alignas(0x20) static u8 buffers[2][MAX_READ_RANGE_COUNT * rangeSize];
+    ReadRange ranges[MAX_READ_RANGE_COUNT];
+    for (u32 i = 0; i < MAX_READ_RANGE_COUNT; i++) {
+        u32 offset = (pairCount - 1 - i / 2) * stride + i % 2 * rangeSize;
+        ranges[i] = {buffers[1] + i * rangeSize, rangeSize, offset};
+    }
+    memset(buffers, 0, sizeof(buffers));
+
+    OSTime startTime = OSGetTime();
+    for (u32 i = 0; i < MAX_READ_RANGE_COUNT; i++) {
+        if (!file->read(buffers[0] + i * rangeSize, rangeSize, ranges[i].offset)) {
+            OSReport("&abench_readv: Failed to read range %u\n", i);
+            return;
+        }
+    }
+    OSTime readDuration = OSGetTime() - startTime;
+
+    startTime = OSGetTime();
+    if (!file->readv(ranges, MAX_READ_RANGE_COUNT)) {
+        OSReport("&abench_readv: Failed to read the ranges\n");
+        return;
+    }
+    OSTime readvDuration = OSGetTime() - startTime;
+
+    bool matches = !memcmp(buffers[0], buffers[1], sizeof(buffers[0]));
+    OSReport("bench_readv: %s, %u ranges: read %u us, readv %u us\n", matches ? "ok" : "MISMATCH",
+            MAX_READ_RANGE_COUNT, static_cast<u32>(OSTicksToNanoseconds(readDuration) / 1000),
+            static_cast<u32>(OSTicksToNanoseconds(readvDuration) / 1000));
+}
+
 } // namespace SP::Storage
@@ -37,6 +37,57 @@ struct NodeInfo {
     }
 };
 
+// How streaming readers such as DecompLoader should split up a file. More chunks in flight hide
+// more latency, larger chunks amortize the per-request overhead.
+struct ReadQueueConfig {
+    u32 depth;
+    u32 chunkSize;
+};
+
+// Classes of I/O from the most to the least latency sensitive. The storage worker always serves the
+// most urgent pending request first.
+enum class IOPriority {
+    Stream,     // Music streaming, which stutters if it falls behind
+    Course,     // Loading the next scene, the default
+    UI,         // Thumbnails and other things shown in menus
+    Background, // Scans and caches that nobody is waiting on
+};
+
+struct IOStats {
+    u32 requestCount;
+    u32 queueDepth;
+    u32 maxQueueDepth;
+    OSTime totalLatency; // From submission to completion
+    OSTime maxLatency;
+};
+
+// One extent of a vectored read.
+struct ReadRange {
+    void *dst;
+    u32 size;
+    u32 offset;
+};
+
+static constexpr u32 MAX_READ_RANGE_COUNT = 64;
+
+struct IORequest;
+
+class IORequestHandle {
+public:
+    IORequestHandle(IORequest *request);
+    IORequestHandle(const IORequestHandle &) = delete;
+    IORequestHandle(IORequestHandle &&);
+    IORequestHandle &operator=(IORequestHandle &&);
+    ~IORequestHandle();
+
+    bool isDone() const;
+    // Blocks until the request is complete and returns whether it succeeded.
+    bool wait();
+
+private:
+    IORequest *m_request;
+};
+
 class FileHandle;
 
 class IFile {
@@ -45,8 +96,11 @@ public:
     virtual bool close() = 0;
     virtual bool read(void *dst, u32 size, u32 offset) = 0;
     virtual bool write(const void *src, u32 size, u32 offset) = 0;
+    // Reads each range in turn by default, backends which can do better override it.
+    virtual bool readv(const ReadRange *ranges, u32 count);
     virtual bool sync() = 0;
     virtual u64 size() = 0;
+    virtual IStorage *storage() = 0;
 };
 
 class DirHandle;
@@ -56,6 +110,9 @@ public:
     virtual std::optional<DirHandle> clone() = 0;
     virtual bool close() = 0;
     virtual std::optional<NodeInfo> read() = 0;
+    // Reads up to count entries and returns how many were read, fewer than count once the end is
+    // reached. Calls read for each entry by default.
+    virtual u32 readBatch(NodeInfo *infos, u32 count);
 };
 
 class FileHandle {
@@ -69,10 +126,19 @@ public:
     bool operator==(const FileHandle &) const = default;
 
     std::optional<FileHandle> clone();
+    // Goes through the storage worker with the I/O priority of the current thread.
     bool read(void *dst, u32 size, u32 offset);
     bool write(const void *src, u32 size, u32 offset);
+    // Reads up to MAX_READ_RANGE_COUNT ranges in one go, in whichever order suits the backend.
+    bool readv(const ReadRange *ranges, u32 count);
+    // The file and the buffer must stay valid until the request is complete. Fails if too many
+    // requests are in flight.
+    std::optional<IORequestHandle> readAsync(void *dst, u32 size, u32 offset, IOPriority priority);
+    std::optional<IORequestHandle> writeAsync(const void *src, u32 size, u32 offset,
+            IOPriority priority);
     bool sync();
     u64 size();
+    IStorage *storage();
 
 private:
     IFile *m_file;
@@ -90,6 +156,7 @@ public:
     bool operator==(const DirHandle &) const = default;
 
     std::optional<NodeInfo> read();
+    u32 readBatch(NodeInfo *infos, u32 count);
 
 private:
     IDir *m_dir;
@@ -111,6 +178,7 @@ public:
     virtual std::optional<FileHandle> startBenchmark() = 0;
     virtual void endBenchmark() = 0;
     virtual u32 getMessageId() = 0;
+    virtual ReadQueueConfig readQueueConfig() = 0;
 };
 
 enum class StorageType {
@@ -123,7 +191,12 @@ enum class StorageType {
 struct Throughputs {
     u32 sizes[4];
     u32 read[4];
+    // Reads into a buffer that is not 32-byte aligned, as many game heap allocations aren't.
+    u32 unalignedRead[4];
     u32 write[4];
+    // Small random reads in increasingly large files, which stresses seeking.
+    u32 fileSizes[3];
+    u32 randomRead[3];
 };
 
 struct BenchmarkStatus {
@@ -156,7 +229,20 @@ std::optional<NodeInfo> Stat(const wchar_t *path);
 bool Rename(const wchar_t *srcPath, const wchar_t *dstPath);
 bool Remove(const wchar_t *path, bool allowNop);
 
+// Fills sortedRanges with the ranges in file order, which backends use to merge and batch them.
+void SortReadRanges(const ReadRange *ranges, u32 count,
+        const ReadRange *(&sortedRanges)[MAX_READ_RANGE_COUNT]);
+
+IOPriority GetIOPriority(OSThread *thread);
+// Sets the priority of the synchronous file reads and writes made by thread. Only 16 threads can have
+// another priority than Course, so setting Course back is needed before a thread is destroyed,
+// unless it is static.
+void SetIOPriority(OSThread *thread, IOPriority priority);
+IOStats GetIOStats(IOPriority priority);
+
 static constexpr u32 BENCHMARK_BUFFER_SIZE = 1024 * 1024;
+// The room needed on top of BENCHMARK_BUFFER_SIZE to align the buffer and then misalign it.
+static constexpr u32 BENCHMARK_BUFFER_PADDING = 0x40;
 std::optional<Throughputs> Benchmark(StorageType type, void *buffer);
 std::optional<BenchmarkStatus> GetBenchmarkStatus();
 u32 GetMessageId(StorageType type);
@@ -28,6 +28,14 @@ enum {
     CBW_SIZE = 0xd,
 };
 
+enum {
+    // The length of a bulk transfer is 16-bit, keep chunks a multiple of the sector size.
+    MAX_CHUNK_SIZE = 0xf000,
+    BUFFER_SIZE = 0x4000,
+    // A multiple of the maximum packet size, so that the device doesn't send more than requested.
+    HEAD_SIZE = 0x200,
+};
+
 enum {
     SCSI_TEST_UNIT_READY = 0x0,
     SCSI_REQUEST_SENSE = 0x3,
@@ -64,6 +72,63 @@ static bool UsbStorage_getLunCount(u8 *lunCount) {
     return *lunCount >= 1 && *lunCount <= 16;
 }
 
+static bool UsbStorage_transferChunks(bool isWrite, u32 size, u8 *data) {
+    u8 endpoint = isWrite ? outEndpoint : inEndpoint;
+    while (size > 0) {
+        u32 chunkSize = MIN(size, MAX_CHUNK_SIZE);
+        if (!Usb_bulkTransfer(id, endpoint, chunkSize, data)) {
+            return false;
+        }
+        size -= chunkSize;
+        data += chunkSize;
+    }
+
+    return true;
+}
+
+static bool UsbStorage_transferData(bool isWrite, u32 size, u8 *data) {
+    // The DMA has to end on a 32-byte boundary too, so transfers of any other size, such as the
+    // small SCSI responses, always go through the buffer.
+    bool isBlockSized = size % 0x20 == 0;
+    u32 misalignment = (u32)data & 0x1f;
+    if (!misalignment && isBlockSized) {
+        return UsbStorage_transferChunks(isWrite, size, data);
+    }
+
+    if (isWrite || size <= HEAD_SIZE || !isBlockSized) {
+        while (size > 0) {
+            u32 chunkSize = MIN(size, BUFFER_SIZE);
+            if (isWrite) {
+                memcpy(buffer, data, chunkSize);
+            }
+            if (!Usb_bulkTransfer(id, isWrite ? outEndpoint : inEndpoint, chunkSize, buffer)) {
+                return false;
+            }
+            if (!isWrite) {
+                memcpy(data, buffer, chunkSize);
+            }
+            size -= chunkSize;
+            data += chunkSize;
+        }
+        return true;
+    }
+
+    // IOS can only DMA to 32-byte aligned addresses. Everything after the head is read to the
+    // aligned address just below its destination, and shifted up in place. Only the head has to
+    // go through the buffer.
+    if (!Usb_bulkTransfer(id, inEndpoint, HEAD_SIZE, buffer)) {
+        return false;
+    }
+    u8 *alignedData = data + HEAD_SIZE - misalignment;
+    if (!UsbStorage_transferChunks(false, size - HEAD_SIZE, alignedData)) {
+        return false;
+    }
+    memmove(data + HEAD_SIZE, alignedData, size - HEAD_SIZE);
+    memcpy(data, buffer, HEAD_SIZE);
+
+    return true;
+}
+
 static bool UsbStorage_scsiTransfer(bool isWrite, u32 size, void *data, u8 lun, u8 cbSize,
         void *cb) {
     assert(!!size == !!data);
@@ -87,20 +152,8 @@ static bool UsbStorage_scsiTransfer(bool isWrite, u32 size, void *data, u8 lun,
         return false;
     }
 
-    u32 remainingSize = size;
-    while (remainingSize > 0) {
-        u32 chunkSize = MIN(remainingSize, 0x4000);
-        if (isWrite) {
-            memcpy(buffer, data, chunkSize);
-        }
-        if (!Usb_bulkTransfer(id, isWrite ? outEndpoint : inEndpoint, chunkSize, buffer)) {
-            return false;
-        }
-        if (!isWrite) {
-            memcpy(data, buffer, chunkSize);
-        }
-        remainingSize -= chunkSize;
-        data += chunkSize;
+    if (size > 0 && !UsbStorage_transferData(isWrite, size, data)) {
+        return false;
     }
 
     memset(buffer, 0, CBW_SIZE);
@@ -361,7 +414,7 @@ static const FATStorage usbStorage = {
 
 bool UsbStorage_init(const FATStorage **fatStorage) {
     if (!buffer) {
-        buffer = OSAllocFromMEM2ArenaLo(0x4000, 0x20);
+        buffer = OSAllocFromMEM2ArenaLo(BUFFER_SIZE, 0x20);
     }
 
     Usb_addHandler(&handler);
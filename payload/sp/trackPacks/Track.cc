@@ -55,10 +55,19 @@ void Track::applyToConfig(System::RaceConfig *raceConfig, bool inRace) const {
     spScenario->courseSha = m_sha1;
     spScenario->nameReplacement = m_name;
     spScenario->musicReplacement = m_musicId;
+    spScenario->pathReplacement = pathReplacement();
+}
+
+FixedString<64> Track::pathReplacement() const {
+    FixedString<64> path;
+    auto *globalContext = UI::SectionManager::Instance()->globalContext();
+    if (globalContext->isVanillaTracks()) {
+        return path;
+    }
 
     auto hex = sha1ToHex(m_sha1);
-    spScenario->pathReplacement.m_len = snprintf(spScenario->pathReplacement.m_buf.data(), 64,
-            "Tracks/%s.arc.lzma", hex.data());
+    path.m_len = snprintf(path.m_buf.data(), path.m_buf.size(), "Tracks/%s.arc.lzma", hex.data());
+    return path;
 }
 
 } // namespace SP
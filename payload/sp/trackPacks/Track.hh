@@ -26,6 +26,8 @@ public:
 
     static Track FromFile(std::span<u8> manifestBuf, Sha1 sha1);
     void applyToConfig(System::RaceConfig *raceConfig, bool inRace) const;
+    // The archive to load instead of the course slot's, empty when playing the vanilla tracks.
+    FixedString<64> pathReplacement() const;
 
     Sha1 m_sha1;
     Registry::Course m_courseId;
@@ -73,29 +73,37 @@ void TrackPackManager::loadTrackPacks() {
     }
 
     std::vector<u8> manifestBuf;
-    while (auto nodeInfo = dir->read()) {
-        if (nodeInfo->type != Storage::NodeType::File) {
-            continue;
-        }
+    std::vector<Storage::NodeInfo> nodeInfos(16);
+    while (u32 count = dir->readBatch(nodeInfos.data(), nodeInfos.size())) {
+        for (u32 i = 0; i < count; i++) {
+            const auto &nodeInfo = nodeInfos[i];
+            if (nodeInfo.type != Storage::NodeType::File) {
+                continue;
+            }
 
-        SP_LOG("Found track pack '%ls'", nodeInfo->name);
-        manifestBuf.resize(nodeInfo->size);
+            SP_LOG("Found track pack '%ls'", nodeInfo.name);
+            manifestBuf.resize(nodeInfo.size);
 
-        auto len = Storage::FastReadFile(nodeInfo->id, manifestBuf.data(), nodeInfo->size);
-        if (!len.has_value() || *len == 0) {
-            SP_LOG("Failed to read track pack manifest!");
-            continue;
-        }
+            auto len = Storage::FastReadFile(nodeInfo.id, manifestBuf.data(), nodeInfo.size);
+            if (!len.has_value() || *len == 0) {
+                SP_LOG("Failed to read track pack manifest!");
+                continue;
+            }
 
-        manifestBuf.resize(*len);
+            manifestBuf.resize(*len);
 
-        auto res = TrackPack::New(manifestBuf);
-        if (!res.has_value()) {
-            SP_LOG("Failed to read track pack manifest: %s", res.error());
-            continue;
+            auto res = TrackPack::New(manifestBuf);
+            if (!res.has_value()) {
+                SP_LOG("Failed to read track pack manifest: %s", res.error());
+                continue;
+            }
+
+            m_packs.push_back(std::move(*res));
         }
 
-        m_packs.push_back(std::move(*res));
+        if (count < nodeInfos.size()) {
+            break;
+        }
     }
 }
 
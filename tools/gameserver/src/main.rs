@@ -1,5 +1,8 @@
 mod matchmaking;
+mod race;
+mod race_load;
 mod room;
+mod tag_bench;
 mod unreliable_socket;
 
 use std::sync::Arc;
@@ -16,6 +19,7 @@ use tokio::sync::mpsc;
 use tokio_tungstenite::{MaybeTlsStream, WebSocketStream};
 
 use crate::room::Room;
+use crate::unreliable_socket::Listener;
 use matchmaking::Message;
 use netprotocol::{
     async_stream::AsyncStream,
@@ -54,11 +58,21 @@ async fn main() -> Result<()> {
     libhydrogen::init()?;
     tracing_subscriber::fmt::init();
 
+    if std::env::args().nth(1).as_deref() == Some("race-load") {
+        return race_load::run(race_load::Args::parse_from(std::env::args().skip(1))).await;
+    }
+    if std::env::args().nth(1).as_deref() == Some("tag-bench") {
+        return tag_bench::run(tag_bench::Args::parse_from(std::env::args().skip(1))).await;
+    }
+
+    // The races of all rooms share one UDP port.
+    let race_listener = Listener::bind("0.0.0.0:21330").await?;
+
     let arg_count = std::env::args().skip(1).len();
     let server_conn;
     if arg_count == 0 {
         tracing::info!("No arguments passed, starting as standalone server.");
-        server_conn = ServerConnection::Client(spawn_room(None));
+        server_conn = ServerConnection::Client(spawn_room(None, race_listener));
     } else {
         tracing::info!("Arguments passed, starting as part of matchmaking pool.");
 
@@ -73,6 +87,7 @@ async fn main() -> Result<()> {
             args.gameserver_ip,
             args.gameserver_id,
             args.max_rooms,
+            race_listener,
         ));
     }
 
@@ -120,6 +135,7 @@ async fn central_listener(
     room_ip: std::net::Ipv4Addr,
     gameserver_id: u16,
     max_rooms: u16,
+    race_listener: Listener,
 ) -> Result<()> {
     let (ws_send, mut ws_recv) = mpsc::unbounded_channel();
     let register = GTSMessage::AddServer(gts_message::AddServer {
@@ -183,10 +199,12 @@ async fn central_listener(
                         match rooms.entry(room_id) {
                             Entry::Occupied(_) => continue,
                             Entry::Vacant(entry) => {
-                                entry.insert(spawn_room(Some(matchmaking::State {
+                                let match_state = matchmaking::State {
                                     room_id,
                                     ws_conn: ws_send.clone(),
-                                })));
+                                };
+                                let race_listener = race_listener.clone();
+                                entry.insert(spawn_room(Some(match_state), race_listener));
 
                                 break (room_id, waiting_client.take());
                             }
@@ -221,13 +239,15 @@ async fn central_listener(
     Ok(())
 }
 
+// Each room runs as a task of its own.
 fn spawn_room(
     match_state: Option<matchmaking::State>,
+    race_listener: Listener,
 ) -> mpsc::Sender<(RoomAsyncStream, room_request::Join)> {
     let (connect_tx, connect_rx) = mpsc::channel(32);
 
     tokio::spawn(async move {
-        let mut room = Room::new(connect_rx, match_state);
+        let mut room = Room::new(connect_rx, match_state, race_listener);
         room.handle().await
     });
 
@@ -0,0 +1,202 @@
+use std::future::Future;
+use std::time::Duration;
+
+use anyhow::Result;
+use prost::Message;
+use tokio::time::{self, Instant, MissedTickBehavior};
+
+use crate::room_protocol::*;
+use crate::unreliable_socket::UnreliableSocket;
+
+// The state of a race in progress. Client frames are merged as they arrive, and the latest player
+// frames are broadcast once per tick.
+#[derive(Debug)]
+pub struct Race {
+    player_clients: Vec<usize>,
+    client_times: Vec<Option<u32>>,
+    // The last server frame each client received, which positions are sent relative to.
+    client_acks: Vec<Option<u32>>,
+    player_frames: Vec<Option<(u32, PackedPlayerFrame)>>,
+    is_dirty: bool,
+    // The positions of the last broadcast frames, indexed by time.
+    history: Vec<(u32, Vec<[i32; 3]>)>,
+    time: u32,
+    stats: TickStats,
+    // Reused from one tick to the next to avoid allocations.
+    server_frame: PackedRaceServerFrame,
+    positions: Vec<[i32; 3]>,
+    targets: Vec<(Option<u32>, usize)>,
+    message: Vec<u8>,
+}
+
+#[derive(Debug, Default)]
+pub struct TickStats {
+    pub tick_count: u32,
+    pub busy: Duration,
+    pub max_busy: Duration,
+    pub max_lateness: Duration,
+}
+
+impl Race {
+    // The game runs at 59.94 Hz.
+    pub const TICK_DURATION: Duration = Duration::from_nanos(16_683_350);
+    // Must match the history length of RaceClient, so that acknowledged frames are in both.
+    const HISTORY_LENGTH: usize = 32;
+
+    // Takes the index of the client of each player.
+    pub fn new(player_clients: Vec<usize>, client_count: usize) -> Race {
+        let player_count = player_clients.len();
+        Race {
+            player_clients,
+            client_times: vec![None; client_count],
+            client_acks: vec![None; client_count],
+            player_frames: vec![None; player_count],
+            is_dirty: false,
+            history: vec![(0, vec![]); Self::HISTORY_LENGTH],
+            // Clients acknowledge 0 until they receive a frame, so start at 1.
+            time: 1,
+            stats: TickStats::default(),
+            server_frame: PackedRaceServerFrame::default(),
+            positions: Vec::with_capacity(player_count),
+            targets: Vec::with_capacity(client_count),
+            message: vec![],
+        }
+    }
+
+    pub fn stats(&self) -> &TickStats {
+        &self.stats
+    }
+
+    pub async fn run(
+        &mut self,
+        socket: &mut UnreliableSocket,
+        end: impl Future<Output = ()>,
+    ) -> Result<()> {
+        tokio::pin!(end);
+        let mut interval = time::interval(Self::TICK_DURATION);
+        // Send the latest state when late rather than catching up with stale ones.
+        interval.set_missed_tick_behavior(MissedTickBehavior::Skip);
+        loop {
+            tokio::select! {
+                read = socket.read::<RaceClientFrame>() => {
+                    let (index, client_frame) = read?;
+                    self.handle_client_frame(index, client_frame);
+                },
+                deadline = interval.tick() => self.tick(socket, deadline).await?,
+                _ = &mut end => return Ok(()),
+            }
+        }
+    }
+
+    pub fn handle_client_frame(&mut self, index: usize, client_frame: RaceClientFrame) {
+        let player_count = self.player_clients.iter().filter(|client| **client == index).count();
+
+        // Go from the oldest frame to the newest, skipping the ones that already arrived.
+        for race in client_frame.frames.into_iter().rev() {
+            if self.client_times[index].map_or(false, |client_time| race.time <= client_time) {
+                continue;
+            }
+            if race.players.len() != player_count {
+                continue; // TODO handle
+            }
+            self.client_times[index] = Some(race.time);
+            if race.server_time != 0 {
+                self.client_acks[index] = Some(race.server_time);
+            }
+            let player_ids = self
+                .player_clients
+                .iter()
+                .enumerate()
+                .filter(|(_, client)| **client == index)
+                .map(|(player_id, _)| player_id);
+            for (player_id, player_frame) in player_ids.zip(race.players.into_iter()) {
+                self.player_frames[player_id] = Some((race.time, player_frame));
+            }
+            self.is_dirty = true;
+        }
+    }
+
+    async fn tick(&mut self, socket: &mut UnreliableSocket, deadline: Instant) -> Result<()> {
+        let start = Instant::now();
+        if self.is_dirty && self.player_frames.iter().all(Option::is_some) {
+            self.is_dirty = false;
+            self.broadcast(socket).await?;
+        }
+
+        let busy = start.elapsed();
+        self.stats.tick_count += 1;
+        self.stats.busy += busy;
+        self.stats.max_busy = self.stats.max_busy.max(busy);
+        self.stats.max_lateness =
+            self.stats.max_lateness.max(start.saturating_duration_since(deadline));
+        Ok(())
+    }
+
+    async fn broadcast(&mut self, socket: &mut UnreliableSocket) -> Result<()> {
+        let server_frame = &mut self.server_frame;
+        server_frame.time = self.time;
+        server_frame.player_times.clear();
+        server_frame.players.resize_with(self.player_frames.len(), Default::default);
+        self.positions.clear();
+        let player_frames = self.player_frames.iter().flatten();
+        for ((time, player_frame), dst) in player_frames.zip(server_frame.players.iter_mut()) {
+            server_frame.player_times.push(*time);
+            copy_player_frame(dst, player_frame);
+            self.positions.push([player_frame.pos_x, player_frame.pos_y, player_frame.pos_z]);
+        }
+
+        // Encode once for each acknowledged frame rather than once for each client.
+        self.targets.clear();
+        for (index, client_ack) in self.client_acks.iter().enumerate() {
+            let base_time = client_ack.filter(|ack| {
+                let (base_time, _) = &self.history[*ack as usize % Self::HISTORY_LENGTH];
+                base_time == ack
+            });
+            self.targets.push((base_time, index));
+        }
+        self.targets.sort_unstable();
+        let mut encoded_base_time = None;
+        for &(base_time, index) in &self.targets {
+            if encoded_base_time != Some(base_time) {
+                let base = base_time.map(|base_time| {
+                    let (_, base) = &self.history[base_time as usize % Self::HISTORY_LENGTH];
+                    base
+                });
+                let server_frame = &mut self.server_frame;
+                server_frame.base_time = base_time;
+                for (i, (dst, pos)) in
+                    server_frame.players.iter_mut().zip(self.positions.iter()).enumerate()
+                {
+                    let base = base.map_or([0; 3], |base| base[i]);
+                    dst.pos_x = pos[0].wrapping_sub(base[0]);
+                    dst.pos_y = pos[1].wrapping_sub(base[1]);
+                    dst.pos_z = pos[2].wrapping_sub(base[2]);
+                }
+                self.message.clear();
+                server_frame.encode(&mut self.message)?;
+                encoded_base_time = Some(base_time);
+            }
+            socket.write_raw(index, &self.message).await?;
+        }
+
+        // Only now, as the entry may be the base of a client 32 frames behind.
+        let entry = &mut self.history[self.time as usize % Self::HISTORY_LENGTH];
+        entry.0 = self.time;
+        std::mem::swap(&mut entry.1, &mut self.positions);
+        self.time += 1;
+        Ok(())
+    }
+}
+
+// Like clone_from, but reusing the allocation of the boost times.
+fn copy_player_frame(dst: &mut PackedPlayerFrame, src: &PackedPlayerFrame) {
+    dst.input_state.clone_from(&src.input_state);
+    dst.time_before_respawn = src.time_before_respawn;
+    dst.time_in_respawn = src.time_in_respawn;
+    dst.times_before_boost_end.clone_from(&src.times_before_boost_end);
+    dst.pos_x = src.pos_x;
+    dst.pos_y = src.pos_y;
+    dst.pos_z = src.pos_z;
+    dst.main_rot = src.main_rot;
+    dst.internal_speed = src.internal_speed;
+}
@@ -0,0 +1,214 @@
+use std::collections::VecDeque;
+use std::sync::{Arc, Mutex};
+use std::time::Duration;
+
+use anyhow::{ensure, Result};
+use libhydrogen::secretbox;
+use tokio::net::UdpSocket;
+use tokio::time::{self, Instant, MissedTickBehavior};
+
+use crate::race::Race;
+use crate::room_protocol::*;
+use crate::unreliable_socket::{Connection, Listener, UnreliableSocket};
+
+#[derive(clap::Parser, Debug)]
+#[command(about = "Run races against synthetic clients on localhost and report tick timings")]
+pub struct Args {
+    #[arg(long, value_delimiter = ',', default_values_t = [2, 4, 8, 12])]
+    /// Room sizes to measure, in clients of one player each.
+    clients: Vec<usize>,
+    #[arg(long, default_value_t = 1)]
+    /// How many rooms race at once, sharing one listener as in the gameserver.
+    rooms: usize,
+    #[arg(long, default_value_t = 10)]
+    /// How long to race for at each room size.
+    seconds: u64,
+    #[arg(long)]
+    /// Drop every Nth datagram that each client sends and receives, as a lossy network would.
+    drop_every: Option<u32>,
+}
+
+// From a client sampling its input to the first server frame which includes it, or a later input.
+#[derive(Debug, Default)]
+struct LatencyStats {
+    count: u32,
+    total: Duration,
+    max: Duration,
+}
+
+pub async fn run(args: Args) -> Result<()> {
+    let listener = Listener::bind("127.0.0.1:0").await?;
+    for &client_count in &args.clients {
+        let duration = Duration::from_secs(args.seconds);
+        let latency = Arc::new(Mutex::new(LatencyStats::default()));
+        let races = (0..args.rooms)
+            .map(|_| {
+                let race = run_race(
+                    listener.clone(),
+                    client_count,
+                    duration,
+                    args.drop_every,
+                    latency.clone(),
+                );
+                tokio::spawn(race)
+            })
+            .collect::<Vec<_>>();
+        let mut tick_rates = vec![];
+        let mut busy = Duration::ZERO;
+        let mut max_busy = Duration::ZERO;
+        let mut max_lateness = Duration::ZERO;
+        for race in races {
+            let race = race.await??;
+            let stats = race.stats();
+            tick_rates.push(stats.tick_count as f64 / duration.as_secs_f64());
+            busy += stats.busy;
+            max_busy = max_busy.max(stats.max_busy);
+            max_lateness = max_lateness.max(stats.max_lateness);
+        }
+        // Each race drops its socket, which must take its routes with it.
+        ensure!(
+            listener.route_count() == 0,
+            "{} routes left after the races",
+            listener.route_count()
+        );
+        let min_tick_rate = tick_rates.iter().cloned().fold(f64::INFINITY, f64::min);
+        let max_tick_rate = tick_rates.iter().cloned().fold(0.0, f64::max);
+        tracing::info!(
+            "{} rooms of {client_count} clients: {:.1}-{:.1} ticks/s, {:.2}% busy, \
+             {:?} max busy, {:?} max lateness",
+            args.rooms,
+            min_tick_rate,
+            max_tick_rate,
+            busy.as_secs_f64() / duration.as_secs_f64() * 100.0,
+            max_busy,
+            max_lateness,
+        );
+        let latency = latency.lock().unwrap();
+        tracing::info!(
+            "{} rooms of {client_count} clients: input to broadcast {:?} mean, {:?} max \
+             over {} inputs, {}",
+            args.rooms,
+            latency.total / latency.count.max(1),
+            latency.max,
+            latency.count,
+            args.drop_every.map_or("no loss".to_string(), |n| format!("1 in {n} datagrams lost")),
+        );
+    }
+    Ok(())
+}
+
+async fn run_race(
+    listener: Listener,
+    client_count: usize,
+    duration: Duration,
+    drop_every: Option<u32>,
+    latency: Arc<Mutex<LatencyStats>>,
+) -> Result<Race> {
+    let addr = listener.local_addr()?;
+    let mut connections = vec![];
+    let mut clients = vec![];
+    for player_id in 0..client_count {
+        let read_key = secretbox::Key::gen();
+        let write_key = secretbox::Key::gen();
+        connections.push(Connection::new(read_key.clone(), write_key.clone()));
+        let client_socket = UdpSocket::bind("127.0.0.1:0").await?;
+        let context = secretbox::Context::from(*b"race    ");
+        let connection = Connection::new(write_key, read_key);
+        let mut client_socket = UnreliableSocket::new(client_socket, context, vec![connection]);
+        client_socket.set_connection_addr(0, addr);
+        let client = run_client(client_socket, player_id, drop_every, latency.clone());
+        clients.push(tokio::spawn(client));
+    }
+
+    let context = secretbox::Context::from(*b"race    ");
+    let mut unreliable_socket = listener.socket(context, connections)?;
+    let mut race = Race::new((0..client_count).collect(), client_count);
+    race.run(&mut unreliable_socket, time::sleep(duration)).await?;
+    for client in clients {
+        client.abort();
+    }
+    Ok(race)
+}
+
+// Sends frames of a kart driving in a straight line, as RaceClient would.
+async fn run_client(
+    mut socket: UnreliableSocket,
+    player_id: usize,
+    drop_every: Option<u32>,
+    latency: Arc<Mutex<LatencyStats>>,
+) -> Result<()> {
+    let mut interval = time::interval(Race::TICK_DURATION);
+    interval.set_missed_tick_behavior(MissedTickBehavior::Skip);
+    let start = Instant::now();
+    let mut client_frame = RaceClientFrame::default();
+    let mut server_time = 0;
+    let mut datagram_count = 0;
+    let mut is_dropped = move || {
+        datagram_count += 1;
+        drop_every.map_or(false, |n| datagram_count % n == 0)
+    };
+    // The inputs which no server frame has included yet.
+    let mut pending_inputs = VecDeque::new();
+    loop {
+        tokio::select! {
+            read = socket.read::<PackedRaceServerFrame>() => {
+                let (_, server_frame) = read?;
+                if is_dropped() {
+                    continue;
+                }
+                server_time = server_time.max(server_frame.time);
+                let Some(&player_time) = server_frame.player_times.get(player_id) else {
+                    continue;
+                };
+                let now = Instant::now();
+                let mut latency = latency.lock().unwrap();
+                while let Some(&(time, sample_time)) = pending_inputs.front() {
+                    if time > player_time {
+                        break;
+                    }
+                    let input_latency = now - sample_time;
+                    latency.count += 1;
+                    latency.total += input_latency;
+                    latency.max = latency.max.max(input_latency);
+                    pending_inputs.pop_front();
+                }
+            },
+            deadline = interval.tick() => {
+                let time = (deadline - start).as_nanos() / Race::TICK_DURATION.as_nanos();
+                let time = time as u32;
+                let player_frame = PackedPlayerFrame {
+                    input_state: InputState {
+                        accelerate: true,
+                        brake: false,
+                        item: false,
+                        drift: false,
+                        brake_drift: false,
+                        stick_x: 7,
+                        stick_y: 7,
+                        trick: 0,
+                    },
+                    time_before_respawn: 0,
+                    time_in_respawn: 0,
+                    times_before_boost_end: vec![0; 3],
+                    pos_x: time as i32 * 16 * 80,
+                    pos_y: 0,
+                    pos_z: 0,
+                    // The identity rotation
+                    main_rot: 3 << 30 | 0x200 << 20 | 0x200 << 10 | 0x200,
+                    internal_speed: 80.0,
+                };
+                let race = PackedRace {
+                    time,
+                    server_time,
+                    players: vec![player_frame],
+                };
+                client_frame.frames.insert(0, race);
+                client_frame.frames.truncate(3);
+                pending_inputs.push_back((time, Instant::now()));
+                if !is_dropped() {
+                    socket.write(0, &client_frame).await?;
+                }
+            },
+        }
+    }
+}
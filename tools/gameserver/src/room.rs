@@ -2,14 +2,14 @@ use anyhow::{Context, Result};
 use libhydrogen::secretbox;
 use rand::Rng;
 use slab::Slab;
-use tokio::net::UdpSocket;
 use tokio::sync::{broadcast, mpsc};
 use tokio::task::JoinHandle;
 
 use crate::matchmaking;
+use crate::race::Race;
 use crate::room_protocol::room_event::Properties;
 use crate::room_protocol::*;
-use crate::unreliable_socket::{Connection, UnreliableSocket};
+use crate::unreliable_socket::{Connection, Listener};
 use crate::RoomAsyncStream;
 
 #[derive(Debug)]
@@ -24,6 +24,7 @@ pub struct Room {
     players: Vec<Player>,
     settings: Option<Vec<u32>>,
     matchmaking_state: Option<matchmaking::State>,
+    race_listener: Listener,
 }
 
 impl Room {
@@ -33,6 +34,7 @@ impl Room {
     pub fn new(
         connect_rx: mpsc::Receiver<(RoomAsyncStream, room_request::Join)>,
         matchmaking_state: Option<matchmaking::State>,
+        race_listener: Listener,
     ) -> Room {
         let (disconnect_tx, disconnect_rx) = mpsc::channel(32);
         let (read_tx, read_rx) = mpsc::channel(32);
@@ -49,6 +51,7 @@ impl Room {
             players: vec![],
             settings: None,
             matchmaking_state,
+            race_listener,
         }
     }
 
@@ -147,14 +150,13 @@ impl Room {
     }
 
     async fn handle_race(&mut self) -> Result<()> {
-        let socket = UdpSocket::bind("0.0.0.0:21330").await?;
         let context = secretbox::Context::from(*b"race    ");
         let connections = self
             .clients
             .iter()
             .map(|(_, client)| Connection::new(client.read_key.clone(), client.write_key.clone()))
             .collect();
-        let mut unreliable_socket = UnreliableSocket::new(socket, context, connections);
+        let mut unreliable_socket = self.race_listener.socket(context, connections)?;
 
         let mut pending_clients = (0..self.clients.len()).collect::<Vec<_>>();
         while !pending_clients.is_empty() {
@@ -162,60 +164,40 @@ impl Room {
             pending_clients.retain(|i| *i != index);
         }
 
-        let mut player_frames = vec![None; self.players.len()];
-        let mut player_frames = loop {
-            let Some((client_key, request)) = self.read_rx.recv().await else {return Ok(())};
-            let Some(request) = request.request else { continue }; // TODO handle
-            let race = match request {
-                RoomRequest::Race(race) => race,
-                _ => continue, // TODO handle
-            };
-            if race.players.len() != self.clients[client_key].player_count {
-                continue; // TODO handle
-            }
-            tracing::debug!("{:?} {:?}", client_key, race);
-            for ((player_id, _), player_frame) in
-                self.client_players(client_key).zip(race.players.into_iter())
-            {
-                player_frames[player_id] = Some((race.time, player_frame));
-            }
-
-            let player_frames: Option<Vec<_>> = player_frames.iter().cloned().collect();
-            if let Some(player_frames) = player_frames {
-                break player_frames;
+        // The connections were created in the iteration order of the clients.
+        let client_keys = self.clients.iter().map(|(client_key, _)| client_key).collect::<Vec<_>>();
+        let player_clients = self
+            .players
+            .iter()
+            .map(|player| client_keys.iter().position(|key| *key == player.client_key))
+            .collect::<Option<Vec<_>>>()
+            .context("Player without a client!")?;
+        let mut race = Race::new(player_clients, client_keys.len());
+        // The race ends once every client has disconnected. The room holds senders of both
+        // channels, so they never close by themselves.
+        let disconnect_rx = &mut self.disconnect_rx;
+        let read_rx = &mut self.read_rx;
+        let mut connected_count = client_keys.len();
+        let end = async move {
+            while connected_count != 0 {
+                tokio::select! {
+                    Some(_) = disconnect_rx.recv() => connected_count -= 1,
+                    // Lobby requests don't apply anymore, but the clients must not block on them.
+                    Some(_) = read_rx.recv() => (),
+                    else => break,
+                }
             }
         };
+        race.run(&mut unreliable_socket, end).await?;
 
-        for time in 0.. {
-            let Some((client_key, request)) = self.read_rx.recv().await else {return Ok(())};
-            let Some(request) = request.request else { continue }; // TODO handle
-            let race = match request {
-                RoomRequest::Race(race) => race,
-                _ => continue, // TODO handle
-            };
-            if race.players.len() != self.clients[client_key].player_count {
-                continue; // TODO handle
-            }
-            tracing::debug!("{:?} {:?}", client_key, race);
-            for ((player_id, _), player_frame) in
-                self.client_players(client_key).zip(race.players.into_iter())
-            {
-                player_frames[player_id] = (race.time, player_frame);
-            }
-            let player_times = player_frames.iter().map(|(time, _)| *time).collect();
-            let players =
-                player_frames.iter().map(|(_, player_frame)| player_frame.clone()).collect();
-            let server_frame = RaceServerFrame {
-                time,
-                player_times,
-                players,
-            };
-            tracing::debug!("{:?}", server_frame);
-            for index in 0..self.clients.len() {
-                unreliable_socket.write(index, &server_frame).await?;
-            }
-        }
-
+        let stats = race.stats();
+        tracing::info!(
+            "Race ended after {} ticks, {:?} busy, {:?} max busy, {:?} max lateness",
+            stats.tick_count,
+            stats.busy,
+            stats.max_busy,
+            stats.max_lateness,
+        );
         Ok(())
     }
 
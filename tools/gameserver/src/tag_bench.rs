@@ -0,0 +1,119 @@
+use std::time::Duration;
+
+use anyhow::Result;
+use libhydrogen::secretbox;
+use prost::Message;
+use tokio::net::UdpSocket;
+use tokio::time::{self, Instant};
+
+use crate::room_protocol::*;
+use crate::unreliable_socket::{Connection, UnreliableSocket, TAG_SIZE};
+
+#[derive(clap::Parser, Debug)]
+#[command(about = "Compare tag lookup against trial decryption for race datagrams on localhost")]
+pub struct Args {
+    #[arg(long, value_delimiter = ',', default_values_t = [2, 6, 12])]
+    /// Peer counts to measure.
+    peers: Vec<usize>,
+    #[arg(long, default_value_t = 100_000)]
+    /// How many datagrams the peers send at each peer count, in total.
+    datagrams: usize,
+}
+
+// How long the receiver waits for more datagrams once the peers are done.
+const IDLE_TIMEOUT: Duration = Duration::from_millis(200);
+
+pub async fn run(args: Args) -> Result<()> {
+    for &peer_count in &args.peers {
+        let tag_rate = measure(peer_count, args.datagrams, false).await?;
+        let trial_rate = measure(peer_count, args.datagrams, true).await?;
+        tracing::info!(
+            "{peer_count} peers: tag lookup {tag_rate:.0} datagrams/s, trial decryption \
+             {trial_rate:.0} datagrams/s",
+        );
+    }
+    Ok(())
+}
+
+// Returns how many datagrams the receiver handled per second while the peers were sending.
+async fn measure(peer_count: usize, datagram_count: usize, is_trial: bool) -> Result<f64> {
+    let context = || secretbox::Context::from(*b"race    ");
+    let socket = UdpSocket::bind("127.0.0.1:0").await?;
+    let addr = socket.local_addr()?;
+    let mut read_keys = vec![];
+    let mut connections = vec![];
+    let mut peers = vec![];
+    for _ in 0..peer_count {
+        let read_key = secretbox::Key::gen();
+        let write_key = secretbox::Key::gen();
+        read_keys.push(read_key.clone());
+        connections.push(Connection::new(read_key.clone(), write_key.clone()));
+        let peer_socket = UdpSocket::bind("127.0.0.1:0").await?;
+        let connection = Connection::new(write_key, read_key);
+        let mut peer_socket = UnreliableSocket::new(peer_socket, context(), vec![connection]);
+        peer_socket.set_connection_addr(0, addr);
+        peers.push(peer_socket);
+    }
+
+    // The same frame as race-load's clients, with the 3 frames of redundancy.
+    let mut client_frame = RaceClientFrame::default();
+    for time in 0..3 {
+        client_frame.frames.push(PackedRace {
+            time,
+            server_time: 0,
+            players: vec![PackedPlayerFrame {
+                times_before_boost_end: vec![0; 3],
+                ..Default::default()
+            }],
+        });
+    }
+    let sender = tokio::spawn(async move {
+        for i in 0..datagram_count {
+            peers[i % peers.len()].write(0, &client_frame).await?;
+        }
+        anyhow::Ok(())
+    });
+
+    let mut receive_count = 0;
+    let mut start = None;
+    let mut end = Instant::now();
+    if is_trial {
+        // As before the tags: every key is tried until one authenticates the datagram.
+        let mut message = [0u8; 1024];
+        loop {
+            let read = time::timeout(IDLE_TIMEOUT, socket.recv_from(&mut message)).await;
+            let Ok(read) = read else { break };
+            let (size, _) = read?;
+            start.get_or_insert_with(Instant::now);
+            let Some(message) = message.get(TAG_SIZE..size) else { continue };
+            for read_key in &read_keys {
+                let Ok(message) = secretbox::decrypt(message, 0, &context(), read_key) else {
+                    continue;
+                };
+                if RaceClientFrame::decode(&*message).is_ok() {
+                    receive_count += 1;
+                }
+                break;
+            }
+            end = Instant::now();
+        }
+    } else {
+        let mut socket = UnreliableSocket::new(socket, context(), connections);
+        loop {
+            let read = time::timeout(IDLE_TIMEOUT, socket.read::<RaceClientFrame>()).await;
+            let Ok(read) = read else { break };
+            read?;
+            start.get_or_insert_with(Instant::now);
+            receive_count += 1;
+            end = Instant::now();
+        }
+    }
+    sender.await??;
+
+    let Some(start) = start else { return Ok(0.0) };
+    if receive_count < datagram_count {
+        let lost_count = datagram_count - receive_count;
+        tracing::warn!("{lost_count} of {datagram_count} datagrams were lost");
+    }
+    Ok(receive_count as f64 / (end - start).as_secs_f64().max(f64::EPSILON))
+}
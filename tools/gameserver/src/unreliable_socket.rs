@@ -1,27 +1,70 @@
+use std::collections::HashMap;
 use std::net::SocketAddr;
+use std::sync::Arc;
 
-use anyhow::{anyhow, Result};
-use libhydrogen::secretbox;
+use anyhow::{anyhow, bail, Result};
+use dashmap::mapref::entry::Entry;
+use dashmap::DashMap;
+use libhydrogen::{hash, secretbox};
 use prost::Message;
-use tokio::net::UdpSocket;
+use tokio::net::{ToSocketAddrs, UdpSocket};
+use tokio::sync::mpsc;
 
 #[derive(Debug)]
 pub struct UnreliableSocket {
-    socket: UdpSocket,
+    socket: Arc<UdpSocket>,
+    incoming: Incoming,
     context: secretbox::Context,
     connections: Vec<Connection>,
+    indices: HashMap<u32, usize>,
 }
 
+#[derive(Debug)]
+enum Incoming {
+    // Datagrams are read from the socket directly.
+    Socket,
+    // The socket is shared, and a Listener forwards the datagrams tagged for these connections.
+    Routed {
+        routes: Arc<DashMap<u32, mpsc::Sender<Datagram>>>,
+        // To only remove the routes to this socket.
+        tx: mpsc::Sender<Datagram>,
+        rx: mpsc::Receiver<Datagram>,
+    },
+}
+
+type Datagram = (Vec<u8>, SocketAddr);
+
+// Each datagram starts with a cleartext tag derived from the key it is encrypted with, so that
+// only one key has to be tried however many peers there are.
+pub const TAG_SIZE: usize = 4;
+const MAX_DATAGRAM_SIZE: usize = 1024; // TODO make that configurable
+
 impl UnreliableSocket {
     pub fn new(
         socket: UdpSocket,
         context: secretbox::Context,
         connections: Vec<Connection>,
     ) -> UnreliableSocket {
+        Self::with_incoming(Arc::new(socket), Incoming::Socket, context, connections)
+    }
+
+    fn with_incoming(
+        socket: Arc<UdpSocket>,
+        incoming: Incoming,
+        context: secretbox::Context,
+        connections: Vec<Connection>,
+    ) -> UnreliableSocket {
+        let indices = connections
+            .iter()
+            .enumerate()
+            .map(|(index, connection)| (connection.read_tag, index))
+            .collect();
         UnreliableSocket {
             socket,
+            incoming,
             context,
             connections,
+            indices,
         }
     }
 
@@ -29,21 +72,40 @@ impl UnreliableSocket {
         self.connections[index].addr
     }
 
+    // Otherwise the address is learned from the first datagram of the connection.
+    pub fn set_connection_addr(&mut self, index: usize, addr: SocketAddr) {
+        self.connections[index].addr = Some(addr);
+    }
+
     pub async fn read<M>(&mut self) -> Result<(usize, M)>
     where
         M: Message + Default,
     {
-        let mut message = [0u8; 1024]; // TODO make that configurable
+        let mut message = [0u8; MAX_DATAGRAM_SIZE];
         loop {
-            let (size, addr) = self.socket.recv_from(&mut message).await?;
-            for (index, connection) in self.connections.iter_mut().enumerate() {
-                let message =
-                    secretbox::decrypt(&message[0..size], 0, &self.context, &connection.read_key);
-                let Ok(message) = message else {continue};
-                connection.addr = Some(addr);
-                let Ok(message) = M::decode(&*message) else {break};
-                return Ok((index, message));
+            let (size, addr) = match &mut self.incoming {
+                Incoming::Socket => self.socket.recv_from(&mut message).await?,
+                Incoming::Routed {
+                    rx,
+                    ..
+                } => {
+                    let (datagram, addr) = rx.recv().await.ok_or(anyhow!("Listener closed!"))?;
+                    message[..datagram.len()].copy_from_slice(&datagram);
+                    (datagram.len(), addr)
+                }
+            };
+            if size < TAG_SIZE {
+                continue;
             }
+            let tag = u32::from_be_bytes(message[0..TAG_SIZE].try_into()?);
+            let Some(&index) = self.indices.get(&tag) else {continue};
+            let connection = &mut self.connections[index];
+            let message = &message[TAG_SIZE..size];
+            let message = secretbox::decrypt(message, 0, &self.context, &connection.read_key);
+            let Ok(message) = message else {continue};
+            connection.addr = Some(addr);
+            let Ok(message) = M::decode(&*message) else {continue};
+            return Ok((index, message));
         }
     }
 
@@ -51,28 +113,146 @@ impl UnreliableSocket {
     where
         M: Message,
     {
+        self.write_raw(index, &message.encode_to_vec()).await
+    }
+
+    // For messages that are encoded once and sent to several connections.
+    pub async fn write_raw(&mut self, index: usize, message: &[u8]) -> Result<()> {
         let connection = &self.connections[index];
         let addr = connection.addr.ok_or(anyhow!("Unknown connection address!"))?;
-        let message = message.encode_to_vec();
-        let message = secretbox::encrypt(&message, 0, &self.context, &connection.write_key);
+        let message = secretbox::encrypt(message, 0, &self.context, &connection.write_key);
+        let message = [&connection.write_tag.to_be_bytes()[..], &message].concat();
         self.socket.send_to(&message, addr).await?;
         Ok(())
     }
 }
 
+impl Drop for UnreliableSocket {
+    fn drop(&mut self) {
+        if let Incoming::Routed {
+            routes,
+            tx,
+            ..
+        } = &self.incoming
+        {
+            Listener::remove_routes(routes, &self.connections, tx);
+        }
+    }
+}
+
+// Shares one UDP socket between the races of all rooms, routing each datagram to the race of the
+// connection it is tagged with.
+#[derive(Clone, Debug)]
+pub struct Listener {
+    socket: Arc<UdpSocket>,
+    routes: Arc<DashMap<u32, mpsc::Sender<Datagram>>>,
+}
+
+impl Listener {
+    pub async fn bind(addr: impl ToSocketAddrs) -> Result<Listener> {
+        let socket = Arc::new(UdpSocket::bind(addr).await?);
+        let routes = Arc::new(DashMap::new());
+        tokio::spawn(Self::route(socket.clone(), routes.clone()));
+        Ok(Listener {
+            socket,
+            routes,
+        })
+    }
+
+    pub fn local_addr(&self) -> Result<SocketAddr> {
+        Ok(self.socket.local_addr()?)
+    }
+
+    pub fn route_count(&self) -> usize {
+        self.routes.len()
+    }
+
+    // Fails if a tag is already routed to another socket, rather than taking it over.
+    pub fn socket(
+        &self,
+        context: secretbox::Context,
+        connections: Vec<Connection>,
+    ) -> Result<UnreliableSocket> {
+        let (tx, rx) = mpsc::channel(32 * connections.len().max(1));
+        for connection in &connections {
+            let is_taken = match self.routes.entry(connection.read_tag) {
+                Entry::Occupied(_) => true,
+                Entry::Vacant(entry) => {
+                    entry.insert(tx.clone());
+                    false
+                }
+            };
+            if is_taken {
+                Self::remove_routes(&self.routes, &connections, &tx);
+                bail!("Connection tag {:08x} is already in use", connection.read_tag);
+            }
+        }
+        let incoming = Incoming::Routed {
+            routes: self.routes.clone(),
+            tx,
+            rx,
+        };
+        Ok(UnreliableSocket::with_incoming(self.socket.clone(), incoming, context, connections))
+    }
+
+    fn remove_routes(
+        routes: &DashMap<u32, mpsc::Sender<Datagram>>,
+        connections: &[Connection],
+        tx: &mpsc::Sender<Datagram>,
+    ) {
+        for connection in connections {
+            routes.remove_if(&connection.read_tag, |_, route| route.same_channel(tx));
+        }
+    }
+
+    async fn route(socket: Arc<UdpSocket>, routes: Arc<DashMap<u32, mpsc::Sender<Datagram>>>) {
+        let mut message = [0u8; MAX_DATAGRAM_SIZE];
+        loop {
+            let (size, addr) = match socket.recv_from(&mut message).await {
+                Ok(read) => read,
+                Err(e) => {
+                    tracing::error!("Failed to receive a datagram: {e}");
+                    continue;
+                }
+            };
+            if size < TAG_SIZE {
+                continue;
+            }
+            let tag = u32::from_be_bytes([message[0], message[1], message[2], message[3]]);
+            let Some(tx) = routes.get(&tag) else {continue};
+            // Drop the datagram if the race is behind, as the network would.
+            let _ = tx.try_send((message[..size].to_vec(), addr));
+        }
+    }
+}
+
 #[derive(Debug)]
 pub struct Connection {
     read_key: secretbox::Key,
     write_key: secretbox::Key,
+    read_tag: u32,
+    write_tag: u32,
     addr: Option<SocketAddr>,
 }
 
 impl Connection {
     pub fn new(read_key: secretbox::Key, write_key: secretbox::Key) -> Connection {
+        let read_tag = connection_tag(&read_key);
+        let write_tag = connection_tag(&write_key);
         Connection {
             read_key,
             write_key,
+            read_tag,
+            write_tag,
             addr: None,
         }
     }
 }
+
+fn connection_tag(key: &secretbox::Key) -> u32 {
+    let key: [u8; 32] = key.clone().into();
+    let context = hash::Context::from(*b"conn tag");
+    let hash = hash::hash(hash::BYTES, &[], &context, Some(&key.into()))
+        .expect("Failed to hash the connection key!");
+    u32::from_be_bytes([hash[0], hash[1], hash[2], hash[3]])
+}
@@ -39,6 +39,7 @@ struct Room {
 #[derive(Debug)]
 struct Gameserver {
     rooms: HashMap<RoomId, Room>,
+    max_rooms: usize,
     sender: GameserverMessageSender,
 }
 
@@ -46,9 +47,15 @@ impl Gameserver {
     pub fn new(sender: GameserverMessageSender, max_rooms: usize) -> Self {
         Self {
             rooms: HashMap::with_capacity(max_rooms),
+            max_rooms,
             sender,
         }
     }
+
+    /// Whether the gameserver can host another room, as all of its rooms race in one process.
+    fn has_room_capacity(&self) -> bool {
+        self.rooms.len() < self.max_rooms
+    }
 }
 
 #[derive(Default, Clone)]
@@ -64,7 +71,7 @@ impl Server {
 
     /// Requests for a room to be opened on either:
     /// - The room with the most members
-    /// - The gameserver with the least rooms
+    /// - The gameserver with the least rooms, among those below their maximum
     #[async_recursion::async_recursion]
     async fn request_room(
         &self,
@@ -91,9 +98,9 @@ impl Server {
                 }
             }
 
-            if highest_member_count.is_none() {
+            if highest_member_count.is_none() && gameserver.has_room_capacity() {
                 if let Some((least_room_count, _)) = least_room {
-                    if least_room_count > gameserver.rooms.len() as u8 {
+                    if least_room_count <= gameserver.rooms.len() as u8 {
                         continue;
                     }
                 }
@@ -105,7 +112,7 @@ impl Server {
         let (gameserver_id, room_id) = match (highest_member_count, least_room) {
             (Some((_, gameserver_id, room_id)), _) => (gameserver_id, Some(room_id)),
             (None, Some((_, gameserver_id))) => (gameserver_id, None),
-            (None, None) => anyhow::bail!("No gameservers found!"),
+            (None, None) => anyhow::bail!("No gameservers with room capacity found!"),
         };
 
         let message = STGMessage::TokenRequest(stg_message::RequestToken {
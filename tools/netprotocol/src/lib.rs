@@ -13,7 +13,10 @@ pub mod room_protocol {
         room_request::Request as RoomRequest, ClientId as ClientIdOpt, LoginInfo,
         RoomEvent as RoomEventOpt, RoomRequest as RoomRequestOpt,
     };
-    pub use super::inner::{RaceClientPing, RaceServerFrame};
+    pub use super::inner::{
+        InputState, PackedPlayerFrame, PackedRace, PackedRaceServerFrame, RaceClientFrame,
+        RaceClientPing,
+    };
 }
 
 pub mod matchmaking {
@@ -1,8 +1,9 @@
 use std::collections::hash_map::Entry;
-use std::collections::HashMap;
+use std::collections::{HashMap, VecDeque};
 use std::env;
 use std::io::{ErrorKind, Read, SeekFrom, Write};
 use std::path::{Path, PathBuf};
+use std::time::{Duration, Instant};
 
 use libhydrogen::errors::anyhow;
 use libhydrogen::{kx, secretbox};
@@ -18,8 +19,16 @@ use net_storage_response::Response;
 
 fn main() -> Result<(), Box<dyn std::error::Error>> {
     let args: Vec<String> = env::args().collect();
+    if args.len() == 5 && args[1] == "bench" {
+        libhydrogen::init()?;
+        let runtime = Runtime::new()?;
+        return runtime.block_on(bench(&args[2], &args[3], &args[4]));
+    }
     if args.len() != 2 {
-        Err(anyhow!("Usage: netstorageserver-cli <root>"))?;
+        Err(anyhow!(
+            "Usage: netstorageserver-cli <root>\n       \
+             netstorageserver-cli bench <address> <public key> <path>"
+        ))?;
     }
     let root = Path::new(&args[1]).canonicalize()?;
 
@@ -110,7 +119,10 @@ async fn handle(
 
 struct Stream {
     stream: TcpStream,
-    message_id: u64,
+    // The client may send requests before it has read the previous responses, so each direction
+    // has its own counter.
+    read_message_id: u64,
+    write_message_id: u64,
     context: secretbox::Context,
     tx_key: secretbox::Key,
     rx_key: secretbox::Key,
@@ -118,6 +130,7 @@ struct Stream {
     root: PathBuf,
     files: [Option<File>; 32],
     dirs: [Option<Dir>; 32],
+    request_id: Option<u32>,
 }
 
 impl Stream {
@@ -140,7 +153,8 @@ impl Stream {
 
         Ok(Stream {
             stream,
-            message_id: 0,
+            read_message_id: 0,
+            write_message_id: 0,
             context: (*b"storage ").into(),
             rx_key,
             tx_key,
@@ -148,6 +162,7 @@ impl Stream {
             root,
             files: Default::default(),
             dirs: Default::default(),
+            request_id: None,
         })
     }
 
@@ -156,6 +171,8 @@ impl Stream {
 
         loop {
             let request: NetStorageRequest = self.read_message().await?;
+            // The client may pipeline requests, so tag every response with the request it answers.
+            self.request_id = request.id;
             let request = request.request.ok_or(anyhow!("Failed to get request type!"))?;
             match request {
                 FastOpen(fast_open) => match self.id_to_path(fast_open.id).await {
@@ -174,7 +191,10 @@ impl Stream {
                     None => self.error().await?,
                 },
                 Close(close) => self.close_file(close.handle).await?,
-                Read(read) => self.read_file(read.handle, read.size, read.offset).await?,
+                Read(read) => {
+                    let chunk_size = read.chunk_size.unwrap_or(0x1000);
+                    self.read_file(read.handle, read.size, read.offset, chunk_size).await?
+                }
                 Write(write) => self.write_file(write.handle, write.size, write.offset).await?,
                 FastOpenDir(fast_open_dir) => match self.id_to_path(fast_open_dir.id).await {
                     Some(path) => self.open_dir(path).await?,
@@ -193,11 +213,17 @@ impl Stream {
                 },
                 CloseDir(close_dir) => self.close_dir(close_dir.handle).await?,
                 ReadDir(read_dir) => self.read_dir(read_dir.handle).await?,
+                ReadDirBatch(read_dir_batch) => {
+                    self.read_dir_batch(read_dir_batch.handle, read_dir_batch.count).await?
+                }
                 Stat(stat) => match self.convert_path(&stat.path) {
                     Some(path) => self.stat(path).await?,
                     None => self.error().await?,
                 },
                 StartBenchmark(_) => self.start_benchmark().await?,
+                ReadRanges(read_ranges) => {
+                    self.read_file_ranges(read_ranges.handle, &read_ranges.ranges).await?
+                }
             }
         }
     }
@@ -228,6 +254,7 @@ impl Stream {
         });
         let handle = handle as u32;
         let response = NetStorageResponse {
+            id: self.request_id,
             response: Some(Response::Open(net_storage_response::Open {
                 handle,
                 size,
@@ -252,6 +279,7 @@ impl Stream {
         handle: u32,
         size: u32,
         offset: u64,
+        chunk_size: u32,
     ) -> Result<(), Box<dyn std::error::Error>> {
         let file = match self.file_mut(handle) {
             Some(file) => file,
@@ -265,12 +293,43 @@ impl Stream {
             Ok(_) => self.ok().await?,
             Err(_) => return self.error().await,
         }
-        for chunk in data.chunks(0x1000) {
+        let chunk_size = chunk_size.clamp(1, MAX_CHUNK_SIZE) as usize;
+        for chunk in data.chunks(chunk_size) {
             self.write(chunk).await?;
         }
         Ok(())
     }
 
+    async fn read_file_ranges(
+        &mut self,
+        handle: u32,
+        ranges: &[net_storage_request::read_ranges::Range],
+    ) -> Result<(), Box<dyn std::error::Error>> {
+        let file = match self.file_mut(handle) {
+            Some(file) => file,
+            None => return self.error().await,
+        };
+        let mut datas = Vec::with_capacity(ranges.len());
+        for range in ranges {
+            if file.file.seek(SeekFrom::Start(range.offset)).await.is_err() {
+                return self.error().await;
+            }
+            let mut data = vec![0u8; range.size as usize];
+            if file.file.read_exact(&mut data).await.is_err() {
+                return self.error().await;
+            }
+            datas.push(data);
+        }
+        self.ok().await?;
+        // Each range is chunked on its own, so that the client can read them straight into place.
+        for data in &datas {
+            for chunk in data.chunks(0x1000) {
+                self.write(chunk).await?;
+            }
+        }
+        Ok(())
+    }
+
     async fn write_file(
         &mut self,
         handle: u32,
@@ -313,6 +372,7 @@ impl Stream {
         });
         let handle = handle as u32;
         let response = NetStorageResponse {
+            id: self.request_id,
             response: Some(Response::OpenDir(net_storage_response::OpenDir {
                 handle,
             })),
@@ -340,30 +400,65 @@ impl Stream {
             Ok(Some(entry)) => entry,
             _ => return self.error().await,
         };
-        let id = self.path_to_id(entry.path()).await;
-        let metadata = entry.metadata().await;
-        let name = entry.file_name().into_string();
-        let (id, metadata, name) = match (id, metadata, name) {
-            (Some(id), Ok(metadata), Ok(name)) => (id, metadata, name),
-            _ => return self.error().await,
+        let node_info = match self.dir_entry_node_info(&entry).await {
+            Some(node_info) => node_info,
+            None => return self.error().await,
         };
+        let response = NetStorageResponse {
+            id: self.request_id,
+            response: Some(Response::NodeInfo(node_info)),
+        };
+        self.write_message(response).await
+    }
+
+    async fn read_dir_batch(
+        &mut self,
+        handle: u32,
+        count: u32,
+    ) -> Result<(), Box<dyn std::error::Error>> {
+        for _ in 0..count {
+            let dir = match self.dir_mut(handle) {
+                Some(dir) => dir,
+                None => break,
+            };
+            let entry = match dir.dir.next_entry().await {
+                Ok(Some(entry)) => entry,
+                _ => break,
+            };
+            let node_info = match self.dir_entry_node_info(&entry).await {
+                Some(node_info) => node_info,
+                None => break,
+            };
+            let response = NetStorageResponse {
+                id: self.request_id,
+                response: Some(Response::NodeInfo(node_info)),
+            };
+            self.write_message(response).await?;
+        }
+        self.ok().await
+    }
+
+    async fn dir_entry_node_info(
+        &self,
+        entry: &tokio::fs::DirEntry,
+    ) -> Option<net_storage_response::NodeInfo> {
+        let id = self.path_to_id(entry.path()).await?;
+        let metadata = entry.metadata().await.ok()?;
+        let name = entry.file_name().into_string().ok()?;
         let r#type = if metadata.file_type().is_file() {
             net_storage_response::node_info::Type::File
         } else if metadata.file_type().is_dir() {
             net_storage_response::node_info::Type::Dir
         } else {
-            return self.error().await;
+            return None;
         } as i32;
-        let node_info = net_storage_response::NodeInfo {
+        Some(net_storage_response::NodeInfo {
             id,
             r#type,
             size: metadata.len(),
             name: name,
-        };
-        let response = NetStorageResponse {
-            response: Some(Response::NodeInfo(node_info)),
-        };
-        self.write_message(response).await
+            modified_time: modified_time(&metadata),
+        })
     }
 
     async fn stat(&mut self, path: PathBuf) -> Result<(), Box<dyn std::error::Error>> {
@@ -387,8 +482,10 @@ impl Stream {
             r#type,
             size: metadata.len(),
             name: name,
+            modified_time: modified_time(&metadata),
         };
         let response = NetStorageResponse {
+            id: self.request_id,
             response: Some(Response::NodeInfo(node_info)),
         };
         self.write_message(response).await
@@ -414,6 +511,7 @@ impl Stream {
         });
         let handle = handle as u32;
         let response = NetStorageResponse {
+            id: self.request_id,
             response: Some(Response::Open(net_storage_response::Open {
                 handle,
                 size,
@@ -424,6 +522,7 @@ impl Stream {
 
     async fn ok(&mut self) -> Result<(), Box<dyn std::error::Error>> {
         let response = NetStorageResponse {
+            id: self.request_id,
             response: Some(Response::Ok(net_storage_response::Ok {})),
         };
         self.write_message(response).await
@@ -431,6 +530,7 @@ impl Stream {
 
     async fn error(&mut self) -> Result<(), Box<dyn std::error::Error>> {
         let response = NetStorageResponse {
+            id: self.request_id,
             response: Some(Response::Error(net_storage_response::Error {})),
         };
         self.write_message(response).await
@@ -442,8 +542,8 @@ impl Stream {
         let size = u16::from_be_bytes(size);
         let mut tmp = vec![0; size as usize];
         self.stream.read_exact(&mut tmp).await?;
-        let tmp = secretbox::decrypt(&tmp, self.message_id, &self.context, &self.rx_key)?;
-        self.message_id += 1;
+        let tmp = secretbox::decrypt(&tmp, self.read_message_id, &self.context, &self.rx_key)?;
+        self.read_message_id += 1;
         Ok(tmp)
     }
 
@@ -455,8 +555,8 @@ impl Stream {
     }
 
     async fn write(&mut self, tmp: &[u8]) -> Result<(), Box<dyn std::error::Error>> {
-        let tmp = secretbox::encrypt(&tmp, self.message_id, &self.context, &self.tx_key);
-        self.message_id += 1;
+        let tmp = secretbox::encrypt(&tmp, self.write_message_id, &self.context, &self.tx_key);
+        self.write_message_id += 1;
         let size = tmp.len();
         assert!(size <= u16::MAX as usize);
         let size = (size as u16).to_be_bytes();
@@ -534,6 +634,9 @@ impl Stream {
     }
 }
 
+// Keeps each encrypted message well below the 64 KiB frame limit.
+const MAX_CHUNK_SIZE: u32 = 0x8000;
+
 enum ConversionRequest {
     PathToId {
         path: PathBuf,
@@ -545,6 +648,12 @@ enum ConversionRequest {
     },
 }
 
+fn modified_time(metadata: &std::fs::Metadata) -> Option<u64> {
+    let modified = metadata.modified().ok()?;
+    let duration = modified.duration_since(std::time::UNIX_EPOCH).ok()?;
+    Some(duration.as_secs())
+}
+
 struct File {
     file: tokio::fs::File,
     path: Option<PathBuf>,
@@ -554,3 +663,199 @@ struct Dir {
     dir: tokio::fs::ReadDir,
     path: PathBuf,
 }
+
+// The read patterns of the payload: 4 KiB synchronous reads as before the read-ahead, and 32 KiB
+// chunks with as many requests in flight as NetStorage keeps.
+const SYNC_READ_SIZE: u32 = 0x1000;
+const READ_AHEAD_DEPTH: usize = 4;
+
+async fn bench(
+    address: &str,
+    public_key: &str,
+    path: &str,
+) -> Result<(), Box<dyn std::error::Error>> {
+    // Accepts the key as printed by the server.
+    let public_key: String = public_key.chars().filter(|c| c.is_ascii_hexdigit()).collect();
+    let mut server_pk = [0u8; 32];
+    if public_key.len() != 2 * server_pk.len() {
+        Err(anyhow!("The public key must be 32 bytes long!"))?;
+    }
+    for (i, byte) in server_pk.iter_mut().enumerate() {
+        *byte = u8::from_str_radix(&public_key[2 * i..2 * i + 2], 16)?;
+    }
+
+    let mut client = Client::connect(address, server_pk).await?;
+    let (handle, size) = client.open(&format!("ro:/{}", path)).await?;
+
+    let start = Instant::now();
+    for offset in (0..size).step_by(SYNC_READ_SIZE as usize) {
+        let read_size = (size - offset).min(SYNC_READ_SIZE as u64) as u32;
+        let id = client.write_read(handle, read_size, offset, None).await?;
+        client.read_data(id, read_size).await?;
+    }
+    print_throughput("4 KiB synchronous reads", size, start.elapsed());
+
+    let start = Instant::now();
+    let mut read_aheads = VecDeque::new();
+    let mut offset = 0;
+    while offset < size || !read_aheads.is_empty() {
+        while offset < size && read_aheads.len() < READ_AHEAD_DEPTH {
+            let read_size = (size - offset).min(MAX_CHUNK_SIZE as u64) as u32;
+            let id = client.write_read(handle, read_size, offset, Some(MAX_CHUNK_SIZE)).await?;
+            read_aheads.push_back((id, read_size));
+            offset += read_size as u64;
+        }
+        if let Some((id, read_size)) = read_aheads.pop_front() {
+            client.read_data(id, read_size).await?;
+        }
+    }
+    print_throughput("32 KiB reads with read-ahead", size, start.elapsed());
+
+    client.close(handle).await
+}
+
+fn print_throughput(name: &str, size: u64, duration: Duration) {
+    let throughput = size as f64 / 1024.0 / 1024.0 / duration.as_secs_f64();
+    println!("{}: {} bytes in {:?} ({:.2} MiB/s)", name, size, duration, throughput);
+}
+
+// The client side of the protocol, as NetStorage speaks it.
+struct Client {
+    stream: TcpStream,
+    read_message_id: u64,
+    write_message_id: u64,
+    context: secretbox::Context,
+    tx_key: secretbox::Key,
+    rx_key: secretbox::Key,
+    request_id: u32,
+}
+
+impl Client {
+    async fn connect(
+        address: &str,
+        server_pk: [u8; 32],
+    ) -> Result<Client, Box<dyn std::error::Error>> {
+        let mut stream = TcpStream::connect(address).await?;
+        stream.set_nodelay(true)?;
+
+        let mut n1 = kx::NPacket1::new();
+        let keypair = kx::n_1(&mut n1, None, &server_pk.into())?;
+        stream.write_all(n1.as_ref()).await?;
+        let rx_key: Zeroizing<[u8; 32]> = Zeroizing::new(keypair.rx.clone().into());
+        let rx_key = (*rx_key).into();
+        let tx_key: Zeroizing<[u8; 32]> = Zeroizing::new(keypair.tx.clone().into());
+        let tx_key = (*tx_key).into();
+
+        Ok(Client {
+            stream,
+            read_message_id: 0,
+            write_message_id: 0,
+            context: (*b"storage ").into(),
+            rx_key,
+            tx_key,
+            request_id: 0,
+        })
+    }
+
+    async fn open(&mut self, path: &str) -> Result<(u32, u64), Box<dyn std::error::Error>> {
+        let open = net_storage_request::Open {
+            path: path.to_owned(),
+            mode: "r".to_owned(),
+        };
+        let id = self.write_request(net_storage_request::Request::Open(open)).await?;
+        match self.read_response(id).await? {
+            Response::Open(open) => Ok((open.handle, open.size)),
+            _ => Err(anyhow!("Failed to open {}!", path))?,
+        }
+    }
+
+    async fn close(&mut self, handle: u32) -> Result<(), Box<dyn std::error::Error>> {
+        let close = net_storage_request::Close {
+            handle,
+        };
+        let id = self.write_request(net_storage_request::Request::Close(close)).await?;
+        self.read_ok(id).await
+    }
+
+    async fn write_read(
+        &mut self,
+        handle: u32,
+        size: u32,
+        offset: u64,
+        chunk_size: Option<u32>,
+    ) -> Result<u32, Box<dyn std::error::Error>> {
+        let read = net_storage_request::Read {
+            handle,
+            size,
+            offset,
+            chunk_size,
+        };
+        self.write_request(net_storage_request::Request::Read(read)).await
+    }
+
+    async fn read_data(
+        &mut self,
+        id: u32,
+        mut size: u32,
+    ) -> Result<(), Box<dyn std::error::Error>> {
+        self.read_ok(id).await?;
+        while size > 0 {
+            let chunk = self.read().await?;
+            if chunk.is_empty() || chunk.len() > size as usize {
+                Err(anyhow!("Wrong chunk size!"))?;
+            }
+            size -= chunk.len() as u32;
+        }
+        Ok(())
+    }
+
+    async fn read_ok(&mut self, id: u32) -> Result<(), Box<dyn std::error::Error>> {
+        match self.read_response(id).await? {
+            Response::Ok(_) => Ok(()),
+            _ => Err(anyhow!("Got an error response!"))?,
+        }
+    }
+
+    async fn write_request(
+        &mut self,
+        request: net_storage_request::Request,
+    ) -> Result<u32, Box<dyn std::error::Error>> {
+        self.request_id += 1;
+        let request = NetStorageRequest {
+            request: Some(request),
+            id: Some(self.request_id),
+        };
+        self.write(&request.encode_to_vec()).await?;
+        Ok(self.request_id)
+    }
+
+    async fn read_response(&mut self, id: u32) -> Result<Response, Box<dyn std::error::Error>> {
+        let response = NetStorageResponse::decode(&*self.read().await?)?;
+        if response.id != Some(id) {
+            Err(anyhow!("Got a response to another request!"))?;
+        }
+        Ok(response.response.ok_or(anyhow!("Failed to get response type!"))?)
+    }
+
+    async fn read(&mut self) -> Result<Vec<u8>, Box<dyn std::error::Error>> {
+        let mut size = [0u8; 2];
+        self.stream.read_exact(&mut size).await?;
+        let size = u16::from_be_bytes(size);
+        let mut tmp = vec![0; size as usize];
+        self.stream.read_exact(&mut tmp).await?;
+        let tmp = secretbox::decrypt(&tmp, self.read_message_id, &self.context, &self.rx_key)?;
+        self.read_message_id += 1;
+        Ok(tmp)
+    }
+
+    async fn write(&mut self, tmp: &[u8]) -> Result<(), Box<dyn std::error::Error>> {
+        let tmp = secretbox::encrypt(&tmp, self.write_message_id, &self.context, &self.tx_key);
+        self.write_message_id += 1;
+        let size = tmp.len();
+        assert!(size <= u16::MAX as usize);
+        let size = (size as u16).to_be_bytes();
+        self.stream.write_all(&size).await?;
+        self.stream.write_all(&tmp).await?;
+        Ok(())
+    }
+}